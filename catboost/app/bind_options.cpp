@@ -185,6 +185,13 @@ inline static void BindPoolLoadParams(NLastGetopt::TOpts* parser, NCatboostOptio
             .RequiredArgument("PATH")
             .StoreResult(&loadParamsPtr->BordersFile);
 
+    parser->AddLongOption("quantize-while-loading", "calculate borders on learn sample and quantize float features"
+        " while reading datasets to reduce memory usage (dsv datasets without categorical and text features only)")
+        .NoArgument()
+        .Handler0([loadParamsPtr]() {
+            loadParamsPtr->QuantizeWhileLoading = true;
+        });
+
     parser->AddLongOption("feature-names-path", "path to feature names data")
         .RequiredArgument("[SCHEME://]PATH")
         .Handler1T<TStringBuf>([loadParamsPtr](const TStringBuf& str) {
@@ -314,6 +321,12 @@ static void BindOutputParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("trace-file", "file to write trace of training threads in Chrome trace format (chrome://tracing). CPU only")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["trace_file"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -1161,6 +1174,13 @@ static void BindSystemParams(NLastGetopt::TOpts* parserPtr, NJson::TJsonValue* p
                 (*plainJsonPtr)["used_ram_limit"] = param;
             });
 
+    parser.AddLongOption("async-metrics-calc", "Calculate metrics of an iteration in background while the next tree is being built. CPU only.\n"
+                         "Overfitting detector and training callbacks see metric values one iteration late, extra tree is rolled back on stop")
+            .NoArgument()
+            .Handler0([plainJsonPtr]() {
+                (*plainJsonPtr)["async_metrics_calc"] = true;
+            });
+
     parser
             .AddLongOption("gpu-ram-part")
             .RequiredArgument("double")
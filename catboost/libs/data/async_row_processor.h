@@ -5,6 +5,7 @@
 #include <library/threading/future/future.h>
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 #include <util/system/types.h>
 
@@ -93,20 +94,36 @@ namespace NCB {
         // processFunc should accept 2 agrs: TData& and lineIdx
         template <class TProcessDataFunc>
         void ProcessBlock(TProcessDataFunc processFunc) {
+            ProcessBlockByRanges([processFunc = std::move(processFunc)](TArrayRef<TData> lines, int firstLineIdx) {
+                for (int i = 0; i < (int)lines.size(); ++i) {
+                    processFunc(lines[i], firstLineIdx + i);
+                }
+            });
+        }
+
+        /*
+         * processRangeFunc should accept 2 args: TArrayRef<TData> with consecutive lines and index of the first of them,
+         *  it is called once per thread, so buffers local to processRangeFunc are reused for all lines in range
+         */
+        template <class TProcessRangeFunc>
+        void ProcessBlockByRanges(TProcessRangeFunc processRangeFunc) {
             const int threadCount = LocalExecutor->GetThreadCount() + 1;
 
             NPar::TLocalExecutor::TExecRangeParams blockParams(0, ParseBuffer.ysize());
             blockParams.SetBlockCount(threadCount);
-            LocalExecutor->ExecRangeWithThrow([this, blockParams, processFunc = std::move(processFunc)](int blockIdx) {
+            LocalExecutor->ExecRangeWithThrow([this, blockParams, processRangeFunc = std::move(processRangeFunc)](int blockIdx) {
                 const int blockOffset = blockIdx * blockParams.GetBlockSize();
-                for (int i = blockOffset; i < Min(blockOffset + blockParams.GetBlockSize(), ParseBuffer.ysize()); ++i) {
-                    processFunc(ParseBuffer[i], i);
+                const int blockEnd = Min(blockOffset + blockParams.GetBlockSize(), ParseBuffer.ysize());
+                if (blockOffset < blockEnd) {
+                    processRangeFunc(
+                        TArrayRef<TData>(ParseBuffer.data() + blockOffset, blockEnd - blockOffset),
+                        blockOffset
+                    );
                 }
             }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
             LinesProcessed += ParseBuffer.ysize();
         }
 
-
         size_t GetParseBufferSize() const {
             return ParseBuffer.size();
         }
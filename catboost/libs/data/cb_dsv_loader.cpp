@@ -130,13 +130,11 @@ namespace NCB {
 
         auto& columnsDescription = DataMetaInfo.ColumnsInfo->Columns;
 
-        auto parseBlock = [&](TString& line, int lineIdx) {
+        auto parseBlock = [&](TArrayRef<TString> lines, int firstLineIdx) {
             const auto& featuresLayout = *DataMetaInfo.FeaturesLayout;
 
-            ui32 featureId = 0;
-            ui32 targetId = 0;
-            ui32 baselineIdx = 0;
-
+            // feature buffers are allocated once per range and shared by all its lines,
+            // lines themselves are still read into separate TStrings by the line reader
             TVector<float> floatFeatures;
             floatFeatures.yresize(featuresLayout.GetFloatFeatureCount());
 
@@ -146,125 +144,135 @@ namespace NCB {
             TVector<TString> textFeatures;
             textFeatures.yresize(featuresLayout.GetTextFeatureCount());
 
-            size_t tokenIdx = 0;
-            try {
-                const bool floatFeaturesOnly = catFeatures.empty() && textFeatures.empty();
-                auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, floatFeaturesOnly ? '\0' : CsvSplitterQuote);
-                do {
-                    TStringBuf token = splitter.Consume();
-                    CB_ENSURE(
-                        tokenIdx < columnsDescription.size(),
-                        "wrong column count: found more than " << columnsDescription.ysize() << " values"
-                    );
-                    try {
-                        switch (columnsDescription[tokenIdx].Type) {
-                            case EColumn::Categ: {
-                                if (!FeatureIgnored[featureId]) {
-                                    const ui32 catFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    catFeatures[catFeatureIdx] = visitor->GetCatFeatureValue(featureId, token);
+            const bool floatFeaturesOnly = catFeatures.empty() && textFeatures.empty();
+
+            for (int i = 0; i < (int)lines.size(); ++i) {
+                TString& line = lines[i];
+                const int lineIdx = firstLineIdx + i;
+
+                ui32 featureId = 0;
+                ui32 targetId = 0;
+                ui32 baselineIdx = 0;
+
+                size_t tokenIdx = 0;
+                try {
+                    auto splitter = NCsvFormat::CsvSplitter(line, FieldDelimiter, floatFeaturesOnly ? '\0' : CsvSplitterQuote);
+                    do {
+                        TStringBuf token = splitter.Consume();
+                        CB_ENSURE(
+                            tokenIdx < columnsDescription.size(),
+                            "wrong column count: found more than " << columnsDescription.ysize() << " values"
+                        );
+                        try {
+                            switch (columnsDescription[tokenIdx].Type) {
+                                case EColumn::Categ: {
+                                    if (!FeatureIgnored[featureId]) {
+                                        const ui32 catFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
+                                        catFeatures[catFeatureIdx] = visitor->GetCatFeatureValue(featureId, token);
+                                    }
+                                    ++featureId;
+                                    break;
                                 }
-                                ++featureId;
-                                break;
-                            }
-                            case EColumn::Num: {
-                                if (!FeatureIgnored[featureId]) {
-                                    if (!TryParseFloatFeatureValue(
-                                            token,
-                                            &floatFeatures[featuresLayout.GetInternalFeatureIdx(featureId)]
-                                         ))
-                                    {
-                                        CB_ENSURE(
-                                            false,
-                                            "Factor " << featureId << " cannot be parsed as float."
-                                            " Try correcting column description file."
-                                        );
+                                case EColumn::Num: {
+                                    if (!FeatureIgnored[featureId]) {
+                                        if (!TryParseFloatFeatureValue(
+                                                token,
+                                                &floatFeatures[featuresLayout.GetInternalFeatureIdx(featureId)]
+                                             ))
+                                        {
+                                            CB_ENSURE(
+                                                false,
+                                                "Factor " << featureId << " cannot be parsed as float."
+                                                " Try correcting column description file."
+                                            );
+                                        }
                                     }
+                                    ++featureId;
+                                    break;
                                 }
-                                ++featureId;
-                                break;
-                            }
-                            case EColumn::Text: {
-                                if (!FeatureIgnored[featureId]) {
-                                    const ui32 textFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
-                                    textFeatures[textFeatureIdx] = TString(token);
+                                case EColumn::Text: {
+                                    if (!FeatureIgnored[featureId]) {
+                                        const ui32 textFeatureIdx = featuresLayout.GetInternalFeatureIdx(featureId);
+                                        textFeatures[textFeatureIdx] = TString(token);
+                                    }
+                                    ++featureId;
+                                    break;
                                 }
-                                ++featureId;
-                                break;
-                            }
-                            case EColumn::Label: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Label");
-                                visitor->AddTarget(targetId, lineIdx, TString(token));
-                                ++targetId;
-                            break;
-                            }
-                            case EColumn::Weight: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for weight");
-                                visitor->AddWeight(lineIdx, FromString<float>(token));
-                                break;
-                            }
-                            case EColumn::Auxiliary: {
-                                break;
-                            }
-                            case EColumn::GroupId: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for GroupId");
-                                visitor->AddGroupId(lineIdx, CalcGroupIdFor(token));
-                                break;
-                            }
-                            case EColumn::GroupWeight: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for GroupWeight");
-                                visitor->AddGroupWeight(lineIdx, FromString<float>(token));
-                                break;
-                            }
-                            case EColumn::SubgroupId: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for SubgroupId");
-                                visitor->AddSubgroupId(lineIdx, CalcSubgroupIdFor(token));
-                                break;
-                            }
-                            case EColumn::Baseline: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Baseline");
-                                visitor->AddBaseline(lineIdx, baselineIdx, FromString<float>(token));
-                                ++baselineIdx;
+                                case EColumn::Label: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for Label");
+                                    visitor->AddTarget(targetId, lineIdx, TString(token));
+                                    ++targetId;
                                 break;
+                                }
+                                case EColumn::Weight: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for weight");
+                                    visitor->AddWeight(lineIdx, FromString<float>(token));
+                                    break;
+                                }
+                                case EColumn::Auxiliary: {
+                                    break;
+                                }
+                                case EColumn::GroupId: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for GroupId");
+                                    visitor->AddGroupId(lineIdx, CalcGroupIdFor(token));
+                                    break;
+                                }
+                                case EColumn::GroupWeight: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for GroupWeight");
+                                    visitor->AddGroupWeight(lineIdx, FromString<float>(token));
+                                    break;
+                                }
+                                case EColumn::SubgroupId: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for SubgroupId");
+                                    visitor->AddSubgroupId(lineIdx, CalcSubgroupIdFor(token));
+                                    break;
+                                }
+                                case EColumn::Baseline: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for Baseline");
+                                    visitor->AddBaseline(lineIdx, baselineIdx, FromString<float>(token));
+                                    ++baselineIdx;
+                                    break;
+                                }
+                                case EColumn::SampleId: {
+                                    break;
+                                }
+                                case EColumn::Timestamp: {
+                                    CB_ENSURE(token.length() != 0, "empty values not supported for Timestamp");
+                                    visitor->AddTimestamp(lineIdx, FromString<ui64>(token));
+                                    break;
+                                }
+                                default: {
+                                    CB_ENSURE(false, "wrong column type");
+                                }
                             }
-                            case EColumn::SampleId: {
-                                break;
-                            }
-                            case EColumn::Timestamp: {
-                                CB_ENSURE(token.length() != 0, "empty values not supported for Timestamp");
-                                visitor->AddTimestamp(lineIdx, FromString<ui64>(token));
-                                break;
-                            }
-                            default: {
-                                CB_ENSURE(false, "wrong column type");
-                            }
+                        } catch (yexception& e) {
+                            throw TCatBoostException() << "Column " << tokenIdx << " (type "
+                                << columnsDescription[tokenIdx].Type << ", value = \"" << token
+                                << "\"): " << e.what();
                         }
-                    } catch (yexception& e) {
-                        throw TCatBoostException() << "Column " << tokenIdx << " (type "
-                            << columnsDescription[tokenIdx].Type << ", value = \"" << token
-                            << "\"): " << e.what();
+                        ++tokenIdx;
+                    } while (splitter.Step());
+                    CB_ENSURE(
+                        tokenIdx == columnsDescription.size(),
+                        "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenIdx
+                    );
+                    if (!floatFeatures.empty()) {
+                        visitor->AddAllFloatFeatures(lineIdx, floatFeatures);
                     }
-                    ++tokenIdx;
-                } while (splitter.Step());
-                CB_ENSURE(
-                    tokenIdx == columnsDescription.size(),
-                    "wrong column count: expected " << columnsDescription.ysize() << ", found " << tokenIdx
-                );
-                if (!floatFeatures.empty()) {
-                    visitor->AddAllFloatFeatures(lineIdx, floatFeatures);
-                }
-                if (!catFeatures.empty()) {
-                    visitor->AddAllCatFeatures(lineIdx, catFeatures);
-                }
-                if (!textFeatures.empty()) {
-                    visitor->AddAllTextFeatures(lineIdx, textFeatures);
+                    if (!catFeatures.empty()) {
+                        visitor->AddAllCatFeatures(lineIdx, catFeatures);
+                    }
+                    if (!textFeatures.empty()) {
+                        visitor->AddAllTextFeatures(lineIdx, textFeatures);
+                    }
+                } catch (yexception& e) {
+                    throw TCatBoostException() << "Error in dsv data. Line " <<
+                        AsyncRowProcessor.GetLinesProcessed() + lineIdx + 1 << ": " << e.what();
                 }
-            } catch (yexception& e) {
-                throw TCatBoostException() << "Error in dsv data. Line " <<
-                    AsyncRowProcessor.GetLinesProcessed() + lineIdx + 1 << ": " << e.what();
             }
         };
 
-        AsyncRowProcessor.ProcessBlock(parseBlock);
+        AsyncRowProcessor.ProcessBlockByRanges(parseBlock);
 
         if (BaselineReader.Inited()) {
             auto parseBaselineBlock = [&](TString &line, int inBlockIdx) {
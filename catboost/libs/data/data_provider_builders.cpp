@@ -1275,17 +1275,16 @@ namespace NCB {
             TConstArrayRef<NJson::TJsonValue> schemaClassLabels = poolQuantizationSchema.ClassLabels;
 
             if (metaInfo.TargetType == ERawTargetType::String) {
-                CB_ENSURE(
-                    !schemaClassLabels.empty(),
-                    "poolQuantizationSchema must have class labels when target data type is String"
-                );
-                CB_ENSURE(
-                    schemaClassLabels[0].GetType() == NJson::JSON_STRING,
-                    "poolQuantizationSchema must have string class labels when target data type is String"
-                );
-                StringClassLabels.reserve(schemaClassLabels.size());
-                for (const NJson::TJsonValue& classLabel : schemaClassLabels) {
-                    StringClassLabels.push_back(classLabel.GetString());
+                // without class labels String target can be added only as strings, not as class indices
+                if (!schemaClassLabels.empty()) {
+                    CB_ENSURE(
+                        schemaClassLabels[0].GetType() == NJson::JSON_STRING,
+                        "poolQuantizationSchema must have string class labels when target data type is String"
+                    );
+                    StringClassLabels.reserve(schemaClassLabels.size());
+                    for (const NJson::TJsonValue& classLabel : schemaClassLabels) {
+                        StringClassLabels.push_back(classLabel.GetString());
+                    }
                 }
             } else if ((metaInfo.TargetType != ERawTargetType::None) && !schemaClassLabels.empty()) {
                 FloatClassLabels.reserve(schemaClassLabels.size());
@@ -1480,6 +1479,32 @@ namespace NCB {
             );
         }
 
+        bool AddFloatFeatureView(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui8> featureData
+        ) override {
+            return FloatFeaturesStorage.SetView(
+                GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx),
+                ObjectCount,
+                bitsPerDocumentFeature,
+                std::move(featureData)
+            );
+        }
+
+        bool AddCatFeatureView(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui8> featureData
+        ) override {
+            return CategoricalFeaturesStorage.SetView(
+                GetInternalFeatureIdx<EFeatureType::Categorical>(flatFeatureIdx),
+                ObjectCount,
+                bitsPerDocumentFeature,
+                std::move(featureData)
+            );
+        }
+
         // TRawTargetData
 
         void AddTargetPart(ui32 objectOffset, TUnalignedArrayBuf<float> targetPart) override {
@@ -1509,6 +1534,10 @@ namespace NCB {
                     StringTarget[flatTargetIdx]
                 );
             } else {
+                CB_ENSURE(
+                    Data.MetaInfo.TargetType != ERawTargetType::String,
+                    "poolQuantizationSchema must have class labels when target data type is String"
+                );
                 Y_ASSERT(
                     (Data.MetaInfo.TargetType == ERawTargetType::Integer) ||
                     (Data.MetaInfo.TargetType == ERawTargetType::Float)
@@ -1804,6 +1833,9 @@ namespace NCB {
              */
             TVector<TIntrusivePtr<TVectorHolder<ui64>>> DenseDataStorage; // [perTypeFeatureIdx]
 
+            // owners of external data used instead of DenseDataStorage (see SetView)
+            TVector<TIntrusivePtr<IResourceHolder>> ExternalDataOwners; // [perTypeFeatureIdx]
+
             // view into storage for faster access
             TVector<TArrayRef<ui64>> DenseDstView; // [perTypeFeatureIdx]
 
@@ -1834,6 +1866,7 @@ namespace NCB {
             ) {
                 const size_t perTypeFeatureCount = (size_t)featuresLayout.GetFeatureCount(FeatureType);
                 DenseDataStorage.resize(perTypeFeatureCount);
+                ExternalDataOwners.assign(perTypeFeatureCount, nullptr);
                 DenseDstView.resize(perTypeFeatureCount);
                 IsAvailable.resize(perTypeFeatureCount, false); // filled from quantization Schema, then checked
                 IndexHelpers.resize(perTypeFeatureCount, TIndexHelper<ui64>(8));
@@ -1954,12 +1987,43 @@ namespace NCB {
 
 
                     memcpy(
-                        ((ui8*)DenseDstView[*perTypeFeatureIdx].data()) + objectOffset,
+                        ((ui8*)DenseDstView[*perTypeFeatureIdx].data()) + objectOffsetInBytes,
                         featuresPart.data(),
                         featuresPart.size());
                 }
             }
 
+            /* returns false if featureData can't be used as feature storage, then Set has to be used
+             * (featureData is not referenced for unavailable features too, Set just skips them)
+             */
+            bool SetView(
+                TFeatureIdx<FeatureType> perTypeFeatureIdx,
+                ui32 objectCount,
+                ui8 bitsPerDocumentFeature,
+                TMaybeOwningConstArrayHolder<ui8> featureData
+            ) {
+                if (!IsAvailable[*perTypeFeatureIdx] || FeatureIdxToPackedBinaryIndex[*perTypeFeatureIdx]) {
+                    return false;
+                }
+
+                const auto& indexHelper = IndexHelpers[*perTypeFeatureIdx];
+                if ((indexHelper.GetBitsPerKey() != bitsPerDocumentFeature) ||
+                    (featureData.GetSize() != (size_t)objectCount * (bitsPerDocumentFeature / CHAR_BIT)) ||
+                    (reinterpret_cast<uintptr_t>(featureData.data()) % alignof(ui64) != 0))
+                {
+                    return false;
+                }
+
+                // compressed arrays of 8, 16 and 32 bits per key have the same layout as plain arrays
+                DenseDataStorage[*perTypeFeatureIdx] = nullptr;
+                ExternalDataOwners[*perTypeFeatureIdx] = featureData.GetResourceHolder();
+                DenseDstView[*perTypeFeatureIdx] = TArrayRef<ui64>(
+                    const_cast<ui64*>(reinterpret_cast<const ui64*>(featureData.data())),
+                    indexHelper.CompressedSize(objectCount)
+                );
+                return true;
+            }
+
             template <class T, EFeatureValuesType FeatureValuesType>
             void GetResult(
                 ui32 objectCount,
@@ -2006,6 +2070,8 @@ namespace NCB {
                                         TMaybeOwningArrayHolder<ui64>::CreateOwning(
                                             DenseDstView[perTypeFeatureIdx],
                                             DenseDataStorage[perTypeFeatureIdx]
+                                                ? TIntrusivePtr<IResourceHolder>(DenseDataStorage[perTypeFeatureIdx])
+                                                : ExternalDataOwners[perTypeFeatureIdx]
                                         )
                                     ),
                                     subsetIndexing
@@ -2052,6 +2118,407 @@ namespace NCB {
     };
 
 
+    /*
+     * Accepts raw data in objects order and passes it to TQuantizedFeaturesDataProviderBuilder:
+     *  float features are quantized with borders and nan modes from QuantizedFeaturesInfo as soon as they are
+     *  added, so only the current block of quantized values is buffered instead of raw float feature columns,
+     *  other data is passed as single object parts.
+     */
+    class TQuantizingRawObjectsOrderDataProviderBuilder : public IDataProviderBuilder,
+                                                          public IRawObjectsOrderDataVisitor
+    {
+    public:
+        TQuantizingRawObjectsOrderDataProviderBuilder(
+            const TDataProviderBuilderOptions& options,
+            TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
+            bool isLearnData,
+            NPar::TLocalExecutor* localExecutor
+        )
+            : QuantizedFeaturesInfo(std::move(quantizedFeaturesInfo))
+            , IsLearnData(isLearnData)
+            , QuantizedDataBuilder(options, TDatasetSubset::MakeColumns(), localExecutor)
+            , BlockOffset(0)
+            , BlockSize(0)
+            , InProcess(false)
+        {}
+
+        void Start(
+            bool inBlock,
+            const TDataMetaInfo& metaInfo,
+            bool haveUnknownNumberOfSparseFeatures,
+            ui32 objectCount,
+            EObjectsOrder objectsOrder,
+
+            // keep necessary resources for data to be available (memory mapping for a file for example)
+            TVector<TIntrusivePtr<IResourceHolder>> resourceHolders
+        ) override {
+            CB_ENSURE(!InProcess, "Attempt to start new processing without finishing the last");
+            CB_ENSURE_INTERNAL(!inBlock, "Quantization while loading does not support processing in blocks");
+            CB_ENSURE_INTERNAL(
+                !haveUnknownNumberOfSparseFeatures,
+                "Quantization while loading does not support unknown number of sparse features"
+            );
+
+            // contains features ignored after borders calculation
+            const auto& featuresLayout = *QuantizedFeaturesInfo->GetFeaturesLayout();
+            CB_ENSURE(
+                metaInfo.FeaturesLayout->GetExternalFeatureCount() == featuresLayout.GetExternalFeatureCount(),
+                "Dataset features are inconsistent with quantized features info: "
+                << LabeledOutput(
+                    metaInfo.FeaturesLayout->GetExternalFeatureCount(),
+                    featuresLayout.GetExternalFeatureCount()
+                )
+            );
+            CB_ENSURE(
+                !featuresLayout.GetCatFeatureCount() && !featuresLayout.GetTextFeatureCount(),
+                "Quantization while loading is supported only for datasets with float features only"
+            );
+
+            TDataMetaInfo quantizedMetaInfo = metaInfo;
+            quantizedMetaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(featuresLayout);
+
+            NCB::TPoolQuantizationSchema poolQuantizationSchema;
+
+            FloatFeatures.clear();
+            FloatFeatures.resize(featuresLayout.GetFloatFeatureCount());
+            featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+                [&] (TFloatFeatureIdx floatFeatureIdx) {
+                    CB_ENSURE_INTERNAL(
+                        QuantizedFeaturesInfo->HasBorders(floatFeatureIdx)
+                            && QuantizedFeaturesInfo->HasNanMode(floatFeatureIdx),
+                        "Float feature #" << *floatFeatureIdx << " has no borders or nan mode"
+                    );
+
+                    auto& floatFeature = FloatFeatures[*floatFeatureIdx];
+                    floatFeature.IsAvailable = true;
+                    floatFeature.FlatFeatureIdx = SafeIntegerCast<ui32>(
+                        featuresLayout.GetExternalFeatureIdx(*floatFeatureIdx, EFeatureType::Float)
+                    );
+                    if (IsLearnData) {
+                        /* nan mode is calculated on the learn sample, so learn objects outside of it can
+                         * contain NaNs even if nan mode is Forbidden. Reserve a bin for them as nan_mode option
+                         * says, the same way as CalcQuantizationAndNanMode does for samples with NaNs
+                         */
+                        const ENanMode nanModeOption = QuantizedFeaturesInfo->GetFloatFeatureBinarization(
+                            floatFeature.FlatFeatureIdx
+                        ).NanMode;
+                        if ((nanModeOption != ENanMode::Forbidden)
+                            && (QuantizedFeaturesInfo->GetNanMode(floatFeatureIdx) == ENanMode::Forbidden))
+                        {
+                            NSplitSelection::TQuantization quantization
+                                = QuantizedFeaturesInfo->GetQuantization(floatFeatureIdx);
+                            if (nanModeOption == ENanMode::Min) {
+                                quantization.Borders.insert(
+                                    quantization.Borders.begin(),
+                                    std::numeric_limits<float>::lowest()
+                                );
+                                if (quantization.DefaultQuantizedBin) {
+                                    ++quantization.DefaultQuantizedBin->Idx;
+                                }
+                            } else {
+                                quantization.Borders.push_back(std::numeric_limits<float>::max());
+                            }
+                            QuantizedFeaturesInfo->SetQuantization(floatFeatureIdx, std::move(quantization));
+                            QuantizedFeaturesInfo->SetNanMode(floatFeatureIdx, nanModeOption);
+                        }
+                    }
+                    floatFeature.Borders = QuantizedFeaturesInfo->GetBorders(floatFeatureIdx);
+                    floatFeature.NanMode = QuantizedFeaturesInfo->GetNanMode(floatFeatureIdx);
+                    if (IsLearnData) {
+                        floatFeature.AllowNans = (floatFeature.NanMode != ENanMode::Forbidden);
+                    } else {
+                        floatFeature.AllowNans = (floatFeature.NanMode != ENanMode::Forbidden) ||
+                            QuantizedFeaturesInfo->GetFloatFeaturesAllowNansInTestOnly();
+                    }
+                    floatFeature.BitsPerObject = CalcHistogramWidthForBorders(floatFeature.Borders.size());
+
+                    poolQuantizationSchema.FeatureIndices.push_back(floatFeature.FlatFeatureIdx);
+                    poolQuantizationSchema.Borders.emplace_back(
+                        floatFeature.Borders.begin(),
+                        floatFeature.Borders.end()
+                    );
+                    poolQuantizationSchema.NanModes.push_back(floatFeature.NanMode);
+                }
+            );
+            CB_ENSURE(
+                !poolQuantizationSchema.FeatureIndices.empty(),
+                "All features are either constant or ignored."
+            );
+
+            QuantizedDataBuilder.Start(
+                quantizedMetaInfo,
+                objectCount,
+                objectsOrder,
+                std::move(resourceHolders),
+                poolQuantizationSchema
+            );
+
+            BlockOffset = 0;
+            BlockSize = 0;
+            InProcess = true;
+        }
+
+        void StartNextBlock(ui32 blockSize) override {
+            FlushFloatFeaturesBlock();
+
+            BlockOffset += BlockSize;
+            BlockSize = blockSize;
+            for (auto& floatFeature : FloatFeatures) {
+                if (floatFeature.IsAvailable) {
+                    floatFeature.BlockData.yresize(blockSize * (floatFeature.BitsPerObject / CHAR_BIT));
+                }
+            }
+        }
+
+        // TCommonObjectsData
+        void AddGroupId(ui32 localObjectIdx, TGroupId value) override {
+            QuantizedDataBuilder.AddGroupIdPart(BlockOffset + localObjectIdx, MakeSingleValueBuf(value));
+        }
+
+        void AddSubgroupId(ui32 localObjectIdx, TSubgroupId value) override {
+            QuantizedDataBuilder.AddSubgroupIdPart(BlockOffset + localObjectIdx, MakeSingleValueBuf(value));
+        }
+
+        void AddTimestamp(ui32 localObjectIdx, ui64 value) override {
+            QuantizedDataBuilder.AddTimestampPart(BlockOffset + localObjectIdx, MakeSingleValueBuf(value));
+        }
+
+        // TRawObjectsData
+        void AddFloatFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, float feature) override {
+            SetFloatFeature(
+                QuantizedFeaturesInfo->GetFeaturesLayout()->GetInternalFeatureIdx(flatFeatureIdx),
+                localObjectIdx,
+                feature
+            );
+        }
+
+        void AddAllFloatFeatures(ui32 localObjectIdx, TConstArrayRef<float> features) override {
+            for (auto perTypeFeatureIdx : xrange(features.size())) {
+                SetFloatFeature(perTypeFeatureIdx, localObjectIdx, features[perTypeFeatureIdx]);
+            }
+        }
+
+        void AddAllFloatFeatures(
+            ui32 localObjectIdx,
+            TConstPolymorphicValuesSparseArray<float, ui32> features
+        ) override {
+            // for sparse float features default value is always assumed to be 0.0f
+            for (auto perTypeFeatureIdx : xrange(FloatFeatures.size())) {
+                SetFloatFeature(perTypeFeatureIdx, localObjectIdx, 0.0f);
+            }
+            features.ForEachNonDefault(
+                [&] (ui32 perTypeFeatureIdx, float value) {
+                    SetFloatFeature(perTypeFeatureIdx, localObjectIdx, value);
+                }
+            );
+        }
+
+        ui32 GetCatFeatureValue(ui32 flatFeatureIdx, TStringBuf feature) override {
+            Y_UNUSED(feature);
+            throw TCatBoostException() << "Quantization while loading does not support categorical feature #"
+                << flatFeatureIdx;
+        }
+        void AddCatFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, TStringBuf feature) override {
+            GetCatFeatureValue(flatFeatureIdx, feature);
+            Y_UNUSED(localObjectIdx);
+        }
+        void AddAllCatFeatures(ui32 localObjectIdx, TConstArrayRef<ui32> features) override {
+            Y_UNUSED(localObjectIdx);
+            CB_ENSURE(features.empty(), "Quantization while loading does not support categorical features");
+        }
+        void AddAllCatFeatures(
+            ui32 localObjectIdx,
+            TConstPolymorphicValuesSparseArray<ui32, ui32> features
+        ) override {
+            Y_UNUSED(localObjectIdx, features);
+            CB_ENSURE(false, "Quantization while loading does not support categorical features");
+        }
+        void AddCatFeatureDefaultValue(ui32 flatFeatureIdx, TStringBuf feature) override {
+            GetCatFeatureValue(flatFeatureIdx, feature);
+        }
+
+        void AddTextFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, TStringBuf feature) override {
+            Y_UNUSED(localObjectIdx, feature);
+            CB_ENSURE(
+                false,
+                "Quantization while loading does not support text feature #" << flatFeatureIdx
+            );
+        }
+        void AddTextFeature(ui32 localObjectIdx, ui32 flatFeatureIdx, const TString& feature) override {
+            AddTextFeature(localObjectIdx, flatFeatureIdx, TStringBuf(feature));
+        }
+        void AddAllTextFeatures(ui32 localObjectIdx, TConstArrayRef<TString> features) override {
+            Y_UNUSED(localObjectIdx);
+            CB_ENSURE(features.empty(), "Quantization while loading does not support text features");
+        }
+        void AddAllTextFeatures(
+            ui32 localObjectIdx,
+            TConstPolymorphicValuesSparseArray<TString, ui32> features
+        ) override {
+            Y_UNUSED(localObjectIdx, features);
+            CB_ENSURE(false, "Quantization while loading does not support text features");
+        }
+
+        // TRawTargetData
+
+        void AddTarget(ui32 localObjectIdx, const TString& value) override {
+            AddTarget(0, localObjectIdx, value);
+        }
+        void AddTarget(ui32 localObjectIdx, float value) override {
+            AddTarget(0, localObjectIdx, value);
+        }
+        void AddTarget(ui32 flatTargetIdx, ui32 localObjectIdx, const TString& value) override {
+            QuantizedDataBuilder.AddTargetPart(
+                flatTargetIdx,
+                BlockOffset + localObjectIdx,
+                TMaybeOwningConstArrayHolder<TString>::CreateNonOwning(TConstArrayRef<TString>(&value, 1))
+            );
+        }
+        void AddTarget(ui32 flatTargetIdx, ui32 localObjectIdx, float value) override {
+            QuantizedDataBuilder.AddTargetPart(
+                flatTargetIdx,
+                BlockOffset + localObjectIdx,
+                MakeSingleValueBuf(value)
+            );
+        }
+        void AddBaseline(ui32 localObjectIdx, ui32 baselineIdx, float value) override {
+            QuantizedDataBuilder.AddBaselinePart(
+                BlockOffset + localObjectIdx,
+                baselineIdx,
+                MakeSingleValueBuf(value)
+            );
+        }
+        void AddWeight(ui32 localObjectIdx, float value) override {
+            QuantizedDataBuilder.AddWeightPart(BlockOffset + localObjectIdx, MakeSingleValueBuf(value));
+        }
+        void AddGroupWeight(ui32 localObjectIdx, float value) override {
+            QuantizedDataBuilder.AddGroupWeightPart(BlockOffset + localObjectIdx, MakeSingleValueBuf(value));
+        }
+
+        // separate method because they can be loaded from a separate data source
+        void SetGroupWeights(TVector<float>&& groupWeights) override {
+            QuantizedDataBuilder.SetGroupWeights(std::move(groupWeights));
+        }
+
+        // separate method because they can be loaded from a separate data source
+        void SetBaseline(TVector<TVector<float>>&& baseline) override {
+            QuantizedDataBuilder.SetBaseline(std::move(baseline));
+        }
+
+        void SetPairs(TVector<TPair>&& pairs) override {
+            QuantizedDataBuilder.SetPairs(std::move(pairs));
+        }
+
+        void SetTimestamps(TVector<ui64>&& timestamps) override {
+            QuantizedDataBuilder.SetTimestamps(std::move(timestamps));
+        }
+
+        // needed for checking groupWeights consistency while loading from separate file
+        TMaybeData<TConstArrayRef<TGroupId>> GetGroupIds() const override {
+            return QuantizedDataBuilder.GetGroupIds();
+        }
+
+        void Finish() override {
+            CB_ENSURE(InProcess, "Attempt to Finish without starting processing");
+
+            FlushFloatFeaturesBlock();
+            BlockOffset += BlockSize;
+            BlockSize = 0;
+
+            QuantizedDataBuilder.Finish();
+            InProcess = false;
+        }
+
+        TDataProviderPtr GetResult() override {
+            return QuantizedDataBuilder.GetResult();
+        }
+
+    private:
+        template <class T>
+        static TUnalignedArrayBuf<T> MakeSingleValueBuf(const T& value) {
+            return TUnalignedArrayBuf<T>(&value, sizeof(T));
+        }
+
+        void SetFloatFeature(ui32 perTypeFeatureIdx, ui32 localObjectIdx, float value) {
+            CB_ENSURE_INTERNAL(
+                perTypeFeatureIdx < FloatFeatures.size(),
+                "Unknown float feature #" << perTypeFeatureIdx
+            );
+            auto& floatFeature = FloatFeatures[perTypeFeatureIdx];
+            if (!floatFeature.IsAvailable) {
+                return;
+            }
+            CB_ENSURE(
+                !IsLearnData || floatFeature.AllowNans || !IsNan(value),
+                "Feature #" << floatFeature.FlatFeatureIdx << ": There are nan factors and nan values for "
+                " float features are not allowed. Set nan_mode != Forbidden."
+            );
+            if (floatFeature.BitsPerObject == 8) {
+                floatFeature.BlockData[localObjectIdx] = Quantize<ui8>(
+                    floatFeature.FlatFeatureIdx,
+                    floatFeature.AllowNans,
+                    floatFeature.NanMode,
+                    floatFeature.Borders,
+                    value
+                );
+            } else {
+                Y_ASSERT(floatFeature.BitsPerObject == 16);
+                reinterpret_cast<ui16*>(floatFeature.BlockData.data())[localObjectIdx] = Quantize<ui16>(
+                    floatFeature.FlatFeatureIdx,
+                    floatFeature.AllowNans,
+                    floatFeature.NanMode,
+                    floatFeature.Borders,
+                    value
+                );
+            }
+        }
+
+        void FlushFloatFeaturesBlock() {
+            if (!BlockSize) {
+                return;
+            }
+
+            // not in parallel because binary features share packs in destination
+            for (const auto& floatFeature : FloatFeatures) {
+                if (floatFeature.IsAvailable) {
+                    QuantizedDataBuilder.AddFloatFeaturePart(
+                        floatFeature.FlatFeatureIdx,
+                        BlockOffset,
+                        floatFeature.BitsPerObject,
+                        TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(floatFeature.BlockData)
+                    );
+                }
+            }
+        }
+
+    private:
+        struct TFloatFeatureQuantization {
+            bool IsAvailable = false;
+            ui32 FlatFeatureIdx = 0;
+            TConstArrayRef<float> Borders; // points to data in QuantizedFeaturesInfo
+            ENanMode NanMode = ENanMode::Forbidden;
+            bool AllowNans = false;
+            ui8 BitsPerObject = 8;
+
+            // quantized values for objects in current block
+            TVector<ui8> BlockData;
+        };
+
+    private:
+        TQuantizedFeaturesInfoPtr QuantizedFeaturesInfo;
+        bool IsLearnData;
+
+        TVector<TFloatFeatureQuantization> FloatFeatures; // [perTypeFeatureIdx]
+
+        TQuantizedFeaturesDataProviderBuilder QuantizedDataBuilder;
+
+        ui32 BlockOffset;
+        ui32 BlockSize;
+
+        bool InProcess;
+    };
+
+
     THolder<IDataProviderBuilder> CreateDataProviderBuilder(
         EDatasetVisitorType visitorType,
         const TDataProviderBuilderOptions& options,
@@ -2069,4 +2536,18 @@ namespace NCB {
                 return nullptr;
         }
     }
+
+    THolder<IDataProviderBuilder> CreateQuantizingDataProviderBuilder(
+        const TDataProviderBuilderOptions& options,
+        TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
+        bool isLearnData,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        return MakeHolder<TQuantizingRawObjectsOrderDataProviderBuilder>(
+            options,
+            std::move(quantizedFeaturesInfo),
+            isLearnData,
+            localExecutor
+        );
+    }
 }
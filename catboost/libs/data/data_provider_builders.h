@@ -61,6 +61,23 @@ namespace NCB {
     );
 
 
+    /* Builder for raw data in objects order with float features only: float features are quantized
+     * with borders and nan modes from quantizedFeaturesInfo while being added, so raw float feature values
+     * are never stored, result contains quantized objects data.
+     * quantizedFeaturesInfo must contain borders and nan modes for all available float features.
+     * For learn data NaNs are checked against nan_mode option, and if the sample nan modes were calculated on
+     * had no NaNs, quantizedFeaturesInfo is updated to reserve a bin for them as nan_mode option says.
+     * For test data NaNs are processed as usual for quantization.
+     * Block processing is not supported.
+     */
+    THolder<IDataProviderBuilder> CreateQuantizingDataProviderBuilder(
+        const TDataProviderBuilderOptions& options,
+        TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
+        bool isLearnData,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+
     class TDataProviderClosure : public IDataProviderBuilder
     {
     public:
@@ -1,19 +1,142 @@
 #include "baseline.h"
 #include "load_data.h"
 
+#include "borders_io.h"
 #include "cb_dsv_loader.h"
 #include "data_provider_builders.h"
+#include "quantization.h"
 
 #include <catboost/libs/column_description/cd_parser.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/int_cast.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/helpers/sample.h>
 #include <catboost/libs/logging/logging.h>
+#include <catboost/private/libs/quantization/utils.h>
 
 #include <util/datetime/base.h>
+#include <util/generic/algorithm.h>
 
 
 namespace NCB {
 
+    namespace {
+        // reads only lines with specified indices from source reader
+        class TSampledLineDataReader final : public ILineDataReader {
+        public:
+            TSampledLineDataReader(
+                THolder<ILineDataReader> srcReader,
+                TVector<ui32> sampledLineIndices // must be sorted
+            )
+                : SrcReader(std::move(srcReader))
+                , SampledLineIndices(std::move(sampledLineIndices))
+                , NextSampledLineIdx(0)
+                , NextSrcLineIdx(0)
+            {
+                Y_ASSERT(IsSorted(SampledLineIndices.begin(), SampledLineIndices.end()));
+            }
+
+            ui64 GetDataLineCount() override {
+                return SampledLineIndices.size();
+            }
+
+            TMaybe<TString> GetHeader() override {
+                return SrcReader->GetHeader();
+            }
+
+            bool ReadLine(TString* line) override {
+                if (NextSampledLineIdx == SampledLineIndices.size()) {
+                    return false;
+                }
+                const ui32 srcLineIdx = SampledLineIndices[NextSampledLineIdx++];
+                for (; NextSrcLineIdx <= srcLineIdx; ++NextSrcLineIdx) {
+                    CB_ENSURE(SrcReader->ReadLine(line), "Unexpected end of data at line " << NextSrcLineIdx);
+                }
+                return true;
+            }
+
+        private:
+            THolder<ILineDataReader> SrcReader;
+            TVector<ui32> SampledLineIndices;
+            size_t NextSampledLineIdx;
+            ui32 NextSrcLineIdx;
+        };
+    }
+
+
+    // number of objects passed from dataset loaders to visitors in one block
+    constexpr ui32 DATASET_LOADER_BLOCK_SIZE = 10000;
+
+    static TDatasetLoaderCommonArgs MakeDatasetLoaderCommonArgs(
+        const TPathWithScheme& pairsFilePath, // can be uninited
+        const TPathWithScheme& groupWeightsFilePath, // can be uninited
+        const TPathWithScheme& timestampsFilePath, // can be uninited
+        const TPathWithScheme& baselineFilePath, // can be uninited
+        const TPathWithScheme& featureNamesPath, // can be uninited
+        const TVector<NJson::TJsonValue>& classLabels, // is referenced, must be alive until loader is created
+        const NCB::TDsvFormatOptions& poolFormat,
+        THolder<ICdProvider> cdProvider,
+        const TVector<ui32>& ignoredFeatures,
+        EObjectsOrder objectsOrder,
+        TDatasetSubset loadSubset,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        return TDatasetLoaderCommonArgs {
+            pairsFilePath,
+            groupWeightsFilePath,
+            baselineFilePath,
+            timestampsFilePath,
+            featureNamesPath,
+            classLabels,
+            poolFormat,
+            std::move(cdProvider),
+            ignoredFeatures,
+            objectsOrder,
+            DATASET_LOADER_BLOCK_SIZE,
+            loadSubset,
+            localExecutor
+        };
+    }
+
+    static TDataProviderPtr ReadDsvDataset(
+        THolder<ILineDataReader> poolReader,
+        const TPathWithScheme& pairsFilePath, // can be uninited
+        const TPathWithScheme& groupWeightsFilePath, // can be uninited
+        const TPathWithScheme& timestampsFilePath, // can be uninited
+        const TPathWithScheme& baselineFilePath, // can be uninited
+        const TPathWithScheme& featureNamesPath, // can be uninited
+        const NCB::TDsvFormatOptions& poolFormat,
+        THolder<ICdProvider> cdProvider,
+        const TVector<ui32>& ignoredFeatures,
+        EObjectsOrder objectsOrder,
+        TDatasetSubset loadSubset,
+        const TVector<NJson::TJsonValue>& classLabels,
+        IDataProviderBuilder* dataProviderBuilder,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        TCBDsvDataLoader datasetLoader(
+            TLineDataLoaderPushArgs {
+                std::move(poolReader),
+                MakeDatasetLoaderCommonArgs(
+                    pairsFilePath,
+                    groupWeightsFilePath,
+                    timestampsFilePath,
+                    baselineFilePath,
+                    featureNamesPath,
+                    classLabels,
+                    poolFormat,
+                    std::move(cdProvider),
+                    ignoredFeatures,
+                    objectsOrder,
+                    loadSubset,
+                    localExecutor
+                )
+            }
+        );
+        datasetLoader.DoIfCompatible(dynamic_cast<IDatasetVisitor*>(dataProviderBuilder));
+        return dataProviderBuilder->GetResult();
+    }
+
     TDataProviderPtr ReadDataset(
         const TPathWithScheme& poolPath,
         const TPathWithScheme& pairsFilePath, // can be uninited
@@ -38,22 +161,20 @@ namespace NCB {
             // processor args
             TDatasetLoaderPullArgs {
                 poolPath,
-
-                TDatasetLoaderCommonArgs {
+                MakeDatasetLoaderCommonArgs(
                     pairsFilePath,
                     groupWeightsFilePath,
-                    baselineFilePath,
                     timestampsFilePath,
+                    baselineFilePath,
                     featureNamesPath,
                     classLabels ? **classLabels : TVector<NJson::TJsonValue>(),
                     columnarPoolFormatParams.DsvFormat,
                     MakeCdProviderFromFile(columnarPoolFormatParams.CdFilePath),
                     ignoredFeatures,
                     objectsOrder,
-                    10000, // TODO: make it a named constant
                     loadSubset,
                     localExecutor
-                }
+                )
             }
         );
 
@@ -137,29 +258,22 @@ namespace NCB {
             "Failed to create data provider builder for visitor of type RawObjectsOrder";
         );
 
-        TCBDsvDataLoader datasetLoader(
-            TLineDataLoaderPushArgs {
-                std::move(poolReader),
-
-                TDatasetLoaderCommonArgs {
-                    pairsFilePath,
-                    groupWeightsFilePath,
-                    baselineFilePath,
-                    timestampsFilePath,
-                    featureNamesPath,
-                    classLabels ? **classLabels : TVector<NJson::TJsonValue>(),
-                    poolFormat,
-                    MakeCdProviderFromArray(columnsDescription),
-                    ignoredFeatures,
-                    objectsOrder,
-                    10000, // TODO: make it a named constant
-                    loadSubset,
-                    localExecutor
-                }
-            }
+        return ReadDsvDataset(
+            std::move(poolReader),
+            pairsFilePath,
+            groupWeightsFilePath,
+            timestampsFilePath,
+            baselineFilePath,
+            featureNamesPath,
+            poolFormat,
+            MakeCdProviderFromArray(columnsDescription),
+            ignoredFeatures,
+            objectsOrder,
+            loadSubset,
+            classLabels ? **classLabels : TVector<NJson::TJsonValue>(),
+            dataProviderBuilder.Get(),
+            localExecutor
         );
-        datasetLoader.DoIfCompatible(dynamic_cast<IDatasetVisitor*>(dataProviderBuilder.Get()));
-        return dataProviderBuilder->GetResult();
     }
 
     TDataProviders ReadTrainDatasets(
@@ -240,4 +354,213 @@ namespace NCB {
         return dataProviders;
     }
 
+
+    static bool IsDsvScheme(const TPathWithScheme& path) {
+        return path.Scheme.empty() || (path.Scheme == "dsv");
+    }
+
+    bool IsQuantizationWhileLoadingSupported(const NCatboostOptions::TPoolLoadParams& loadOptions) {
+        if (!IsDsvScheme(loadOptions.LearnSetPath)) {
+            return false;
+        }
+        for (const auto& testSetPath : loadOptions.TestSetPaths) {
+            if (!IsDsvScheme(testSetPath)) {
+                return false;
+            }
+        }
+        const auto& cdFilePath = loadOptions.ColumnarPoolFormatParams.CdFilePath;
+        if (cdFilePath.Inited()) {
+            for (const auto& column : MakeCdProviderFromFile(cdFilePath)->GetColumnsDescription(Nothing())) {
+                if ((column.Type == EColumn::Categ) || (column.Type == EColumn::Text)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    TDataProviders ReadAndQuantizeTrainDatasets(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& params,
+        EObjectsOrder objectsOrder,
+        TMaybe<TVector<NJson::TJsonValue>*> classLabels,
+        NPar::TLocalExecutor* const executor,
+        TProfileInfo* const profile
+    ) {
+        loadOptions.Validate();
+        CB_ENSURE(
+            IsQuantizationWhileLoadingSupported(loadOptions),
+            "Quantization while loading is supported only for CatBoost dsv datasets"
+            " without categorical and text features"
+        );
+
+        const auto& dataProcessingOptions = params.DataProcessingOptions.Get();
+
+        TQuantizationOptions quantizationOptions;
+        quantizationOptions.CpuRamLimit = ParseMemorySizeDescription(params.SystemOptions->CpuUsedRamLimit.Get());
+
+        TDataProviderBuilderOptions builderOptions;
+        builderOptions.GpuCompatibleFormat = params.GetTaskType() == ETaskType::GPU;
+        builderOptions.MaxCpuRamUsage = quantizationOptions.CpuRamLimit;
+
+        const TVector<NJson::TJsonValue> emptyClassLabels;
+
+        TQuantizedFeaturesInfoPtr quantizedFeaturesInfo;
+        {
+            CATBOOST_DEBUG_LOG << "Loading learn sample for borders calculation..." << Endl;
+            auto start = Now();
+
+            THolder<ILineDataReader> learnReader = GetLineDataReader(
+                loadOptions.LearnSetPath,
+                loadOptions.ColumnarPoolFormatParams.DsvFormat
+            );
+            const ui64 learnObjectCount = learnReader->GetDataLineCount();
+            CB_ENSURE(
+                learnObjectCount <= Max<ui32>(), "CatBoost does not support datasets with more than "
+                << Max<ui32>() << " objects"
+            );
+            const ui32 sampleSize = GetSampleSizeForBorderSelectionType(
+                (ui32)learnObjectCount,
+                dataProcessingOptions.FloatFeaturesBinarization->BorderSelectionType.Get(),
+                quantizationOptions.MaxSubsetSizeForBuildBordersAlgorithms
+            );
+
+            TRestorableFastRng64 rand(params.RandomSeed.Get());
+            TVector<ui32> sampledLineIndices = SampleIndices<ui32>((size_t)learnObjectCount, sampleSize, &rand);
+            Sort(sampledLineIndices);
+
+            THolder<IDataProviderBuilder> sampleBuilder = CreateDataProviderBuilder(
+                EDatasetVisitorType::RawObjectsOrder,
+                TDataProviderBuilderOptions{},
+                TDatasetSubset::MakeColumns(),
+                executor
+            );
+            CB_ENSURE_INTERNAL(
+                sampleBuilder,
+                "Failed to create data provider builder for visitor of type RawObjectsOrder"
+            );
+
+            // additional data files refer to all objects so they are not loaded for the sample
+            TDataProviderPtr learnSample = ReadDsvDataset(
+                MakeHolder<TSampledLineDataReader>(std::move(learnReader), std::move(sampledLineIndices)),
+                /*pairsFilePath*/ TPathWithScheme(),
+                /*groupWeightsFilePath*/ TPathWithScheme(),
+                /*timestampsFilePath*/ TPathWithScheme(),
+                /*baselineFilePath*/ TPathWithScheme(),
+                loadOptions.FeatureNamesPath,
+                loadOptions.ColumnarPoolFormatParams.DsvFormat,
+                MakeCdProviderFromFile(loadOptions.ColumnarPoolFormatParams.CdFilePath),
+                loadOptions.IgnoredFeatures,
+                objectsOrder,
+                TDatasetSubset::MakeColumns(),
+                emptyClassLabels,
+                sampleBuilder.Get(),
+                executor
+            );
+
+            quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                *learnSample->MetaInfo.FeaturesLayout,
+                dataProcessingOptions.IgnoredFeatures.Get(),
+                dataProcessingOptions.FloatFeaturesBinarization.Get(),
+                dataProcessingOptions.PerFloatFeatureQuantization.Get(),
+                dataProcessingOptions.TextProcessingOptions.Get(),
+                /*allowNansInTestOnly*/true
+            );
+            if (loadOptions.BordersFile) {
+                LoadBordersAndNanModesFromFromFileInMatrixnetFormat(
+                    loadOptions.BordersFile,
+                    quantizedFeaturesInfo.Get()
+                );
+            }
+
+            TRawDataProviderPtr rawLearnSample = learnSample->CastMoveTo<TRawObjectsDataProvider>();
+            CB_ENSURE_INTERNAL(rawLearnSample, "Learn sample is not raw data");
+
+            CalcBordersAndNanMode(
+                quantizationOptions,
+                std::move(rawLearnSample),
+                quantizedFeaturesInfo,
+                &rand,
+                executor
+            );
+
+            CATBOOST_DEBUG_LOG << "Borders calculation on learn sample of " << sampleSize << " objects time: "
+                << (Now() - start).Seconds() << Endl;
+            if (profile) {
+                profile->AddOperation("Calc borders on learn sample");
+            }
+        }
+
+        auto readDataset = [&] (
+            bool isLearnData,
+            const TPathWithScheme& poolPath,
+            const TPathWithScheme& pairsFilePath,
+            const TPathWithScheme& groupWeightsFilePath,
+            const TPathWithScheme& timestampsFilePath,
+            const TPathWithScheme& baselineFilePath
+        ) {
+            if (classLabels) {
+                UpdateClassLabelsFromBaselineFile(baselineFilePath, *classLabels);
+            }
+            THolder<IDataProviderBuilder> dataProviderBuilder = CreateQuantizingDataProviderBuilder(
+                builderOptions,
+                quantizedFeaturesInfo,
+                isLearnData,
+                executor
+            );
+            return ReadDsvDataset(
+                GetLineDataReader(poolPath, loadOptions.ColumnarPoolFormatParams.DsvFormat),
+                pairsFilePath,
+                groupWeightsFilePath,
+                timestampsFilePath,
+                baselineFilePath,
+                loadOptions.FeatureNamesPath,
+                loadOptions.ColumnarPoolFormatParams.DsvFormat,
+                MakeCdProviderFromFile(loadOptions.ColumnarPoolFormatParams.CdFilePath),
+                loadOptions.IgnoredFeatures,
+                objectsOrder,
+                TDatasetSubset::MakeColumns(),
+                classLabels ? **classLabels : emptyClassLabels,
+                dataProviderBuilder.Get(),
+                executor
+            );
+        };
+
+        TDataProviders dataProviders;
+
+        CATBOOST_DEBUG_LOG << "Loading and quantizing features..." << Endl;
+        auto start = Now();
+        dataProviders.Learn = readDataset(
+            /*isLearnData*/ true,
+            loadOptions.LearnSetPath,
+            loadOptions.PairsFilePath,
+            loadOptions.GroupWeightsFilePath,
+            loadOptions.TimestampsFilePath,
+            loadOptions.BaselineFilePath
+        );
+        CATBOOST_DEBUG_LOG << "Loading and quantizing features time: " << (Now() - start).Seconds() << Endl;
+        if (profile) {
+            profile->AddOperation("Build quantized learn pool");
+        }
+
+        CATBOOST_DEBUG_LOG << "Loading and quantizing test..." << Endl;
+        for (int testIdx = 0; testIdx < loadOptions.TestSetPaths.ysize(); ++testIdx) {
+            dataProviders.Test.push_back(
+                readDataset(
+                    /*isLearnData*/ false,
+                    loadOptions.TestSetPaths[testIdx],
+                    testIdx == 0 ? loadOptions.TestPairsFilePath : TPathWithScheme(),
+                    testIdx == 0 ? loadOptions.TestGroupWeightsFilePath : TPathWithScheme(),
+                    testIdx == 0 ? loadOptions.TestTimestampsFilePath : TPathWithScheme(),
+                    testIdx == 0 ? loadOptions.TestBaselineFilePath : TPathWithScheme()
+                )
+            );
+            if (profile && (testIdx + 1 == loadOptions.TestSetPaths.ysize())) {
+                profile->AddOperation("Build quantized test pool");
+            }
+        }
+
+        return dataProviders;
+    }
+
 } // NCB
@@ -8,6 +8,7 @@
 #include <catboost/private/libs/data_util/line_data_reader.h>
 #include <catboost/private/libs/data_util/path_with_scheme.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/private/libs/options/catboost_options.h>
 #include <catboost/private/libs/options/load_options.h>
 
 #include <library/threading/local_executor/local_executor.h>
@@ -81,4 +82,21 @@ namespace NCB {
         TProfileInfo* profile
     );
 
+    // ReadAndQuantizeTrainDatasets supports only CatBoost dsv datasets without categorical and text features
+    bool IsQuantizationWhileLoadingSupported(const NCatboostOptions::TPoolLoadParams& loadOptions);
+
+    /* Read learn and test datasets as quantized data:
+     *  borders and nan modes are calculated on the random sample of learn objects loaded as raw data,
+     *  then datasets are read again and float features are quantized while being parsed, so raw float
+     *  features of the whole learn dataset are never stored in memory.
+     */
+    TDataProviders ReadAndQuantizeTrainDatasets(
+        const NCatboostOptions::TPoolLoadParams& loadOptions,
+        const NCatboostOptions::TCatBoostOptions& params,
+        EObjectsOrder objectsOrder,
+        TMaybe<TVector<NJson::TJsonValue>*> classLabels,
+        NPar::TLocalExecutor* executor,
+        TProfileInfo* profile
+    );
+
 }
@@ -10,6 +10,7 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/ptr.h>
 #include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/string/cast.h>
 #include <util/string/split.h>
 #include <util/system/types.h>
@@ -456,8 +457,107 @@ namespace NCB {
         }
     }
 
+    /* Fast path for plain decimal numbers like "-12.375" or "15e-3" that are the bulk of dsv data.
+     * If decimal mantissa is not greater than 2^53 and absolute value of decimal exponent is not greater than 22
+     * both of them are exact doubles, so their product or quotient is correctly rounded (Clinger's fast path)
+     * and is the same as the result of StrToD used by TryFromString. Returns false for anything else.
+     */
+    static bool TryParseDecimalFast(TStringBuf stringValue, double* value) {
+        static constexpr double POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        constexpr int MAX_EXACT_POWER = 22;
+        constexpr int MAX_SIGNIFICANT_DIGITS = 19; // fit into ui64
+
+        const char* ptr = stringValue.begin();
+        const char* const end = stringValue.end();
+        const auto isDigit = [&] () {
+            return ptr != end && *ptr >= '0' && *ptr <= '9';
+        };
+
+        bool negative = false;
+        if (ptr != end && (*ptr == '-' || *ptr == '+')) {
+            negative = (*ptr == '-');
+            ++ptr;
+        }
+
+        ui64 mantissa = 0;
+        int significantDigitCount = 0;
+        int exponent = 0;
+        const auto addDigit = [&] () {
+            if (mantissa || *ptr != '0') {
+                if (++significantDigitCount > MAX_SIGNIFICANT_DIGITS) {
+                    return false;
+                }
+            }
+            mantissa = mantissa * 10 + (*ptr - '0');
+            ++ptr;
+            return true;
+        };
+
+        const char* const integerPartBegin = ptr;
+        while (isDigit()) {
+            if (!addDigit()) {
+                return false;
+            }
+        }
+        if (ptr == integerPartBegin) {
+            return false;
+        }
+        if (ptr != end && *ptr == '.') {
+            ++ptr;
+            const char* const fractionalPartBegin = ptr;
+            while (isDigit()) {
+                if (!addDigit()) {
+                    return false;
+                }
+                --exponent;
+            }
+            if (ptr == fractionalPartBegin) {
+                return false;
+            }
+        }
+        if (ptr != end && (*ptr == 'e' || *ptr == 'E')) {
+            ++ptr;
+            bool negativeExponent = false;
+            if (ptr != end && (*ptr == '-' || *ptr == '+')) {
+                negativeExponent = (*ptr == '-');
+                ++ptr;
+            }
+            const char* const exponentBegin = ptr;
+            int explicitExponent = 0;
+            while (isDigit()) {
+                if (explicitExponent > 1000) {
+                    return false;
+                }
+                explicitExponent = explicitExponent * 10 + (*ptr - '0');
+                ++ptr;
+            }
+            if (ptr == exponentBegin) {
+                return false;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        if ((ptr != end) || (mantissa > (ui64(1) << 53)) || (Abs(exponent) > MAX_EXACT_POWER)) {
+            return false;
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            result /= POWERS_OF_TEN[-exponent];
+        } else {
+            result *= POWERS_OF_TEN[exponent];
+        }
+        *value = negative ? -result : result;
+        return true;
+    }
+
     bool TryParseFloatFeatureValue(TStringBuf stringValue, float* value) {
-        if (!TryFromString<float>(stringValue, *value)) {
+        double decimalValue;
+        if (TryParseDecimalFast(stringValue, &decimalValue)) {
+            *value = static_cast<float>(decimalValue);
+        } else if (!TryFromString<float>(stringValue, *value)) {
             if (IsMissingValue(stringValue)) {
                 *value = std::numeric_limits<float>::quiet_NaN();
             } else {
@@ -6,11 +6,14 @@
 #include <catboost/libs/data/load_data.h>
 
 #include <catboost/libs/data/data_provider.h>
+#include <catboost/libs/data/data_provider_builders.h>
 #include <catboost/libs/data/objects_grouping.h>
+#include <catboost/libs/data/quantization.h>
 
 #include <util/generic/fwd.h>
 #include <util/generic/maybe.h>
 #include <util/generic/strbuf.h>
+#include <util/generic/xrange.h>
 
 #include <library/unittest/registar.h>
 
@@ -1139,4 +1142,184 @@ Y_UNIT_TEST_SUITE(LoadDataFromDsv) {
             TestReadDataset(testCase);
         }
     }
+
+    Y_UNIT_TEST(ReadAndQuantizeTrainDatasets) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tGroupId\n"
+        );
+        srcData.DatasetFileData = AsStringBuf(
+            "0\tquery0\t0.1\t0.2\t1\n"
+            "1\tquery0\t0.97\tnan\t1\n"
+            "0\tquery1\t0.13\t0.22\t1\n"
+            "1\tquery1\t0.5\t0.9\t1\n"
+            "0\tquery1\t-0.2\t0.0\t1\n"
+            "1\tquery2\t0.1\tnan\t1\n"
+            "0\tquery2\t0.33\t0.1\t1\n"
+            "1\tquery3\t0.12\t0.3\t1\n"
+        );
+
+        TReadDatasetMainParams readDatasetMainParams;
+
+        // TODO(akhropov): temporarily use THolder until TTempFile move semantic are fixed
+        TVector<THolder<TTempFile>> srcDataFiles;
+
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NCatboostOptions::TPoolLoadParams loadOptions;
+        loadOptions.LearnSetPath = readDatasetMainParams.PoolPath;
+        loadOptions.TestSetPaths = {readDatasetMainParams.PoolPath};
+        loadOptions.ColumnarPoolFormatParams = readDatasetMainParams.ColumnarPoolFormatParams;
+
+        UNIT_ASSERT(IsQuantizationWhileLoadingSupported(loadOptions));
+
+        NCatboostOptions::TCatBoostOptions params(ETaskType::CPU);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TDataProviders quantizedDataProviders = ReadAndQuantizeTrainDatasets(
+            loadOptions,
+            params,
+            EObjectsOrder::Undefined,
+            Nothing(),
+            &localExecutor,
+            nullptr
+        );
+        UNIT_ASSERT_VALUES_EQUAL(quantizedDataProviders.Test.size(), 1);
+
+        TDataProviderPtr rawDataProvider = ReadDataset(
+            readDatasetMainParams.PoolPath,
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            readDatasetMainParams.ColumnarPoolFormatParams,
+            TVector<ui32>(),
+            EObjectsOrder::Undefined,
+            TDatasetSubset::MakeColumns(),
+            Nothing(),
+            &localExecutor
+        );
+
+        auto* learnObjectsData = dynamic_cast<TQuantizedForCPUObjectsDataProvider*>(
+            quantizedDataProviders.Learn->ObjectsData.Get()
+        );
+        UNIT_ASSERT(learnObjectsData);
+
+        TQuantizationOptions quantizationOptions;
+        quantizationOptions.GpuCompatibleFormat = false;
+        quantizationOptions.BundleExclusiveFeaturesForCpu = false;
+        quantizationOptions.GroupFeaturesForCpu = false;
+
+        TRestorableFastRng64 rand(0);
+
+        // borders are already calculated so quantization uses them as is
+        auto expectedObjectsData = Quantize(
+            quantizationOptions,
+            dynamic_cast<TRawObjectsDataProvider*>(rawDataProvider->ObjectsData.Get()),
+            learnObjectsData->GetQuantizedFeaturesInfo(),
+            &rand,
+            &localExecutor
+        );
+
+        for (const auto& quantizedDataProvider
+             : {quantizedDataProviders.Learn, quantizedDataProviders.Test[0]})
+        {
+            auto* objectsData = dynamic_cast<TQuantizedForCPUObjectsDataProvider*>(
+                quantizedDataProvider->ObjectsData.Get()
+            );
+            UNIT_ASSERT(objectsData);
+            UNIT_ASSERT_VALUES_EQUAL(objectsData->GetObjectCount(), 8);
+            UNIT_ASSERT_EQUAL(*objectsData->GetGroupIds(), *rawDataProvider->ObjectsData->GetGroupIds());
+            UNIT_ASSERT_EQUAL(
+                *quantizedDataProvider->RawTargetData.GetTarget(),
+                *rawDataProvider->RawTargetData.GetTarget()
+            );
+
+            const ui32 floatFeatureCount = objectsData->GetFeaturesLayout()->GetFloatFeatureCount();
+            UNIT_ASSERT_VALUES_EQUAL(floatFeatureCount, 3);
+            for (auto floatFeatureIdx : xrange(floatFeatureCount)) {
+                auto feature = objectsData->GetFloatFeature(floatFeatureIdx);
+                auto expectedFeature = expectedObjectsData->GetFloatFeature(floatFeatureIdx);
+                UNIT_ASSERT_VALUES_EQUAL(feature.Defined(), expectedFeature.Defined());
+                if (feature) {
+                    UNIT_ASSERT_EQUAL(
+                        *(*feature)->ExtractValues(&localExecutor),
+                        *(*expectedFeature)->ExtractValues(&localExecutor)
+                    );
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(QuantizingBuilderNansInLearn) {
+        // nan modes for quantization while loading are calculated on the learn sample,
+        // so NaNs in learn objects outside of it must still be checked against nan_mode option
+        // and get the bin nan_mode option reserves for them
+        NPar::TLocalExecutor localExecutor;
+
+        TDataMetaInfo metaInfo;
+        metaInfo.TargetType = ERawTargetType::Float;
+        metaInfo.TargetCount = 1;
+        metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>((ui32)1, TVector<ui32>{}, TVector<TString>{});
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+
+        for (auto nanModeOption : {ENanMode::Forbidden, ENanMode::Min, ENanMode::Max}) {
+            for (auto isLearnData : {true, false}) {
+                auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                    *metaInfo.FeaturesLayout,
+                    TConstArrayRef<ui32>(),
+                    NCatboostOptions::TBinarizationOptions(EBorderSelectionType::GreedyLogSum, 32, nanModeOption)
+                );
+                // learn sample had no NaNs
+                quantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(0), TVector<float>{0.5f});
+                quantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(0), ENanMode::Forbidden);
+
+                THolder<IDataProviderBuilder> builder = CreateQuantizingDataProviderBuilder(
+                    TDataProviderBuilderOptions{},
+                    quantizedFeaturesInfo,
+                    isLearnData,
+                    &localExecutor
+                );
+                auto* visitor = dynamic_cast<IRawObjectsOrderDataVisitor*>(builder.Get());
+                UNIT_ASSERT(visitor);
+
+                visitor->Start(false, metaInfo, false, 2, EObjectsOrder::Undefined, {});
+                visitor->StartNextBlock(2);
+                visitor->AddAllFloatFeatures(0, TVector<float>{1.0f});
+                visitor->AddTarget(0, 0.0f);
+                visitor->AddTarget(1, 1.0f);
+
+                if (isLearnData && (nanModeOption == ENanMode::Forbidden)) {
+                    UNIT_ASSERT_EXCEPTION(
+                        visitor->AddAllFloatFeatures(1, TVector<float>{nan}),
+                        TCatBoostException
+                    );
+                    continue;
+                }
+                visitor->AddAllFloatFeatures(1, TVector<float>{nan});
+                visitor->Finish();
+
+                auto* objectsData = dynamic_cast<TQuantizedForCPUObjectsDataProvider*>(
+                    builder->GetResult()->ObjectsData.Get()
+                );
+                UNIT_ASSERT(objectsData);
+                TVector<ui8> expectedBins = {1, 0};
+                ENanMode expectedNanMode = ENanMode::Forbidden;
+                if (isLearnData) {
+                    expectedNanMode = nanModeOption;
+                    expectedBins = (nanModeOption == ENanMode::Min) ? TVector<ui8>{2, 0} : TVector<ui8>{1, 2};
+                }
+                UNIT_ASSERT_EQUAL(
+                    *(*objectsData->GetFloatFeature(0))->ExtractValues(&localExecutor),
+                    TConstArrayRef<ui8>(expectedBins)
+                );
+                UNIT_ASSERT_EQUAL(quantizedFeaturesInfo->GetNanMode(TFloatFeatureIdx(0)), expectedNanMode);
+            }
+        }
+    }
 }
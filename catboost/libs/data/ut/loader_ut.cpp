@@ -0,0 +1,70 @@
+#include <catboost/libs/data/loader.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/strbuf.h>
+#include <util/string/cast.h>
+
+#include <library/unittest/registar.h>
+
+#include <cmath>
+
+
+using namespace NCB;
+
+
+Y_UNIT_TEST_SUITE(TryParseFloatFeatureValue) {
+    Y_UNIT_TEST(SameAsFromString) {
+        const TStringBuf values[] = {
+            "0",
+            "1",
+            "-1",
+            "+2.5",
+            "0.1",
+            "-0.3",
+            "123456.789",
+            "3.14159265358979",
+            "1e22",
+            "1e23",
+            "2.5e-5",
+            "-7E+3",
+            "9007199254740992",
+            "9007199254740993",
+            "1234567890123456789",
+            "12345678901234567890",
+            "0.000000000000000000000000001",
+            "00000000000000000000000001.5",
+            "3.4028235e38",
+            "1.17549435e-38",
+            "1e-50"
+        };
+        for (auto value : values) {
+            float parsedValue = 0.0f;
+            UNIT_ASSERT_C(TryParseFloatFeatureValue(value, &parsedValue), value);
+            UNIT_ASSERT_VALUES_EQUAL_C(parsedValue, FromString<float>(value), value);
+        }
+    }
+
+    Y_UNIT_TEST(NegativeZero) {
+        for (auto value : {TStringBuf("-0"), TStringBuf("-0.0"), TStringBuf("-0e5")}) {
+            float parsedValue = 1.0f;
+            UNIT_ASSERT(TryParseFloatFeatureValue(value, &parsedValue));
+            UNIT_ASSERT_EQUAL(parsedValue, 0.0f);
+            UNIT_ASSERT(!std::signbit(parsedValue));
+        }
+    }
+
+    Y_UNIT_TEST(MissingValues) {
+        for (auto value : {TStringBuf(""), TStringBuf("-"), TStringBuf("nan"), TStringBuf("NA"), TStringBuf("N/A")}) {
+            float parsedValue = 0.0f;
+            UNIT_ASSERT(TryParseFloatFeatureValue(value, &parsedValue));
+            UNIT_ASSERT(std::isnan(parsedValue));
+        }
+    }
+
+    Y_UNIT_TEST(Errors) {
+        for (auto value : {TStringBuf("abc"), TStringBuf("1e"), TStringBuf("1.5.5"), TStringBuf("--1"), TStringBuf("1-")}) {
+            float parsedValue = 0.0f;
+            UNIT_ASSERT_C(!TryParseFloatFeatureValue(value, &parsedValue), value);
+        }
+    }
+}
@@ -249,6 +249,25 @@ namespace NCB {
             TMaybeOwningConstArrayHolder<ui8> featuresPart // per-object data size depends on BitsPerKey
         ) = 0;
 
+        /* Zero-copy alternatives to Add*FeaturePart for data of all objects (e.g. in a memory-mapped file):
+         *  featureData is used by the created data provider as is (ownership is shared using its resource
+         *  holder), so it must be aligned to ui64 and readable up to the end of the ui64 word that contains
+         *  the last object's value.
+         * Return false if the data cannot be used without copying (e.g. the feature is packed with other
+         *  binary features), Add*FeaturePart must be called for this feature then.
+         */
+        virtual bool AddFloatFeatureView(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui8> featureData
+        ) = 0;
+
+        virtual bool AddCatFeatureView(
+            ui32 flatFeatureIdx,
+            ui8 bitsPerDocumentFeature,
+            TMaybeOwningConstArrayHolder<ui8> featureData
+        ) = 0;
+
 
         // TRawTargetData
 
@@ -39,6 +39,46 @@ namespace {
     };
 } //anonymous
 
+void TShapValuesByLeaf::AppendLeaf(TConstArrayRef<TShapValue> shapValues) {
+    for (const TShapValue& shapValue : shapValues) {
+        Y_ASSERT(shapValue.Value.ysize() == ApproxDimension);
+        Features.push_back(shapValue.Feature);
+        Values.insert(Values.end(), shapValue.Value.begin(), shapValue.Value.end());
+    }
+    LeafOffsets.push_back(Features.size());
+}
+
+void TShapValuesByLeaf::Append(const TShapValuesByLeaf& other) {
+    Y_ASSERT(ApproxDimension == other.ApproxDimension);
+    const ui64 offset = Features.size();
+    for (size_t leafIdx = 1; leafIdx < other.LeafOffsets.size(); ++leafIdx) {
+        LeafOffsets.push_back(offset + other.LeafOffsets[leafIdx]);
+    }
+    Features.insert(Features.end(), other.Features.begin(), other.Features.end());
+    Values.insert(Values.end(), other.Values.begin(), other.Values.end());
+}
+
+static inline size_t GetFirstLeafIdx(const TModelTrees& forest, size_t treeIdx) {
+    return forest.GetFirstLeafOffsets()[treeIdx] / forest.GetDimensionsCount();
+}
+
+// shapValues are [dimension][feature]
+static inline void AddShapValuesOfLeaf(
+    const TShapValuesByLeaf& shapValuesByLeaf,
+    size_t leafIdx,
+    TVector<TVector<double>>* shapValues
+) {
+    const int approxDimension = shapValuesByLeaf.ApproxDimension;
+    const ui64 leafEnd = shapValuesByLeaf.LeafOffsets[leafIdx + 1];
+    for (ui64 offset = shapValuesByLeaf.LeafOffsets[leafIdx]; offset < leafEnd; ++offset) {
+        const int feature = shapValuesByLeaf.Features[offset];
+        const double* values = shapValuesByLeaf.Values.data() + offset * approxDimension;
+        for (int dimension = 0; dimension < approxDimension; ++dimension) {
+            (*shapValues)[dimension][feature] += values[dimension];
+        }
+    }
+}
+
 static TVector<TFeaturePathElement> ExtendFeaturePath(
     const TVector<TFeaturePathElement>& oldFeaturePath,
     double zeroPathsFraction,
@@ -735,11 +775,11 @@ void CalcShapValuesForDocumentMulti(
     const size_t treeCount = model.GetTreeCount();
     for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
         if (preparedTrees.CalcShapValuesByLeafForAllTrees && model.IsOblivious()) {
-            for (const TShapValue& shapValue : preparedTrees.ShapValuesByLeafForAllTrees[treeIdx][docIndexes[treeIdx]]) {
-                for (int dimension = 0; dimension < approxDimension; ++dimension) {
-                    (*shapValues)[dimension][shapValue.Feature] += shapValue.Value[dimension];
-                }
-            }
+            AddShapValuesOfLeaf(
+                preparedTrees.ShapValuesByLeafForAllTrees,
+                GetFirstLeafIdx(*model.ModelTrees, treeIdx) + docIndexes[treeIdx],
+                shapValues
+            );
         } else {
             TVector<TShapValue> shapValuesByLeaf;
             if (model.IsOblivious()) {
@@ -790,6 +830,47 @@ void CalcShapValuesForDocumentMulti(
     }
 }
 
+void CalcShapValuesByLeafForDocumentBlock(
+    const TFullModel& model,
+    const TShapPreparedTrees& preparedTrees,
+    int flatFeatureCount,
+    TConstArrayRef<NModelEvaluation::TCalcerIndexType> docIndexes,
+    TArrayRef<TVector<TVector<double>>> shapValues
+) {
+    CB_ENSURE_INTERNAL(
+        preparedTrees.CalcShapValuesByLeafForAllTrees && model.IsOblivious(),
+        "SHAP values of leaves must be precalculated"
+    );
+    const TModelTrees& forest = *model.ModelTrees;
+    const int approxDimension = model.GetDimensionsCount();
+    const size_t treeCount = model.GetTreeCount();
+    const size_t documentCount = shapValues.size();
+    Y_ASSERT(docIndexes.size() == documentCount * treeCount);
+    for (auto& documentShapValues : shapValues) {
+        documentShapValues.assign(approxDimension, TVector<double>(flatFeatureCount + 1, 0.0));
+    }
+    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+        const size_t firstLeafIdx = GetFirstLeafIdx(forest, treeIdx);
+        const auto& meanValues = preparedTrees.MeanValuesForAllTrees[treeIdx];
+        for (size_t documentIdx = 0; documentIdx < documentCount; ++documentIdx) {
+            auto& documentShapValues = shapValues[documentIdx];
+            AddShapValuesOfLeaf(
+                preparedTrees.ShapValuesByLeafForAllTrees,
+                firstLeafIdx + docIndexes[documentIdx * treeCount + treeIdx],
+                &documentShapValues
+            );
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                documentShapValues[dimension][flatFeatureCount] += meanValues[dimension];
+            }
+        }
+    }
+    if (approxDimension == 1) {
+        for (auto& documentShapValues : shapValues) {
+            documentShapValues[0][flatFeatureCount] += model.GetScaleAndBias().Bias;
+        }
+    }
+}
+
 static void CalcShapValuesForDocumentBlockMulti(
     const TFullModel& model,
     const IFeaturesBlockIterator& featuresBlockIterator,
@@ -821,6 +902,24 @@ static void CalcShapValuesForDocumentBlockMulti(
     const int oldShapValuesSize = shapValuesForAllDocuments->size();
     shapValuesForAllDocuments->resize(oldShapValuesSize + end - start);
 
+    if (preparedTrees.CalcShapValuesByLeafForAllTrees && model.IsOblivious()) {
+        const size_t treeCount = model.GetTreeCount();
+        NPar::TLocalExecutor::TExecRangeParams blockParams(0, documentCount);
+        blockParams.SetBlockCount(localExecutor->GetThreadCount() + 1);
+        localExecutor->ExecRange([&] (int blockId) {
+            const size_t blockStart = blockParams.FirstId + blockId * blockParams.GetBlockSize();
+            const size_t blockEnd = Min<size_t>(blockStart + blockParams.GetBlockSize(), blockParams.LastId);
+            CalcShapValuesByLeafForDocumentBlock(
+                model,
+                preparedTrees,
+                flatFeatureCount,
+                MakeArrayRef(indexes.data() + blockStart * treeCount, (blockEnd - blockStart) * treeCount),
+                MakeArrayRef(shapValuesForAllDocuments->data() + oldShapValuesSize + blockStart, blockEnd - blockStart)
+            );
+        }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        return;
+    }
+
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, documentCount);
     localExecutor->ExecRange([&] (size_t documentIdxInBlock) {
         TVector<TVector<double>>& shapValues = (*shapValuesForAllDocuments)[oldShapValuesSize + documentIdxInBlock];
@@ -858,6 +957,7 @@ static void CalcShapValuesByLeafForTreeBlock(
 ) {
     TVector<int> binFeatureCombinationClass = preparedTrees->BinFeatureCombinationClass;
     TVector<TVector<int>> combinationClassFeatures = preparedTrees->CombinationClassFeatures;
+    TVector<TShapValuesByLeaf> shapValuesByLeafForTreeBlock(end - start);
 
     NPar::TLocalExecutor::TExecRangeParams blockParams(start, end);
     localExecutor->ExecRange([&] (size_t treeIdx) {
@@ -869,8 +969,9 @@ static void CalcShapValuesByLeafForTreeBlock(
         preparedTrees->AverageApproxByTree[treeIdx] = isSoftmaxLogLoss ? CalcAverageApprox(preparedTrees->MeanValuesForAllTrees[treeIdx]) : 0;
         if (preparedTrees->CalcShapValuesByLeafForAllTrees && isOblivious) {
             const size_t leafCount = (size_t(1) << forest.GetTreeSizes()[treeIdx]);
-            TVector<TVector<TShapValue>>& shapValuesByLeaf = preparedTrees->ShapValuesByLeafForAllTrees[treeIdx];
-            shapValuesByLeaf.resize(leafCount);
+            TShapValuesByLeaf& shapValuesByLeaf = shapValuesByLeafForTreeBlock[treeIdx - start];
+            shapValuesByLeaf.ApproxDimension = forest.GetDimensionsCount();
+            TVector<TShapValue> shapValuesForLeaf;
             for (size_t leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
                 CalcObliviousShapValuesForLeaf(
                     forest,
@@ -880,14 +981,23 @@ static void CalcShapValuesByLeafForTreeBlock(
                     treeIdx,
                     subtreeWeights,
                     calcInternalValues,
-                    &shapValuesByLeaf[leafIdx],
+                    &shapValuesForLeaf,
                     preparedTrees->AverageApproxByTree[treeIdx]
                 );
+                shapValuesByLeaf.AppendLeaf(shapValuesForLeaf);
             }
         } else {
             preparedTrees->SubtreeWeightsForAllTrees[treeIdx] = subtreeWeights;
         }
     }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    // trees are appended in order, so leaves are indexed as in model leaf values
+    for (auto& shapValuesByLeaf : shapValuesByLeafForTreeBlock) {
+        if (shapValuesByLeaf.GetLeafCount() > 0) {
+            preparedTrees->ShapValuesByLeafForAllTrees.Append(shapValuesByLeaf);
+        }
+        shapValuesByLeaf = TShapValuesByLeaf();
+    }
 }
 
 bool IsPrepareTreesCalcShapValues(
@@ -998,7 +1108,7 @@ TShapPreparedTrees PrepareTrees(
             = modelLeafWeights.empty() ? leafWeights : modelLeafWeights;
     }
 
-    preparedTrees.ShapValuesByLeafForAllTrees.resize(treeCount);
+    preparedTrees.ShapValuesByLeafForAllTrees.ApproxDimension = model.GetDimensionsCount();
     preparedTrees.SubtreeWeightsForAllTrees.resize(treeCount);
     preparedTrees.MeanValuesForAllTrees.resize(treeCount);
     preparedTrees.AverageApproxByTree.resize(treeCount);
@@ -1102,9 +1212,12 @@ void CalcShapValuesInternalForFeature(
             auto docIndexes = MakeArrayRef(indexes.data() + forest.GetTreeCount() * (documentIdx - startIdx), forest.GetTreeCount());
             for (size_t treeIdx = 0; treeIdx < forest.GetTreeCount(); ++treeIdx) {
                 if (preparedTrees.CalcShapValuesByLeafForAllTrees && model.IsOblivious()) {
-                    for (const TShapValue& shapValue : preparedTrees.ShapValuesByLeafForAllTrees[treeIdx][docIndexes[treeIdx]]) {
+                    const auto& shapValuesByLeaf = preparedTrees.ShapValuesByLeafForAllTrees;
+                    const size_t leafIdx = GetFirstLeafIdx(forest, treeIdx) + docIndexes[treeIdx];
+                    for (ui64 offset = shapValuesByLeaf.LeafOffsets[leafIdx]; offset < shapValuesByLeaf.LeafOffsets[leafIdx + 1]; ++offset) {
+                        const double* values = shapValuesByLeaf.Values.data() + offset * shapValuesByLeaf.ApproxDimension;
                         for (int dimension = 0; dimension < (int)forest.GetDimensionsCount(); ++dimension) {
-                            docShapValues[shapValue.Feature][dimension] += shapValue.Value[dimension];
+                            docShapValues[shapValuesByLeaf.Features[offset]][dimension] += values[dimension];
                         }
                     }
                 } else {
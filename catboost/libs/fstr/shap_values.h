@@ -5,6 +5,7 @@
 #include <catboost/private/libs/options/enums.h>
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 #include <util/stream/input.h>
 #include <util/stream/output.h>
@@ -28,8 +29,32 @@ public:
     Y_SAVELOAD_DEFINE(Feature, Value);
 };
 
+/**
+ * SHAP values of all leaves of all oblivious trees in flat arrays.
+ * Leaves are indexed as in model leaf values: leaf leafIdx of tree treeIdx has index
+ *  GetFirstLeafOffsets()[treeIdx] / approxDimension + leafIdx.
+ */
+struct TShapValuesByLeaf {
+    int ApproxDimension = 0;
+    //! [leaf index] -> offset of first SHAP value of the leaf, last element is total SHAP value count
+    TVector<ui64> LeafOffsets = {0};
+    TVector<int> Features; // [offset]
+    TVector<double> Values; // [offset * ApproxDimension + dimension]
+
+public:
+    void AppendLeaf(TConstArrayRef<TShapValue> shapValues);
+    //! Add values from other, where leaves go after leaves of this
+    void Append(const TShapValuesByLeaf& other);
+
+    size_t GetLeafCount() const {
+        return LeafOffsets.size() - 1;
+    }
+
+    Y_SAVELOAD_DEFINE(ApproxDimension, LeafOffsets, Features, Values);
+};
+
 struct TShapPreparedTrees {
-    TVector<TVector<TVector<TShapValue>>> ShapValuesByLeafForAllTrees; // [treeIdx][leafIdx][shapFeature] trees * 2^d * d
+    TShapValuesByLeaf ShapValuesByLeafForAllTrees; // filled only if CalcShapValuesByLeafForAllTrees is set
     TVector<TVector<double>> MeanValuesForAllTrees;
     TVector<double> AverageApproxByTree;
     TVector<int> BinFeatureCombinationClass;
@@ -42,15 +67,6 @@ struct TShapPreparedTrees {
 public:
     TShapPreparedTrees() = default;
 
-    TShapPreparedTrees(
-        const TVector<TVector<TVector<TShapValue>>>& shapValuesByLeafForAllTrees,
-        const TVector<TVector<double>>& meanValuesForAllTrees
-    )
-        : ShapValuesByLeafForAllTrees(shapValuesByLeafForAllTrees)
-        , MeanValuesForAllTrees(meanValuesForAllTrees)
-    {
-    }
-
     Y_SAVELOAD_DEFINE(
         ShapValuesByLeafForAllTrees,
         MeanValuesForAllTrees,
@@ -74,6 +90,21 @@ void CalcShapValuesForDocumentMulti(
     TVector<TVector<double>>* shapValues
 );
 
+/**
+ * Batch counterpart of CalcShapValuesForDocumentMulti for precalculated SHAP values of leaves
+ *  (preparedTrees.CalcShapValuesByLeafForAllTrees is set): trees go in the outer loop, so SHAP values of a leaf
+ *  are gathered for all documents of the block while they are in cache.
+ * @param docIndexes leaf indexes from IModelEvaluator::CalcLeafIndexes, [documentIdx * treeCount + treeIdx]
+ * @param shapValues [documentIdx][dimension][feature], documentIdx in [0, docIndexes.size() / treeCount)
+ */
+void CalcShapValuesByLeafForDocumentBlock(
+    const TFullModel& model,
+    const TShapPreparedTrees& preparedTrees,
+    int flatFeatureCount,
+    TConstArrayRef<NCB::NModelEvaluation::TCalcerIndexType> docIndexes,
+    TArrayRef<TVector<TVector<double>>> shapValues
+);
+
 TShapPreparedTrees PrepareTrees(const TFullModel& model, NPar::TLocalExecutor* localExecutor);
 TShapPreparedTrees PrepareTrees(
     const TFullModel& model,
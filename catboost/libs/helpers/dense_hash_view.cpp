@@ -1 +1,29 @@
 #include "dense_hash_view.h"
+
+namespace NCatboost {
+    TVector<TBucketGroup> ConvertToBucketGroups(TConstArrayRef<TBucket> buckets) {
+        const size_t uniqueHashCount = TDenseIndexHashView(buckets).CountNonEmptyBuckets();
+        TVector<TBucketGroup> groups(TBucketGroupIndexHashBuilder::GetProperGroupCount(uniqueHashCount));
+        TBucketGroupIndexHashBuilder builder(groups);
+        for (const auto& bucket : buckets) {
+            if (bucket.Hash != TBucket::InvalidHashValue) {
+                builder.SetIndex(bucket.Hash, bucket.IndexValue);
+            }
+        }
+        return groups;
+    }
+
+    TVector<TBucket> ConvertToLinearBuckets(TConstArrayRef<TBucketGroup> groups) {
+        const size_t uniqueHashCount = TBucketGroupIndexHashView(groups).CountNonEmptyBuckets();
+        TVector<TBucket> buckets(TDenseIndexHashBuilder::GetProperBucketsCount(uniqueHashCount));
+        TDenseIndexHashBuilder builder(buckets);
+        for (const auto& group : groups) {
+            for (size_t slot = 0; slot < TBucketGroup::Size; ++slot) {
+                if (group.Hashes[slot] != TBucket::InvalidHashValue) {
+                    builder.SetIndex(group.Hashes[slot], group.IndexValues[slot]);
+                }
+            }
+        }
+        return buckets;
+    }
+}
@@ -3,6 +3,9 @@
 #include <util/digest/numeric.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/algorithm.h>
+#include <util/generic/vector.h>
+#include <util/system/compiler.h>
+#include <util/system/yassert.h>
 
 namespace NCatboost {
 
@@ -54,6 +57,28 @@ namespace NCatboost {
             return NotFoundIndex;
         }
 
+        /**
+         * Batched GetIndex: indexes[i] = GetIndex(hashes[i]).
+         * Home buckets of lookups are prefetched PrefetchDistance lookups ahead, so cache misses of several
+         *  lookups overlap instead of being waited for one by one.
+         */
+        void GetIndexes(TConstArrayRef<ui64> hashes, TArrayRef<ui32> indexes) const {
+            Y_ASSERT(hashes.size() == indexes.size());
+            const size_t count = hashes.size();
+            const size_t prefetchEnd = Min(PrefetchDistance, count);
+            for (size_t i = 0; i < prefetchEnd; ++i) {
+                PrefetchHomeBucket(hashes[i]);
+            }
+            size_t i = 0;
+            for (; i + PrefetchDistance < count; ++i) {
+                PrefetchHomeBucket(hashes[i + PrefetchDistance]);
+                indexes[i] = GetIndex(hashes[i]);
+            }
+            for (; i < count; ++i) {
+                indexes[i] = GetIndex(hashes[i]);
+            }
+        }
+
         size_t CountNonEmptyBuckets() const {
             return CountIf(
                 Buckets,
@@ -64,6 +89,16 @@ namespace NCatboost {
             return Buckets;
         }
     private:
+        // buckets are packed, so the home bucket can cross cache line boundary
+        void PrefetchHomeBucket(ui64 hash) const {
+            const char* bucket = reinterpret_cast<const char*>(Buckets.data() + (hash & HashMask));
+            Y_PREFETCH_READ(bucket, 3);
+            Y_PREFETCH_READ(bucket + sizeof(TBucket) - 1, 3);
+        }
+
+    private:
+        static constexpr size_t PrefetchDistance = 16;
+
         ui64 HashMask = 0;
         TConstArrayRef<TBucket> Buckets;
     };
@@ -118,4 +153,138 @@ namespace NCatboost {
         ui32 BinCount = 0;
         TArrayRef<TBucket> Buckets;
     };
+
+    //! Buckets packed into one cache line: a lookup reads one cache line unless the home group is full
+    struct alignas(64) TBucketGroup {
+        static constexpr size_t Size = 5;
+
+    public:
+        TBucket::THashType Hashes[Size];
+        ui32 IndexValues[Size];
+        ui32 Padding;
+
+    public:
+        bool operator==(const TBucketGroup& other) const {
+            return std::equal(Hashes, Hashes + Size, other.Hashes)
+                && std::equal(IndexValues, IndexValues + Size, other.IndexValues);
+        }
+    };
+
+    // Alternative layout of [ui64] -> [ui32] index with linear probing over cache line sized groups of buckets.
+    // Groups are filled in slot order, so the first empty slot ends the probe sequence.
+    class TBucketGroupIndexHashView {
+    public:
+        static_assert(sizeof(TBucketGroup) == 64, "Expected sizeof(TBucketGroup) == 64 bytes");
+        static_assert(std::is_pod<TBucketGroup>::value, "must be pod");
+
+    public:
+        explicit TBucketGroupIndexHashView(TConstArrayRef<TBucketGroup> groupsRef)
+            : GroupMask(groupsRef.size() - 1)
+            , Groups(groupsRef)
+        {
+            Y_ENSURE(IsPowerOf2(groupsRef.size()), "Bucket group index must have 2^k groups");
+        }
+
+        size_t GetGroupCount() const {
+            return Groups.size();
+        }
+
+        ui32 GetIndex(ui64 hash) const {
+            for (ui64 groupIdx = hash & GroupMask;; groupIdx = (groupIdx + 1) & GroupMask) {
+                const TBucketGroup& group = Groups[groupIdx];
+                for (size_t slot = 0; slot < TBucketGroup::Size; ++slot) {
+                    if (group.Hashes[slot] == TBucket::InvalidHashValue) {
+                        return TDenseIndexHashView::NotFoundIndex;
+                    }
+                    if (group.Hashes[slot] == hash) {
+                        return group.IndexValues[slot];
+                    }
+                }
+            }
+        }
+
+        // same as TDenseIndexHashView::GetIndexes
+        void GetIndexes(TConstArrayRef<ui64> hashes, TArrayRef<ui32> indexes) const {
+            Y_ASSERT(hashes.size() == indexes.size());
+            const size_t count = hashes.size();
+            const size_t prefetchEnd = Min(PrefetchDistance, count);
+            for (size_t i = 0; i < prefetchEnd; ++i) {
+                Y_PREFETCH_READ(Groups.data() + (hashes[i] & GroupMask), 3);
+            }
+            size_t i = 0;
+            for (; i + PrefetchDistance < count; ++i) {
+                Y_PREFETCH_READ(Groups.data() + (hashes[i + PrefetchDistance] & GroupMask), 3);
+                indexes[i] = GetIndex(hashes[i]);
+            }
+            for (; i < count; ++i) {
+                indexes[i] = GetIndex(hashes[i]);
+            }
+        }
+
+        size_t CountNonEmptyBuckets() const {
+            size_t count = 0;
+            for (const auto& group : Groups) {
+                count += CountIf(
+                    group.Hashes,
+                    [](TBucket::THashType hash) { return hash != TBucket::InvalidHashValue; });
+            }
+            return count;
+        }
+
+        const TConstArrayRef<TBucketGroup> GetGroups() const {
+            return Groups;
+        }
+
+    private:
+        static constexpr size_t PrefetchDistance = 16;
+
+        ui64 GroupMask = 0;
+        TConstArrayRef<TBucketGroup> Groups;
+    };
+
+    class TBucketGroupIndexHashBuilder {
+    public:
+        explicit TBucketGroupIndexHashBuilder(TArrayRef<TBucketGroup> groupsRef)
+            : GroupMask(groupsRef.size() - 1)
+            , Groups(groupsRef)
+        {
+            Y_ENSURE(IsPowerOf2(groupsRef.size()), "Bucket group index must have 2^k groups");
+            TBucketGroup emptyGroup;
+            std::fill(std::begin(emptyGroup.Hashes), std::end(emptyGroup.Hashes), TBucket::InvalidHashValue);
+            std::fill(std::begin(emptyGroup.IndexValues), std::end(emptyGroup.IndexValues), 0);
+            emptyGroup.Padding = 0;
+            std::fill(groupsRef.begin(), groupsRef.end(), emptyGroup);
+        }
+
+        void SetIndex(ui64 hash, ui32 index) {
+            Y_ASSERT(hash != TBucket::InvalidHashValue);
+            for (ui64 groupIdx = hash & GroupMask;; groupIdx = (groupIdx + 1) & GroupMask) {
+                TBucketGroup& group = Groups[groupIdx];
+                for (size_t slot = 0; slot < TBucketGroup::Size; ++slot) {
+                    if (group.Hashes[slot] == TBucket::InvalidHashValue) {
+                        group.Hashes[slot] = hash;
+                        group.IndexValues[slot] = index;
+                        return;
+                    }
+                    if (group.Hashes[slot] == hash) {
+                        Y_ASSERT(group.IndexValues[slot] == index);
+                        return;
+                    }
+                }
+            }
+        }
+
+        static size_t GetProperGroupCount(size_t uniqueElementsCount, float loadFactor = 0.5f) {
+            const size_t minGroupCount = static_cast<size_t>(uniqueElementsCount / (TBucketGroup::Size * loadFactor)) + 1;
+            return FastClp2(minGroupCount);
+        }
+
+    private:
+        ui64 GroupMask = 0;
+        TArrayRef<TBucketGroup> Groups;
+    };
+
+    //! Converters between index layouts, indexes of all hashes are kept
+    TVector<TBucketGroup> ConvertToBucketGroups(TConstArrayRef<TBucket> buckets);
+    TVector<TBucket> ConvertToLinearBuckets(TConstArrayRef<TBucketGroup> groups);
 }
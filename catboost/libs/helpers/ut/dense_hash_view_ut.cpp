@@ -0,0 +1,84 @@
+#include <catboost/libs/helpers/dense_hash_view.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TDenseIndexHashViewTest) {
+    Y_UNIT_TEST(TestGetIndexes) {
+        const size_t uniqueHashCount = 1000;
+        TVector<NCatboost::TBucket> buckets(
+            NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(uniqueHashCount));
+        NCatboost::TDenseIndexHashBuilder builder(buckets);
+
+        TFastRng64 rng(0);
+        TVector<ui64> hashes;
+        for (auto i : xrange(uniqueHashCount)) {
+            Y_UNUSED(i);
+            hashes.push_back(rng.GenRand());
+            builder.AddIndex(hashes.back());
+        }
+        // lookups of missing hashes and of lookup counts not divisible by prefetch distance
+        for (auto i : xrange(uniqueHashCount / 3)) {
+            Y_UNUSED(i);
+            hashes.push_back(rng.GenRand());
+        }
+
+        NCatboost::TDenseIndexHashView view(buckets);
+        for (size_t count : {size_t(0), size_t(1), size_t(7), hashes.size()}) {
+            TVector<ui32> indexes(count);
+            view.GetIndexes(MakeArrayRef(hashes.data(), count), indexes);
+            for (auto i : xrange(count)) {
+                UNIT_ASSERT_VALUES_EQUAL(indexes[i], view.GetIndex(hashes[i]));
+            }
+        }
+        UNIT_ASSERT_VALUES_EQUAL(view.GetIndex(hashes[0]), 0u);
+        UNIT_ASSERT_VALUES_EQUAL(view.GetIndex(hashes[uniqueHashCount - 1]), uniqueHashCount - 1);
+    }
+
+    Y_UNIT_TEST(TestBucketGroupLayoutConversion) {
+        const size_t uniqueHashCount = 1000;
+        TVector<NCatboost::TBucket> buckets(
+            NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(uniqueHashCount));
+        NCatboost::TDenseIndexHashBuilder builder(buckets);
+
+        TFastRng64 rng(0);
+        TVector<ui64> hashes;
+        for (auto i : xrange(uniqueHashCount)) {
+            Y_UNUSED(i);
+            hashes.push_back(rng.GenRand());
+            builder.AddIndex(hashes.back());
+        }
+        // hashes with the same home group overflow it
+        for (auto i : xrange(3 * NCatboost::TBucketGroup::Size)) {
+            hashes.push_back((i + 1) << 32);
+            builder.AddIndex(hashes.back());
+        }
+        const size_t insertedHashCount = hashes.size();
+        for (auto i : xrange(uniqueHashCount / 3)) {
+            Y_UNUSED(i);
+            hashes.push_back(rng.GenRand());
+        }
+
+        const TVector<NCatboost::TBucketGroup> groups = NCatboost::ConvertToBucketGroups(buckets);
+        NCatboost::TDenseIndexHashView linearView(buckets);
+        NCatboost::TBucketGroupIndexHashView groupView(groups);
+        UNIT_ASSERT_VALUES_EQUAL(groupView.CountNonEmptyBuckets(), insertedHashCount);
+
+        TVector<ui32> indexes(hashes.size());
+        groupView.GetIndexes(hashes, indexes);
+        for (auto i : xrange(hashes.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(indexes[i], linearView.GetIndex(hashes[i]));
+            UNIT_ASSERT_VALUES_EQUAL(indexes[i], groupView.GetIndex(hashes[i]));
+        }
+
+        const TVector<NCatboost::TBucket> restoredBuckets = NCatboost::ConvertToLinearBuckets(groups);
+        NCatboost::TDenseIndexHashView restoredView(restoredBuckets);
+        for (auto hash : hashes) {
+            UNIT_ASSERT_VALUES_EQUAL(restoredView.GetIndex(hash), linearView.GetIndex(hash));
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#include <catboost/libs/model/evaluation_interface.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/generic/yexception.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/system/env.h>
+
+using namespace NCB::NModelEvaluation;
+
+namespace {
+    const size_t DocCount = 10000;
+    const size_t TreeDepth = 6;
+
+    struct TBenchmarkData {
+        TFullModel Model;
+        TVector<TVector<float>> Features;
+        TVector<TConstArrayRef<float>> FeatureRefs;
+        TVector<double> Predictions;
+
+    public:
+        TBenchmarkData(size_t featureCount, size_t bordersPerFeature, size_t treeCount = 1000) {
+            TFastRng64 rng(42);
+            TModelTrees* trees = Model.ModelTrees.GetMutable();
+            TVector<float> borders;
+            for (size_t borderId : xrange(bordersPerFeature)) {
+                borders.push_back((borderId + 1.0f) / (bordersPerFeature + 1.0f));
+            }
+            for (size_t featureId : xrange(featureCount)) {
+                trees->AddFloatFeature(TFloatFeature(false, featureId, featureId, borders, ""));
+            }
+            for (size_t treeId : xrange(treeCount)) {
+                Y_UNUSED(treeId);
+                TVector<int> tree;
+                for (size_t depth : xrange(TreeDepth)) {
+                    Y_UNUSED(depth);
+                    tree.push_back(rng.Uniform(featureCount * bordersPerFeature));
+                }
+                trees->AddBinTree(tree);
+                for (size_t leafId : xrange(1 << TreeDepth)) {
+                    Y_UNUSED(leafId);
+                    trees->AddLeafValue(rng.GenRandReal1());
+                }
+            }
+            Model.UpdateDynamicData();
+
+            Features.resize(DocCount);
+            for (auto& docFeatures : Features) {
+                for (size_t featureId : xrange(featureCount)) {
+                    Y_UNUSED(featureId);
+                    docFeatures.push_back(rng.GenRandReal1());
+                }
+                FeatureRefs.push_back(docFeatures);
+            }
+            Predictions.resize(DocCount);
+        }
+    };
+
+    // few features - binarized block is small even for large block sizes
+    struct TNarrowModelData : public TBenchmarkData {
+        TNarrowModelData()
+            : TBenchmarkData(50, 32)
+        {}
+    };
+
+    // thousands of binarized features per document - large blocks do not fit into L2
+    struct TWideModelData : public TBenchmarkData {
+        TWideModelData()
+            : TBenchmarkData(4000, 8)
+        {}
+    };
+
+    // leaf values of all trees don't fit into L2 cache
+    struct TManyTreesModelData : public TBenchmarkData {
+        TManyTreesModelData()
+            : TBenchmarkData(50, 32, 20000)
+        {}
+    };
+
+    /*
+     * Model trained on real data, e.g. epsilon8k_64.bin used in benchmarks/model_evaluation_speed.
+     * Path to the model in CatBoost binary format is taken from CB_BENCH_MODEL environment variable,
+     * documents are read from CB_BENCH_FEATURES tab separated file with float features in columns if it is set,
+     * otherwise each feature value is sampled uniformly from the bins of the feature.
+     * Benchmarks on the input model do nothing if CB_BENCH_MODEL is not set.
+     */
+    struct TInputModelData {
+        TFullModel Model;
+        TVector<TVector<float>> Features;
+        TVector<TConstArrayRef<float>> FeatureRefs;
+        TVector<double> Predictions;
+
+    public:
+        TInputModelData() {
+            const TString modelPath = GetEnv("CB_BENCH_MODEL");
+            if (modelPath.empty()) {
+                return;
+            }
+            Model = ReadModel(modelPath);
+            Y_ENSURE(
+                Model.GetUsedCatFeaturesCount() == 0 && Model.GetUsedTextFeaturesCount() == 0,
+                "Only models with float features are supported"
+            );
+            const size_t featureCount = Model.GetNumFloatFeatures();
+            const TString featuresPath = GetEnv("CB_BENCH_FEATURES");
+            if (featuresPath.empty()) {
+                TFastRng64 rng(42);
+                Features.resize(DocCount);
+                for (auto& docFeatures : Features) {
+                    docFeatures.resize(featureCount, 0.0f);
+                    for (const auto& feature : Model.ModelTrees->GetFloatFeatures()) {
+                        const auto& borders = feature.Borders;
+                        if (borders.empty()) {
+                            continue;
+                        }
+                        const size_t binId = rng.Uniform(borders.size() + 1);
+                        float value = 0.0f;
+                        if (binId == 0) {
+                            value = borders.front() - 1.0f;
+                        } else if (binId == borders.size()) {
+                            value = borders.back() + 1.0f;
+                        } else {
+                            value = (borders[binId - 1] + borders[binId]) / 2;
+                        }
+                        docFeatures[feature.Position.Index] = value;
+                    }
+                }
+            } else {
+                TFileInput input(featuresPath);
+                TString line;
+                while (input.ReadLine(line)) {
+                    TVector<float> docFeatures;
+                    for (const auto& value : StringSplitter(line).Split('\t')) {
+                        docFeatures.push_back(FromString<float>(value.Token()));
+                    }
+                    Y_ENSURE(
+                        docFeatures.size() >= featureCount,
+                        "Model has " << featureCount << " float features, got " << docFeatures.size()
+                        << " in line " << Features.size() + 1 << " of " << featuresPath
+                    );
+                    Features.push_back(std::move(docFeatures));
+                }
+            }
+            for (const auto& docFeatures : Features) {
+                FeatureRefs.push_back(docFeatures);
+            }
+            Predictions.resize(Features.size() * Model.GetDimensionsCount());
+        }
+    };
+
+    template <class TData>
+    void CalcWithProperty(TStringBuf propName, TStringBuf propValue, const NBench::NCpu::TParams& iface) {
+        auto& data = *Singleton<TData>();
+        if (data.FeatureRefs.empty()) {
+            return;
+        }
+        if (propName == "Precision" && propValue == "Float" && !data.Model.IsOblivious()) {
+            // fp32 evaluation is supported only for oblivious trees
+            return;
+        }
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, data.Model);
+        evaluator->SetProperty(propName, propValue);
+        for (const auto i : xrange(iface.Iterations())) {
+            Y_UNUSED(i);
+            evaluator->CalcFlat(data.FeatureRefs, data.Predictions);
+            Y_DO_NOT_OPTIMIZE_AWAY(data.Predictions.data());
+        }
+    }
+}
+
+#define BLOCK_SIZE_BENCHMARKS(dataType, name) \
+    Y_CPU_BENCHMARK(name##BlockSize16, iface) { CalcWithProperty<dataType>("BlockSize", "16", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize32, iface) { CalcWithProperty<dataType>("BlockSize", "32", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize64, iface) { CalcWithProperty<dataType>("BlockSize", "64", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize128, iface) { CalcWithProperty<dataType>("BlockSize", "128", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize256, iface) { CalcWithProperty<dataType>("BlockSize", "256", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize512, iface) { CalcWithProperty<dataType>("BlockSize", "512", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSize1024, iface) { CalcWithProperty<dataType>("BlockSize", "1024", iface); } \
+    Y_CPU_BENCHMARK(name##BlockSizeAuto, iface) { CalcWithProperty<dataType>("BlockSize", "Auto", iface); }
+
+BLOCK_SIZE_BENCHMARKS(TNarrowModelData, NarrowModel)
+BLOCK_SIZE_BENCHMARKS(TWideModelData, WideModel)
+BLOCK_SIZE_BENCHMARKS(TInputModelData, InputModel)
+
+Y_CPU_BENCHMARK(ManyTreesModelDocMajor, iface) { CalcWithProperty<TManyTreesModelData>("Schedule", "DocMajor", iface); }
+Y_CPU_BENCHMARK(ManyTreesModelTreeMajor, iface) { CalcWithProperty<TManyTreesModelData>("Schedule", "TreeMajor", iface); }
+Y_CPU_BENCHMARK(InputModelDocMajor, iface) { CalcWithProperty<TInputModelData>("Schedule", "DocMajor", iface); }
+Y_CPU_BENCHMARK(InputModelTreeMajor, iface) { CalcWithProperty<TInputModelData>("Schedule", "TreeMajor", iface); }
+
+Y_CPU_BENCHMARK(NarrowModelDoublePrecision, iface) { CalcWithProperty<TNarrowModelData>("Precision", "Double", iface); }
+Y_CPU_BENCHMARK(NarrowModelFloatPrecision, iface) { CalcWithProperty<TNarrowModelData>("Precision", "Float", iface); }
+Y_CPU_BENCHMARK(ManyTreesModelDoublePrecision, iface) { CalcWithProperty<TManyTreesModelData>("Precision", "Double", iface); }
+Y_CPU_BENCHMARK(ManyTreesModelFloatPrecision, iface) { CalcWithProperty<TManyTreesModelData>("Precision", "Float", iface); }
+Y_CPU_BENCHMARK(InputModelDoublePrecision, iface) { CalcWithProperty<TInputModelData>("Precision", "Double", iface); }
+Y_CPU_BENCHMARK(InputModelFloatPrecision, iface) { CalcWithProperty<TInputModelData>("Precision", "Float", iface); }
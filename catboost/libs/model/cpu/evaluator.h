@@ -2,6 +2,7 @@
 
 #include "quantization.h"
 
+#include <util/generic/maybe.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
 
@@ -29,10 +30,85 @@ namespace NCB::NModelEvaluation {
         double* __restrict results)>;
 
 
+    /**
+     * @param treeGroupSize if not 0, trees are evaluated in groups of this size: every group of trees goes through
+     *  all documents of the block before the next group (tree-major schedule). Ignored if calcIndexesOnly is set.
+     */
     TTreeCalcFunction GetCalcTreesFunction(
         const TModelTrees& trees,
         size_t docCountInBlock,
-        bool calcIndexesOnly = false);
+        bool calcIndexesOnly = false,
+        size_t treeGroupSize = 0);
+
+    /**
+     * Document block size for which binarized features of the block and leaf values of currently evaluated trees
+     * fit into CPU cache. Never exceeds FORMULA_EVALUATION_BLOCK_SIZE.
+     */
+    size_t GetCacheFriendlyBlockSize(const TModelTrees& trees);
+
+    /**
+     * Size of tree groups for tree-major schedule: leaf values of a group fit into a half of L2 cache.
+     * Returns 0 if leaf values of all trees fit there, so there is no need to split trees into groups.
+     */
+    size_t GetCacheFriendlyTreeGroupSize(const TModelTrees& trees);
+
+    /**
+     * Document block size for tree-major schedule: binarized features and approxes of the block stay in L2 cache
+     *  while all tree groups are evaluated. Never exceeds MAX_FORMULA_EVALUATION_BLOCK_SIZE.
+     */
+    size_t GetTreeMajorBlockSize(const TModelTrees& trees);
+
+    enum class EEvaluationSchedule {
+        //! Every sub-block of documents goes through all trees, good if leaf values of all trees fit into cache
+        DocMajor,
+        //! Trees are split into cache-sized groups, every group goes through several sub-blocks of documents,
+        //! so leaf values are loaded from memory once per big block instead of once per sub-block
+        TreeMajor
+    };
+
+    struct TEvaluationSchedule {
+        size_t BlockSize = FORMULA_EVALUATION_BLOCK_SIZE;
+        //! 0 for doc-major schedule
+        size_t TreeGroupSize = 0;
+        //! If not null, trees are evaluated in fp32 with these leaf values (see GetFloatCalcTreesFunction)
+        const float* FloatLeafValues = nullptr;
+    };
+
+    /**
+     * Choose evaluation schedule for docCount documents. If scheduleType is not defined, doc-major schedule is used,
+     *  tree-major schedule is chosen only on explicit request.
+     */
+    TEvaluationSchedule GetEvaluationSchedule(
+        const TModelTrees& trees,
+        size_t docCount,
+        TMaybe<EEvaluationSchedule> scheduleType = Nothing(),
+        TMaybe<size_t> blockSize = Nothing());
+
+    /**
+     * Leaf values of trees converted to float for fp32 evaluation, indexed the same way as TModelTrees::GetLeafValues.
+     */
+    TVector<float> ConvertLeafValuesToFloat(const TModelTrees& trees);
+
+    /**
+     * fp32 counterpart of GetCalcTreesFunction for oblivious trees: leaf values are taken from floatLeafValues
+     *  (must outlive returned function) and accumulated in fp32 for each block, block sums are added to results.
+     *  Deviation from double evaluation is bounded by GetFloatEvaluationMaxDeviation.
+     */
+    TTreeCalcFunction GetFloatCalcTreesFunction(
+        const TModelTrees& trees,
+        const float* floatLeafValues,
+        size_t treeGroupSize = 0);
+
+    /**
+     * Upper bound of absolute difference between raw formula values computed in fp32 and in double.
+     * With u = 2^-24 (float unit roundoff), n trees and M = sum of max |leaf value| of each tree
+     *  conversion of leaf values to float gives error of at most u * M, recursive summation of n floats
+     *  adds at most gamma(n - 1) * M, where gamma(k) = k * u / (1 - k * u) (Higham, "Accuracy and Stability of
+     *  Numerical Algorithms", 4.2). One more term covers addition of block sums to double results,
+     *  so the bound is gamma(n + 1) * M * |Scale| (plus n smallest subnormal floats for underflow in conversion).
+     * Returns infinity if (n + 1) * u >= 1.
+     */
+    double GetFloatEvaluationMaxDeviation(const TModelTrees& trees);
 
     template <class X>
     inline X* GetAligned(X* val) {
@@ -1,21 +1,43 @@
 #include "evaluator.h"
+#include "evaluator_simd.h"
+
+#include <catboost/libs/helpers/exception.h>
 
 #include <library/sse/sse.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/singleton.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
 #include <util/stream/format.h>
 #include <util/system/compiler.h>
+#include <util/system/cpu_id.h>
 
 #include <cstring>
 
+#if defined(_unix_)
+#include <unistd.h>
+#endif
+
 namespace NCB::NModelEvaluation {
 
     constexpr size_t SSE_BLOCK_SIZE = 16;
-    static_assert(SSE_BLOCK_SIZE * 8 == FORMULA_EVALUATION_BLOCK_SIZE);
+    // SSE implementation processes documents in sub-blocks of at most 8 SSE registers
+    constexpr size_t SSE_MAX_SUB_BLOCK_SIZE = SSE_BLOCK_SIZE * 8;
+    static_assert(SSE_MAX_SUB_BLOCK_SIZE == FORMULA_EVALUATION_BLOCK_SIZE);
+
+    // BinarizeFeatures lays out blocks larger than FORMULA_EVALUATION_BLOCK_SIZE as consecutive chunks of
+    // FORMULA_EVALUATION_BLOCK_SIZE documents, each chunk has its own [feature][document] layout
+    // with the chunk document count as a stride
+    static inline const ui8* GetChunkBinFeatures(const TCPUEvaluatorQuantizedData* quantizedData, size_t chunkStart) {
+        return quantizedData->QuantizedData.data()
+            + chunkStart / FORMULA_EVALUATION_BLOCK_SIZE * quantizedData->BlockStride;
+    }
 
     template <bool NeedXorMask, size_t START_BLOCK, typename TIndexType>
     Y_FORCE_INLINE void CalcIndexesBasic(
             const ui8* __restrict binFeatures,
+            size_t binFeaturesStride,
             size_t docCountInBlock,
             TIndexType* __restrict indexesVec,
             const TRepackedBin* __restrict treeSplitsCurPtr,
@@ -27,7 +49,7 @@ namespace NCB::NModelEvaluation {
             const ui8 borderVal = (ui8)(treeSplitsCurPtr[depth].SplitIdx);
 
             const auto featureId = treeSplitsCurPtr[depth].FeatureIndex;
-            const ui8* __restrict binFeaturePtr = &binFeatures[featureId * docCountInBlock];
+            const ui8* __restrict binFeaturePtr = &binFeatures[featureId * binFeaturesStride];
             const ui8 xorMask = treeSplitsCurPtr[depth].XorMask;
             if (NeedXorMask) {
                 Y_PREFETCH_READ(binFeaturePtr, 3);
@@ -52,11 +74,12 @@ namespace NCB::NModelEvaluation {
     template <bool NeedXorMask, size_t SSEBlockCount, int curTreeSize>
     Y_FORCE_INLINE void CalcIndexesSseDepthed(
             const ui8* __restrict binFeatures,
+            size_t binFeaturesStride,
             size_t docCountInBlock,
             ui8* __restrict indexesVec,
             const TRepackedBin* __restrict treeSplitsCurPtr) {
         if (SSEBlockCount == 0) {
-            CalcIndexesBasic<NeedXorMask, 0>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+            CalcIndexesBasic<NeedXorMask, 0>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
             return;
         }
     #define _mm_cmpge_epu8(a, b) _mm_cmpeq_epi8(_mm_max_epu8((a), (b)), (a))
@@ -74,7 +97,7 @@ namespace NCB::NModelEvaluation {
             __m128i v1 = _mm_setzero_si128();
             __m128i mask = _mm_set1_epi8(0x01);
             for (int depth = 0; depth < curTreeSize; ++depth) {
-                const ui8 *__restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock + SSE_BLOCK_SIZE * regId;
+                const ui8 *__restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * binFeaturesStride + SSE_BLOCK_SIZE * regId;
                 const __m128i borderValVec = _mm_set1_epi8(treeSplitsCurPtr[depth].SplitIdx);
                 if (!NeedXorMask) {
                     LOAD_16_DOC_HISTS(v0, binFeaturePtr);
@@ -98,7 +121,7 @@ namespace NCB::NModelEvaluation {
             }
         }
         if (SSEBlockCount != 8) {
-            CalcIndexesBasic<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+            CalcIndexesBasic<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
         }
     #undef _mm_cmpge_epu8
     #undef LOAD_16_DOC_HISTS
@@ -110,6 +133,7 @@ namespace NCB::NModelEvaluation {
     template <bool NeedXorMask, size_t SSEBlockCount>
     static void CalcIndexesSse(
         const ui8* __restrict binFeatures,
+        size_t binFeaturesStride,
         size_t docCountInBlock,
         ui8* __restrict indexesVec,
         const TRepackedBin* __restrict treeSplitsCurPtr,
@@ -117,28 +141,28 @@ namespace NCB::NModelEvaluation {
         switch (curTreeSize)
         {
         case 1:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 1>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 1>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 2:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 2>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 2>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 3:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 3>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 3>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 4:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 4>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 4>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 5:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 5>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 5>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 6:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 6>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 6>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 7:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 7>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 7>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         case 8:
-            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 8>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr);
+            CalcIndexesSseDepthed<NeedXorMask, SSEBlockCount, 8>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr);
             break;
         default:
             break;
@@ -254,6 +278,7 @@ namespace NCB::NModelEvaluation {
     Y_FORCE_INLINE void CalcTreesBlockedImpl(
         const TModelTrees& trees,
         const ui8* __restrict binFeatures,
+        const size_t binFeaturesStride,
         const size_t docCountInBlock,
         TCalcerIndexType* __restrict indexesVecUI32,
         size_t treeStart,
@@ -282,21 +307,22 @@ namespace NCB::NModelEvaluation {
                     resultsTmpArray.yresize(docCountInBlock * trees.GetDimensionsCount());
                     alignedResultsPtr = resultsTmpArray.data();
                 }
-                memset(alignedResultsPtr, 0, neededMemory);
+                // results of previous tree groups and sub-blocks are accumulated here
+                memcpy(alignedResultsPtr, resultsPtr, neededMemory);
             }
             auto treeEnd4 = treeStart + (((treeEnd - treeStart) | 0x3) ^ 0x3);
             for (size_t treeId = treeStart; treeId < treeEnd4; treeId += 4) {
                 memset(indexesVec, 0, sizeof(ui32) * docCountInBlock);
-                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec + docCountInBlock * 0,
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec + docCountInBlock * 0,
                                                            treeSplitsCurPtr, trees.GetTreeSizes()[treeId]);
                 treeSplitsCurPtr += trees.GetTreeSizes()[treeId];
-                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec + docCountInBlock * 1,
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec + docCountInBlock * 1,
                                                            treeSplitsCurPtr, trees.GetTreeSizes()[treeId + 1]);
                 treeSplitsCurPtr += trees.GetTreeSizes()[treeId + 1];
-                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec + docCountInBlock * 2,
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec + docCountInBlock * 2,
                                                            treeSplitsCurPtr, trees.GetTreeSizes()[treeId + 2]);
                 treeSplitsCurPtr += trees.GetTreeSizes()[treeId + 2];
-                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec + docCountInBlock * 3,
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec + docCountInBlock * 3,
                                                            treeSplitsCurPtr, trees.GetTreeSizes()[treeId + 3]);
                 treeSplitsCurPtr += trees.GetTreeSizes()[treeId + 3];
 
@@ -324,7 +350,7 @@ namespace NCB::NModelEvaluation {
             memset(indexesVec, 0, sizeof(ui32) * docCountInBlock);
 #ifdef _sse3_
             if (!CalcLeafIndexesOnly && curTreeSize <= 8) {
-                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr,
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, binFeaturesStride, docCountInBlock, indexesVec, treeSplitsCurPtr,
                                                            curTreeSize);
                 if (IsSingleClassModel) { // single class model
                     CalculateLeafValues(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, resultsPtr);
@@ -336,8 +362,8 @@ namespace NCB::NModelEvaluation {
 #else
             {
 #endif
-                CalcIndexesBasic<NeedXorMask, 0>(binFeatures, docCountInBlock, indexesVecUI32, treeSplitsCurPtr,
-                                                 curTreeSize);
+                CalcIndexesBasic<NeedXorMask, 0>(binFeatures, binFeaturesStride, docCountInBlock, indexesVecUI32,
+                                                 treeSplitsCurPtr, curTreeSize);
                 if constexpr (CalcLeafIndexesOnly) {
                     indexesVecUI32 += docCountInBlock;
                     indexesVec += sizeof(ui32) * docCountInBlock;
@@ -364,46 +390,63 @@ namespace NCB::NModelEvaluation {
         size_t treeStart,
         size_t treeEnd,
         double* __restrict resultsPtr) {
-        const ui8* __restrict binFeatures = quantizedData->QuantizedData.data();
-        switch (docCountInBlock / SSE_BLOCK_SIZE) {
-            case 0:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 1:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 2:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 3:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 4:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 5:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 6:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 7:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            case 8:
-                CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, CalcLeafIndexesOnly>(
-                    trees, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
-                break;
-            default:
-                Y_UNREACHABLE();
+        // leaf indexes are written in [treeId][docId] layout, so they can't be split into sub-blocks
+        Y_ASSERT(!CalcLeafIndexesOnly || docCountInBlock <= SSE_MAX_SUB_BLOCK_SIZE);
+        for (size_t subBlockStart = 0; subBlockStart < docCountInBlock; subBlockStart += SSE_MAX_SUB_BLOCK_SIZE) {
+            const size_t subBlockSize = Min(SSE_MAX_SUB_BLOCK_SIZE, docCountInBlock - subBlockStart);
+            const ui8* __restrict binFeatures = GetChunkBinFeatures(quantizedData, subBlockStart);
+            double* subBlockResultsPtr = CalcLeafIndexesOnly
+                ? resultsPtr
+                : resultsPtr + subBlockStart * trees.GetDimensionsCount();
+            switch (subBlockSize / SSE_BLOCK_SIZE) {
+                case 0:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 1:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 2:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 3:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 4:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 5:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 6:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 7:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                case 8:
+                    CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, CalcLeafIndexesOnly>(
+                        trees, binFeatures, subBlockSize, subBlockSize, indexesVec, treeStart, treeEnd,
+                        subBlockResultsPtr);
+                    break;
+                default:
+                    Y_UNREACHABLE();
+            }
         }
     }
 
@@ -776,16 +819,458 @@ namespace NCB::NModelEvaluation {
         }
     };
 
+    namespace {
+        struct TCpuCacheSizes {
+            size_t L1 = 32 * 1024;
+            size_t L2 = 256 * 1024;
+
+            TCpuCacheSizes() {
+            #if defined(_linux_) && defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+                const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+                if (l1 > 0) {
+                    L1 = l1;
+                }
+                const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+                if (l2 > 0) {
+                    L2 = l2;
+                }
+            #endif
+            }
+        };
+    }
+
+    size_t GetCacheFriendlyBlockSize(const TModelTrees& trees) {
+        const TCpuCacheSizes& cacheSizes = *Singleton<TCpuCacheSizes>();
+        // binarized features, leaf index and approx accumulator of each document in block
+        const size_t bytesPerDocument = trees.GetEffectiveBinaryFeaturesBucketsCount()
+            + sizeof(TCalcerIndexType)
+            + trees.GetDimensionsCount() * sizeof(double);
+        // leaf values of up to 4 trees are used simultaneously, we want them to stay in cache too
+        const size_t treeCount = Max<size_t>(trees.GetTreeCount(), 1);
+        const size_t leafValuesBytes = Min<size_t>(4, treeCount) * (trees.GetLeafValues().size() / treeCount) * sizeof(double);
+        // leave half of L2 for splits, ctr tables and hardware prefetcher
+        const size_t cacheBudget = cacheSizes.L2 / 2 > leafValuesBytes
+            ? cacheSizes.L2 / 2 - leafValuesBytes
+            : cacheSizes.L1;
+        const size_t blockSize = cacheBudget / bytesPerDocument / SSE_BLOCK_SIZE * SSE_BLOCK_SIZE;
+        return Max(SSE_BLOCK_SIZE, Min(FORMULA_EVALUATION_BLOCK_SIZE, blockSize));
+    }
+
+    size_t GetCacheFriendlyTreeGroupSize(const TModelTrees& trees) {
+        const TCpuCacheSizes& cacheSizes = *Singleton<TCpuCacheSizes>();
+        const size_t leafValuesBytes = trees.GetLeafValues().size() * sizeof(double);
+        const size_t leafValuesBudget = cacheSizes.L2 / 2;
+        if (trees.GetTreeCount() == 0 || leafValuesBytes <= leafValuesBudget) {
+            return 0;
+        }
+        const size_t bytesPerTree = CeilDiv(leafValuesBytes, trees.GetTreeCount());
+        // keep groups a multiple of 4 trees, blocked implementations evaluate 4 trees at once
+        return Max<size_t>(4, leafValuesBudget / bytesPerTree / 4 * 4);
+    }
+
+    size_t GetTreeMajorBlockSize(const TModelTrees& trees) {
+        const TCpuCacheSizes& cacheSizes = *Singleton<TCpuCacheSizes>();
+        const size_t bytesPerDocument = trees.GetEffectiveBinaryFeaturesBucketsCount()
+            + trees.GetDimensionsCount() * sizeof(double);
+        // the other half of L2 is for leaf values of a tree group
+        const size_t blockSize = cacheSizes.L2 / 2 / bytesPerDocument / SSE_MAX_SUB_BLOCK_SIZE * SSE_MAX_SUB_BLOCK_SIZE;
+        return Max(FORMULA_EVALUATION_BLOCK_SIZE, Min(MAX_FORMULA_EVALUATION_BLOCK_SIZE, blockSize));
+    }
+
+    TEvaluationSchedule GetEvaluationSchedule(
+        const TModelTrees& trees,
+        size_t docCount,
+        TMaybe<EEvaluationSchedule> scheduleType,
+        TMaybe<size_t> blockSize
+    ) {
+        Y_UNUSED(docCount);
+        TEvaluationSchedule schedule;
+        if (scheduleType.GetOrElse(EEvaluationSchedule::DocMajor) == EEvaluationSchedule::TreeMajor) {
+            schedule.BlockSize = blockSize.GetOrElse(GetTreeMajorBlockSize(trees));
+            schedule.TreeGroupSize = GetCacheFriendlyTreeGroupSize(trees);
+        } else {
+            schedule.BlockSize = blockSize.GetOrElse(GetCacheFriendlyBlockSize(trees));
+        }
+        return schedule;
+    }
+
+    static TCalcShallowTreesKernel GetWideSimdCalcShallowTreesKernel(bool needXorMask) {
+    #if defined(_x86_64_)
+        if (NX86::CachedHaveAVX512F() && NX86::CachedHaveAVX512BW()) {
+            if (auto kernel = GetCalcShallowTreesKernelAvx512(needXorMask)) {
+                return kernel;
+            }
+        }
+        if (NX86::CachedHaveAVX2()) {
+            return GetCalcShallowTreesKernelAvx2(needXorMask);
+        }
+    #else
+        Y_UNUSED(needXorMask);
+    #endif
+        return nullptr;
+    }
+
+    static TTreeCalcFunction MakeWideSimdCalcTreesFunction(
+        TCalcShallowTreesKernel kernel,
+        TTreeCalcFunction fallback
+    ) {
+        return [kernel, fallback = std::move(fallback)] (
+            const TModelTrees& trees,
+            const TCPUEvaluatorQuantizedData* quantizedData,
+            size_t docCountInBlock,
+            TCalcerIndexType* __restrict indexesVec,
+            size_t treeStart,
+            size_t treeEnd,
+            double* __restrict results
+        ) {
+            const auto treeSizes = trees.GetTreeSizes();
+            const bool allTreesAreShallow = AllOf(
+                treeSizes.begin() + treeStart,
+                treeSizes.begin() + treeEnd,
+                [](int depth) { return depth <= 8; }
+            );
+            if (!allTreesAreShallow) {
+                fallback(trees, quantizedData, docCountInBlock, indexesVec, treeStart, treeEnd, results);
+                return;
+            }
+            TObliviousTreesRawView treesView;
+            treesView.RepackedBins = trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
+            treesView.TreeSizes = treeSizes.data() + treeStart;
+            treesView.FirstLeafOffsets = trees.GetFirstLeafOffsets().data() + treeStart;
+            treesView.LeafValues = trees.GetLeafValues().data();
+            treesView.TreeCount = treeEnd - treeStart;
+            treesView.ApproxDimension = trees.GetDimensionsCount();
+            for (size_t chunkStart = 0; chunkStart < docCountInBlock; chunkStart += FORMULA_EVALUATION_BLOCK_SIZE) {
+                const size_t chunkDocCount = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCountInBlock - chunkStart);
+                kernel(
+                    treesView,
+                    GetChunkBinFeatures(quantizedData, chunkStart),
+                    chunkDocCount,
+                    reinterpret_cast<ui8*>(indexesVec),
+                    results + chunkStart * treesView.ApproxDimension
+                );
+            }
+        };
+    }
+
+    static TTreeCalcFunction MakeTreeMajorCalcTreesFunction(TTreeCalcFunction calcTrees, size_t treeGroupSize) {
+        return [calcTrees = std::move(calcTrees), treeGroupSize] (
+            const TModelTrees& trees,
+            const TCPUEvaluatorQuantizedData* quantizedData,
+            size_t docCountInBlock,
+            TCalcerIndexType* __restrict indexesVec,
+            size_t treeStart,
+            size_t treeEnd,
+            double* __restrict results
+        ) {
+            // approxes are accumulated tree by tree, so the order of summation for each document is the same
+            // as for doc-major schedule
+            for (size_t groupStart = treeStart; groupStart < treeEnd; groupStart += treeGroupSize) {
+                const size_t groupEnd = Min(treeEnd, groupStart + treeGroupSize);
+                calcTrees(trees, quantizedData, docCountInBlock, indexesVec, groupStart, groupEnd, results);
+            }
+        };
+    }
+
+    static TTreeCalcFunction MakeChunkedCalcTreesFunction(TTreeCalcFunction calcTrees) {
+        return [calcTrees = std::move(calcTrees)] (
+            const TModelTrees& trees,
+            const TCPUEvaluatorQuantizedData* quantizedData,
+            size_t docCountInBlock,
+            TCalcerIndexType* __restrict indexesVec,
+            size_t treeStart,
+            size_t treeEnd,
+            double* __restrict results
+        ) {
+            if (docCountInBlock <= FORMULA_EVALUATION_BLOCK_SIZE) {
+                calcTrees(trees, quantizedData, docCountInBlock, indexesVec, treeStart, treeEnd, results);
+                return;
+            }
+            for (size_t chunkStart = 0; chunkStart < docCountInBlock; chunkStart += FORMULA_EVALUATION_BLOCK_SIZE) {
+                const size_t chunkOffset = chunkStart / FORMULA_EVALUATION_BLOCK_SIZE * quantizedData->BlockStride;
+                TCPUEvaluatorQuantizedData chunkData;
+                chunkData.BlocksCount = 1;
+                chunkData.ObjectsCount = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCountInBlock - chunkStart);
+                chunkData.BlockStride = quantizedData->BlockStride;
+                chunkData.QuantizedData = quantizedData->QuantizedData.Slice(
+                    chunkOffset,
+                    Min(quantizedData->BlockStride, quantizedData->QuantizedData.GetSize() - chunkOffset)
+                );
+                calcTrees(
+                    trees,
+                    &chunkData,
+                    chunkData.ObjectsCount,
+                    indexesVec,
+                    treeStart,
+                    treeEnd,
+                    results + chunkStart * trees.GetDimensionsCount());
+            }
+        };
+    }
+
     TTreeCalcFunction GetCalcTreesFunction(
         const TModelTrees& trees,
         size_t docCountInBlock,
-        bool calcIndexesOnly
+        bool calcIndexesOnly,
+        size_t treeGroupSize
     ) {
         const bool areTreesOblivious = trees.IsOblivious();
         const bool isSingleDoc = (docCountInBlock == 1);
         const bool isSingleClassModel = (trees.GetDimensionsCount() == 1);
         const bool needXorMask = !trees.GetOneHotFeatures().empty();
-        return FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
+        auto calcTreesFunction = FunctorTemplateParamsSubstitutor<CalcTreeFunctionInstantiationGetter>::Call(
             areTreesOblivious, isSingleDoc, isSingleClassModel, needXorMask, calcIndexesOnly);
+        if (areTreesOblivious && !isSingleDoc && !calcIndexesOnly) {
+            // 256- and 512-bit kernels handle trees with depth <= 8, SSE implementation is kept as a fallback
+            if (auto wideSimdKernel = GetWideSimdCalcShallowTreesKernel(needXorMask)) {
+                calcTreesFunction = MakeWideSimdCalcTreesFunction(wideSimdKernel, std::move(calcTreesFunction));
+            }
+            if (treeGroupSize != 0 && treeGroupSize < trees.GetTreeCount()) {
+                calcTreesFunction = MakeTreeMajorCalcTreesFunction(std::move(calcTreesFunction), treeGroupSize);
+            }
+        } else if (!areTreesOblivious && !isSingleDoc && !calcIndexesOnly) {
+            // non-symmetric trees are evaluated with the chunk document count as a stride of binarized features
+            calcTreesFunction = MakeChunkedCalcTreesFunction(std::move(calcTreesFunction));
+        }
+        return calcTreesFunction;
+    }
+
+    TVector<float> ConvertLeafValuesToFloat(const TModelTrees& trees) {
+        const auto leafValues = trees.GetLeafValues();
+        TVector<float> floatLeafValues;
+        floatLeafValues.yresize(leafValues.size());
+        for (size_t leafId : xrange(leafValues.size())) {
+            CB_ENSURE(
+                !(Abs(leafValues[leafId]) > std::numeric_limits<float>::max()),
+                "Leaf value " << leafValues[leafId] << " is out of float range"
+            );
+            floatLeafValues[leafId] = leafValues[leafId];
+        }
+        return floatLeafValues;
+    }
+
+    template <typename TIndexType>
+    static void GatherAddFloatLeafs(
+        const float* __restrict leafValues,
+        const TIndexType* __restrict indexes,
+        size_t docCount,
+        float* __restrict accumulators
+    ) {
+        const size_t docCount4 = (docCount | 0x3) ^ 0x3;
+        for (size_t docId = 0; docId < docCount4; docId += 4) {
+            accumulators[docId + 0] += leafValues[indexes[docId + 0]];
+            accumulators[docId + 1] += leafValues[indexes[docId + 1]];
+            accumulators[docId + 2] += leafValues[indexes[docId + 2]];
+            accumulators[docId + 3] += leafValues[indexes[docId + 3]];
+        }
+        for (size_t docId = docCount4; docId < docCount; ++docId) {
+            accumulators[docId] += leafValues[indexes[docId]];
+        }
+    }
+
+    template <typename TIndexType>
+    static void GatherAddFloatLeafsMulti(
+        const float* __restrict leafValues,
+        const TIndexType* __restrict indexes,
+        size_t docCount,
+        size_t approxDimension,
+        float* __restrict accumulators
+    ) {
+        for (size_t docId = 0; docId < docCount; ++docId) {
+            const float* leafValuePtr = leafValues + indexes[docId] * approxDimension;
+            for (size_t classId = 0; classId < approxDimension; ++classId) {
+                accumulators[classId] += leafValuePtr[classId];
+            }
+            accumulators += approxDimension;
+        }
+    }
+
+    // leaf indexes are calculated the same way as in CalcTreesBlockedImpl, only leaf values accumulation differs
+    template <bool NeedXorMask, size_t SSEBlockCount>
+    static void CalcTreesFloatSubBlock(
+        const TModelTrees& trees,
+        const float* __restrict floatLeafValues,
+        TGatherAddFloatLeafsKernel gatherAddLeafs,
+        const ui8* __restrict binFeatures,
+        size_t binFeaturesStride,
+        size_t subBlockSize,
+        TCalcerIndexType* __restrict indexesVecUI32,
+        size_t treeStart,
+        size_t treeEnd,
+        float* __restrict accumulators
+    ) {
+        const size_t approxDimension = trees.GetDimensionsCount();
+        const auto treeSizes = trees.GetTreeSizes();
+        const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
+        const TRepackedBin* treeSplitsCurPtr =
+            trees.GetRepackedBins().data() + trees.GetTreeStartOffsets()[treeStart];
+        for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+            const int curTreeSize = treeSizes[treeId];
+            const float* treeLeafPtr = floatLeafValues + firstLeafOffsets[treeId];
+            memset(indexesVecUI32, 0, sizeof(TCalcerIndexType) * subBlockSize);
+    #ifdef _sse3_
+            if (curTreeSize <= 8) {
+                ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
+                CalcIndexesSse<NeedXorMask, SSEBlockCount>(
+                    binFeatures,
+                    binFeaturesStride,
+                    subBlockSize,
+                    indexesVec,
+                    treeSplitsCurPtr,
+                    curTreeSize);
+                if (approxDimension == 1) {
+                    gatherAddLeafs(treeLeafPtr, indexesVec, subBlockSize, accumulators);
+                } else {
+                    GatherAddFloatLeafsMulti(treeLeafPtr, indexesVec, subBlockSize, approxDimension, accumulators);
+                }
+                treeSplitsCurPtr += curTreeSize;
+                continue;
+            }
+    #endif
+            CalcIndexesBasic<NeedXorMask, 0>(
+                binFeatures,
+                binFeaturesStride,
+                subBlockSize,
+                indexesVecUI32,
+                treeSplitsCurPtr,
+                curTreeSize);
+            if (approxDimension == 1) {
+                GatherAddFloatLeafs(treeLeafPtr, indexesVecUI32, subBlockSize, accumulators);
+            } else {
+                GatherAddFloatLeafsMulti(treeLeafPtr, indexesVecUI32, subBlockSize, approxDimension, accumulators);
+            }
+            treeSplitsCurPtr += curTreeSize;
+        }
+    }
+
+    template <bool NeedXorMask>
+    static void CalcTreesFloatBlocked(
+        const TModelTrees& trees,
+        const float* __restrict floatLeafValues,
+        TGatherAddFloatLeafsKernel gatherAddLeafs,
+        const TCPUEvaluatorQuantizedData* quantizedData,
+        size_t docCountInBlock,
+        TCalcerIndexType* __restrict indexesVec,
+        size_t treeStart,
+        size_t treeEnd,
+        double* __restrict results
+    ) {
+        const size_t approxDimension = trees.GetDimensionsCount();
+        // single document evaluation doesn't allocate leaf indexes buffer
+        TCalcerIndexType singleDocIndex;
+        if (indexesVec == nullptr) {
+            Y_ASSERT(docCountInBlock == 1);
+            indexesVec = &singleDocIndex;
+        }
+        const size_t accumulatorsSize = Min(SSE_MAX_SUB_BLOCK_SIZE, docCountInBlock) * approxDimension;
+        TVector<float> accumulatorsHolder;
+        float* accumulators = nullptr;
+        if (accumulatorsSize * sizeof(float) < 2048) {
+            accumulators = (float*)alloca(accumulatorsSize * sizeof(float));
+        } else {
+            accumulatorsHolder.yresize(accumulatorsSize);
+            accumulators = accumulatorsHolder.data();
+        }
+        for (size_t subBlockStart = 0; subBlockStart < docCountInBlock; subBlockStart += SSE_MAX_SUB_BLOCK_SIZE) {
+            const size_t subBlockSize = Min(SSE_MAX_SUB_BLOCK_SIZE, docCountInBlock - subBlockStart);
+            std::fill(accumulators, accumulators + subBlockSize * approxDimension, 0.0f);
+            const ui8* __restrict binFeatures = GetChunkBinFeatures(quantizedData, subBlockStart);
+            const auto calcSubBlock = [&] (auto sseBlockCount) {
+                CalcTreesFloatSubBlock<NeedXorMask, decltype(sseBlockCount)::value>(
+                    trees,
+                    floatLeafValues,
+                    gatherAddLeafs,
+                    binFeatures,
+                    subBlockSize,
+                    subBlockSize,
+                    indexesVec,
+                    treeStart,
+                    treeEnd,
+                    accumulators);
+            };
+            switch (subBlockSize / SSE_BLOCK_SIZE) {
+                case 0: calcSubBlock(std::integral_constant<size_t, 0>()); break;
+                case 1: calcSubBlock(std::integral_constant<size_t, 1>()); break;
+                case 2: calcSubBlock(std::integral_constant<size_t, 2>()); break;
+                case 3: calcSubBlock(std::integral_constant<size_t, 3>()); break;
+                case 4: calcSubBlock(std::integral_constant<size_t, 4>()); break;
+                case 5: calcSubBlock(std::integral_constant<size_t, 5>()); break;
+                case 6: calcSubBlock(std::integral_constant<size_t, 6>()); break;
+                case 7: calcSubBlock(std::integral_constant<size_t, 7>()); break;
+                case 8: calcSubBlock(std::integral_constant<size_t, 8>()); break;
+                default:
+                    Y_UNREACHABLE();
+            }
+            double* subBlockResults = results + subBlockStart * approxDimension;
+            for (size_t resultId = 0; resultId < subBlockSize * approxDimension; ++resultId) {
+                subBlockResults[resultId] += accumulators[resultId];
+            }
+        }
+    }
+
+    TTreeCalcFunction GetFloatCalcTreesFunction(
+        const TModelTrees& trees,
+        const float* floatLeafValues,
+        size_t treeGroupSize
+    ) {
+        CB_ENSURE(trees.IsOblivious(), "fp32 evaluation is supported only for oblivious trees");
+        TGatherAddFloatLeafsKernel gatherAddLeafs = GatherAddFloatLeafs<ui8>;
+    #if defined(_x86_64_)
+        if (NX86::CachedHaveAVX2()) {
+            if (auto kernel = GetGatherAddFloatLeafsKernelAvx2()) {
+                gatherAddLeafs = kernel;
+            }
+        }
+    #endif
+        const auto calcTrees = trees.GetOneHotFeatures().empty()
+            ? CalcTreesFloatBlocked<false>
+            : CalcTreesFloatBlocked<true>;
+        TTreeCalcFunction calcTreesFunction = [calcTrees, floatLeafValues, gatherAddLeafs] (
+            const TModelTrees& trees,
+            const TCPUEvaluatorQuantizedData* quantizedData,
+            size_t docCountInBlock,
+            TCalcerIndexType* __restrict indexesVec,
+            size_t treeStart,
+            size_t treeEnd,
+            double* __restrict results
+        ) {
+            calcTrees(
+                trees,
+                floatLeafValues,
+                gatherAddLeafs,
+                quantizedData,
+                docCountInBlock,
+                indexesVec,
+                treeStart,
+                treeEnd,
+                results);
+        };
+        if (treeGroupSize != 0 && treeGroupSize < trees.GetTreeCount()) {
+            calcTreesFunction = MakeTreeMajorCalcTreesFunction(std::move(calcTreesFunction), treeGroupSize);
+        }
+        return calcTreesFunction;
+    }
+
+    double GetFloatEvaluationMaxDeviation(const TModelTrees& trees) {
+        const auto leafValues = trees.GetLeafValues();
+        const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
+        const size_t treeCount = trees.GetTreeCount();
+        double sumOfMaxAbsLeafValues = 0;
+        for (size_t treeId : xrange(treeCount)) {
+            const size_t leafEnd = treeId + 1 < treeCount ? firstLeafOffsets[treeId + 1] : leafValues.size();
+            double maxAbsLeafValue = 0;
+            for (size_t leafId = firstLeafOffsets[treeId]; leafId < leafEnd; ++leafId) {
+                maxAbsLeafValue = Max(maxAbsLeafValue, Abs(leafValues[leafId]));
+            }
+            sumOfMaxAbsLeafValues += maxAbsLeafValue;
+        }
+        const double unitRoundoff = std::numeric_limits<float>::epsilon() / 2;
+        const double termCount = treeCount + 1;
+        if (termCount * unitRoundoff >= 1) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const double gamma = termCount * unitRoundoff / (1 - termCount * unitRoundoff);
+        const double underflowError = treeCount * (double)std::numeric_limits<float>::denorm_min();
+        return (gamma * sumOfMaxAbsLeafValues + underflowError) * Abs(trees.GetScaleAndBias().Scale);
     }
 }
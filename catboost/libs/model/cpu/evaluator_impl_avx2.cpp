@@ -0,0 +1,293 @@
+#include "evaluator_simd.h"
+
+#include <util/system/yassert.h>
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace NCB::NModelEvaluation {
+
+#if defined(__AVX2__)
+
+    namespace {
+        constexpr size_t AVX2_BLOCK_SIZE = 32;
+
+        template <bool NeedXorMask>
+        inline void CalcIndexesScalarTail(
+            const ui8* __restrict binFeatures,
+            size_t firstDocId,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            const TRepackedBin* __restrict treeSplitsCurPtr,
+            int curTreeSize
+        ) {
+            for (size_t docId = firstDocId; docId < docCountInBlock; ++docId) {
+                ui8 index = 0;
+                for (int depth = 0; depth < curTreeSize; ++depth) {
+                    ui8 featureValue = binFeatures[treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock + docId];
+                    if constexpr (NeedXorMask) {
+                        featureValue ^= treeSplitsCurPtr[depth].XorMask;
+                    }
+                    index |= (featureValue >= treeSplitsCurPtr[depth].SplitIdx) << depth;
+                }
+                indexesVec[docId] = index;
+            }
+        }
+
+        inline __m256i CmpGeEpu8(__m256i a, __m256i b) {
+            return _mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a);
+        }
+
+        template <bool NeedXorMask>
+        inline __m256i LoadBins(const ui8* __restrict binFeaturePtr, __m256i xorMaskVec) {
+            const __m256i val = _mm256_loadu_si256((const __m256i*)binFeaturePtr);
+            if constexpr (NeedXorMask) {
+                return _mm256_xor_si256(val, xorMaskVec);
+            } else {
+                return val;
+            }
+        }
+
+        template <bool NeedXorMask, int CurTreeSize>
+        inline void CalcIndexesAvx2Depthed(
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            const TRepackedBin* __restrict treeSplitsCurPtr
+        ) {
+            size_t docId = 0;
+            for (; docId + 2 * AVX2_BLOCK_SIZE <= docCountInBlock; docId += 2 * AVX2_BLOCK_SIZE) {
+                __m256i v0 = _mm256_setzero_si256();
+                __m256i v1 = _mm256_setzero_si256();
+                __m256i mask = _mm256_set1_epi8(0x01);
+                for (int depth = 0; depth < CurTreeSize; ++depth) {
+                    const ui8* __restrict binFeaturePtr =
+                        binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock + docId;
+                    const __m256i borderValVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].SplitIdx);
+                    const __m256i xorMaskVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].XorMask);
+                    const __m256i val0 = LoadBins<NeedXorMask>(binFeaturePtr, xorMaskVec);
+                    const __m256i val1 = LoadBins<NeedXorMask>(binFeaturePtr + AVX2_BLOCK_SIZE, xorMaskVec);
+                    v0 = _mm256_or_si256(v0, _mm256_and_si256(CmpGeEpu8(val0, borderValVec), mask));
+                    v1 = _mm256_or_si256(v1, _mm256_and_si256(CmpGeEpu8(val1, borderValVec), mask));
+                    mask = _mm256_add_epi8(mask, mask);
+                }
+                _mm256_storeu_si256((__m256i*)(indexesVec + docId), v0);
+                _mm256_storeu_si256((__m256i*)(indexesVec + docId + AVX2_BLOCK_SIZE), v1);
+            }
+            for (; docId + AVX2_BLOCK_SIZE <= docCountInBlock; docId += AVX2_BLOCK_SIZE) {
+                __m256i v0 = _mm256_setzero_si256();
+                __m256i mask = _mm256_set1_epi8(0x01);
+                for (int depth = 0; depth < CurTreeSize; ++depth) {
+                    const ui8* __restrict binFeaturePtr =
+                        binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock + docId;
+                    const __m256i borderValVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].SplitIdx);
+                    const __m256i xorMaskVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].XorMask);
+                    const __m256i val0 = LoadBins<NeedXorMask>(binFeaturePtr, xorMaskVec);
+                    v0 = _mm256_or_si256(v0, _mm256_and_si256(CmpGeEpu8(val0, borderValVec), mask));
+                    mask = _mm256_add_epi8(mask, mask);
+                }
+                _mm256_storeu_si256((__m256i*)(indexesVec + docId), v0);
+            }
+            CalcIndexesScalarTail<NeedXorMask>(
+                binFeatures, docId, docCountInBlock, indexesVec, treeSplitsCurPtr, CurTreeSize);
+        }
+
+        template <bool NeedXorMask>
+        void CalcIndexesAvx2(
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            const TRepackedBin* __restrict treeSplitsCurPtr,
+            int curTreeSize
+        ) {
+            switch (curTreeSize) {
+                case 0:
+                    std::memset(indexesVec, 0, docCountInBlock);
+                    break;
+            #define CASE_DEPTH(depth) \
+                case depth: \
+                    CalcIndexesAvx2Depthed<NeedXorMask, depth>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr); \
+                    break;
+                CASE_DEPTH(1)
+                CASE_DEPTH(2)
+                CASE_DEPTH(3)
+                CASE_DEPTH(4)
+                CASE_DEPTH(5)
+                CASE_DEPTH(6)
+                CASE_DEPTH(7)
+                CASE_DEPTH(8)
+            #undef CASE_DEPTH
+                default:
+                    Y_UNREACHABLE();
+            }
+        }
+
+        inline __m128i LoadIndexes4(const ui8* __restrict indexesPtr) {
+            i32 packed;
+            std::memcpy(&packed, indexesPtr, sizeof(packed));
+            return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+        }
+
+        inline void GatherAddLeafs4Avx2(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr0,
+            const double* __restrict treeLeafPtr1,
+            const double* __restrict treeLeafPtr2,
+            const double* __restrict treeLeafPtr3,
+            const ui8* __restrict indexesPtr0,
+            const ui8* __restrict indexesPtr1,
+            const ui8* __restrict indexesPtr2,
+            const ui8* __restrict indexesPtr3,
+            double* __restrict writePtr
+        ) {
+            size_t docId = 0;
+            // keep summation order the same as in scalar and SSE code for bitwise equal results
+            for (; docId + 4 <= docCountInBlock; docId += 4) {
+                __m256d sum = _mm256_loadu_pd(writePtr + docId);
+                sum = _mm256_add_pd(sum, _mm256_i32gather_pd(treeLeafPtr0, LoadIndexes4(indexesPtr0 + docId), 8));
+                sum = _mm256_add_pd(sum, _mm256_i32gather_pd(treeLeafPtr1, LoadIndexes4(indexesPtr1 + docId), 8));
+                sum = _mm256_add_pd(sum, _mm256_i32gather_pd(treeLeafPtr2, LoadIndexes4(indexesPtr2 + docId), 8));
+                sum = _mm256_add_pd(sum, _mm256_i32gather_pd(treeLeafPtr3, LoadIndexes4(indexesPtr3 + docId), 8));
+                _mm256_storeu_pd(writePtr + docId, sum);
+            }
+            for (; docId < docCountInBlock; ++docId) {
+                writePtr[docId] = writePtr[docId]
+                    + treeLeafPtr0[indexesPtr0[docId]]
+                    + treeLeafPtr1[indexesPtr1[docId]]
+                    + treeLeafPtr2[indexesPtr2[docId]]
+                    + treeLeafPtr3[indexesPtr3[docId]];
+            }
+        }
+
+        inline void GatherAddLeafsAvx2(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr,
+            const ui8* __restrict indexesPtr,
+            double* __restrict writePtr
+        ) {
+            size_t docId = 0;
+            for (; docId + 4 <= docCountInBlock; docId += 4) {
+                const __m256d additions = _mm256_i32gather_pd(treeLeafPtr, LoadIndexes4(indexesPtr + docId), 8);
+                _mm256_storeu_pd(writePtr + docId, _mm256_add_pd(_mm256_loadu_pd(writePtr + docId), additions));
+            }
+            for (; docId < docCountInBlock; ++docId) {
+                writePtr[docId] += treeLeafPtr[indexesPtr[docId]];
+            }
+        }
+
+        inline void AddLeafsMulti(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr,
+            const ui8* __restrict indexesPtr,
+            size_t approxDimension,
+            double* __restrict writePtr
+        ) {
+            for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+                const double* leafValuePtr = treeLeafPtr + indexesPtr[docId] * approxDimension;
+                for (size_t classId = 0; classId < approxDimension; ++classId) {
+                    writePtr[classId] += leafValuePtr[classId];
+                }
+                writePtr += approxDimension;
+            }
+        }
+
+        void GatherAddFloatLeafsAvx2(
+            const float* __restrict leafValues,
+            const ui8* __restrict indexes,
+            size_t docCount,
+            float* __restrict accumulators
+        ) {
+            size_t docId = 0;
+            for (; docId + 8 <= docCount; docId += 8) {
+                const __m256i indexesVec = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(indexes + docId)));
+                const __m256 additions = _mm256_i32gather_ps(leafValues, indexesVec, 4);
+                _mm256_storeu_ps(accumulators + docId, _mm256_add_ps(_mm256_loadu_ps(accumulators + docId), additions));
+            }
+            for (; docId < docCount; ++docId) {
+                accumulators[docId] += leafValues[indexes[docId]];
+            }
+        }
+
+        template <bool NeedXorMask>
+        void CalcShallowTreesAvx2(
+            const TObliviousTreesRawView& trees,
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            double* __restrict results
+        ) {
+            const TRepackedBin* treeSplitsCurPtr = trees.RepackedBins;
+            const double* leafValues = trees.LeafValues;
+            const size_t* firstLeafOffsets = trees.FirstLeafOffsets;
+            size_t treeId = 0;
+            if (trees.ApproxDimension == 1) {
+                for (; treeId + 4 <= trees.TreeCount; treeId += 4) {
+                    for (size_t subTreeId = 0; subTreeId < 4; ++subTreeId) {
+                        const int curTreeSize = trees.TreeSizes[treeId + subTreeId];
+                        CalcIndexesAvx2<NeedXorMask>(
+                            binFeatures,
+                            docCountInBlock,
+                            indexesVec + docCountInBlock * subTreeId,
+                            treeSplitsCurPtr,
+                            curTreeSize);
+                        treeSplitsCurPtr += curTreeSize;
+                    }
+                    GatherAddLeafs4Avx2(
+                        docCountInBlock,
+                        leafValues + firstLeafOffsets[treeId + 0],
+                        leafValues + firstLeafOffsets[treeId + 1],
+                        leafValues + firstLeafOffsets[treeId + 2],
+                        leafValues + firstLeafOffsets[treeId + 3],
+                        indexesVec + docCountInBlock * 0,
+                        indexesVec + docCountInBlock * 1,
+                        indexesVec + docCountInBlock * 2,
+                        indexesVec + docCountInBlock * 3,
+                        results);
+                }
+            }
+            for (; treeId < trees.TreeCount; ++treeId) {
+                const int curTreeSize = trees.TreeSizes[treeId];
+                CalcIndexesAvx2<NeedXorMask>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+                treeSplitsCurPtr += curTreeSize;
+                if (trees.ApproxDimension == 1) {
+                    GatherAddLeafsAvx2(docCountInBlock, leafValues + firstLeafOffsets[treeId], indexesVec, results);
+                } else {
+                    AddLeafsMulti(
+                        docCountInBlock,
+                        leafValues + firstLeafOffsets[treeId],
+                        indexesVec,
+                        trees.ApproxDimension,
+                        results);
+                }
+            }
+        }
+    }
+
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx2(bool needXorMask) {
+        if (needXorMask) {
+            return CalcShallowTreesAvx2<true>;
+        } else {
+            return CalcShallowTreesAvx2<false>;
+        }
+    }
+
+    TGatherAddFloatLeafsKernel GetGatherAddFloatLeafsKernelAvx2() {
+        return GatherAddFloatLeafsAvx2;
+    }
+
+#else
+
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx2(bool) {
+        return nullptr;
+    }
+
+    TGatherAddFloatLeafsKernel GetGatherAddFloatLeafsKernelAvx2() {
+        return nullptr;
+    }
+
+#endif
+
+}
@@ -0,0 +1,218 @@
+#include "evaluator_simd.h"
+
+#include <util/system/yassert.h>
+
+#include <cstring>
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+namespace NCB::NModelEvaluation {
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+
+    namespace {
+        constexpr size_t AVX512_BLOCK_SIZE = 64;
+
+        template <bool NeedXorMask, int CurTreeSize>
+        inline void CalcIndexesAvx512Depthed(
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            const TRepackedBin* __restrict treeSplitsCurPtr
+        ) {
+            // tail documents are processed with masked loads and stores, so there is no scalar loop here
+            for (size_t docId = 0; docId < docCountInBlock; docId += AVX512_BLOCK_SIZE) {
+                const size_t docCountLeft = docCountInBlock - docId;
+                const __mmask64 loadMask = docCountLeft >= AVX512_BLOCK_SIZE
+                    ? ~__mmask64(0)
+                    : (__mmask64(1) << docCountLeft) - 1;
+                __m512i v0 = _mm512_setzero_si512();
+                __m512i bit = _mm512_set1_epi8(0x01);
+                for (int depth = 0; depth < CurTreeSize; ++depth) {
+                    const ui8* __restrict binFeaturePtr =
+                        binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock + docId;
+                    __m512i val = _mm512_maskz_loadu_epi8(loadMask, binFeaturePtr);
+                    if constexpr (NeedXorMask) {
+                        val = _mm512_xor_si512(val, _mm512_set1_epi8(treeSplitsCurPtr[depth].XorMask));
+                    }
+                    const __mmask64 isGreaterOrEqual = _mm512_cmpge_epu8_mask(
+                        val,
+                        _mm512_set1_epi8(treeSplitsCurPtr[depth].SplitIdx));
+                    v0 = _mm512_or_si512(v0, _mm512_maskz_mov_epi8(isGreaterOrEqual, bit));
+                    bit = _mm512_add_epi8(bit, bit);
+                }
+                _mm512_mask_storeu_epi8(indexesVec + docId, loadMask, v0);
+            }
+        }
+
+        template <bool NeedXorMask>
+        void CalcIndexesAvx512(
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            const TRepackedBin* __restrict treeSplitsCurPtr,
+            int curTreeSize
+        ) {
+            switch (curTreeSize) {
+                case 0:
+                    std::memset(indexesVec, 0, docCountInBlock);
+                    break;
+            #define CASE_DEPTH(depth) \
+                case depth: \
+                    CalcIndexesAvx512Depthed<NeedXorMask, depth>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr); \
+                    break;
+                CASE_DEPTH(1)
+                CASE_DEPTH(2)
+                CASE_DEPTH(3)
+                CASE_DEPTH(4)
+                CASE_DEPTH(5)
+                CASE_DEPTH(6)
+                CASE_DEPTH(7)
+                CASE_DEPTH(8)
+            #undef CASE_DEPTH
+                default:
+                    Y_UNREACHABLE();
+            }
+        }
+
+        inline __m256i LoadIndexes8(const ui8* __restrict indexesPtr) {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)indexesPtr));
+        }
+
+        inline void GatherAddLeafs4Avx512(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr0,
+            const double* __restrict treeLeafPtr1,
+            const double* __restrict treeLeafPtr2,
+            const double* __restrict treeLeafPtr3,
+            const ui8* __restrict indexesPtr0,
+            const ui8* __restrict indexesPtr1,
+            const ui8* __restrict indexesPtr2,
+            const ui8* __restrict indexesPtr3,
+            double* __restrict writePtr
+        ) {
+            size_t docId = 0;
+            // keep summation order the same as in scalar and SSE code for bitwise equal results
+            for (; docId + 8 <= docCountInBlock; docId += 8) {
+                __m512d sum = _mm512_loadu_pd(writePtr + docId);
+                sum = _mm512_add_pd(sum, _mm512_i32gather_pd(LoadIndexes8(indexesPtr0 + docId), treeLeafPtr0, 8));
+                sum = _mm512_add_pd(sum, _mm512_i32gather_pd(LoadIndexes8(indexesPtr1 + docId), treeLeafPtr1, 8));
+                sum = _mm512_add_pd(sum, _mm512_i32gather_pd(LoadIndexes8(indexesPtr2 + docId), treeLeafPtr2, 8));
+                sum = _mm512_add_pd(sum, _mm512_i32gather_pd(LoadIndexes8(indexesPtr3 + docId), treeLeafPtr3, 8));
+                _mm512_storeu_pd(writePtr + docId, sum);
+            }
+            for (; docId < docCountInBlock; ++docId) {
+                writePtr[docId] = writePtr[docId]
+                    + treeLeafPtr0[indexesPtr0[docId]]
+                    + treeLeafPtr1[indexesPtr1[docId]]
+                    + treeLeafPtr2[indexesPtr2[docId]]
+                    + treeLeafPtr3[indexesPtr3[docId]];
+            }
+        }
+
+        inline void GatherAddLeafsAvx512(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr,
+            const ui8* __restrict indexesPtr,
+            double* __restrict writePtr
+        ) {
+            size_t docId = 0;
+            for (; docId + 8 <= docCountInBlock; docId += 8) {
+                const __m512d additions = _mm512_i32gather_pd(LoadIndexes8(indexesPtr + docId), treeLeafPtr, 8);
+                _mm512_storeu_pd(writePtr + docId, _mm512_add_pd(_mm512_loadu_pd(writePtr + docId), additions));
+            }
+            for (; docId < docCountInBlock; ++docId) {
+                writePtr[docId] += treeLeafPtr[indexesPtr[docId]];
+            }
+        }
+
+        inline void AddLeafsMulti(
+            size_t docCountInBlock,
+            const double* __restrict treeLeafPtr,
+            const ui8* __restrict indexesPtr,
+            size_t approxDimension,
+            double* __restrict writePtr
+        ) {
+            for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+                const double* leafValuePtr = treeLeafPtr + indexesPtr[docId] * approxDimension;
+                for (size_t classId = 0; classId < approxDimension; ++classId) {
+                    writePtr[classId] += leafValuePtr[classId];
+                }
+                writePtr += approxDimension;
+            }
+        }
+
+        template <bool NeedXorMask>
+        void CalcShallowTreesAvx512(
+            const TObliviousTreesRawView& trees,
+            const ui8* __restrict binFeatures,
+            size_t docCountInBlock,
+            ui8* __restrict indexesVec,
+            double* __restrict results
+        ) {
+            const TRepackedBin* treeSplitsCurPtr = trees.RepackedBins;
+            const double* leafValues = trees.LeafValues;
+            const size_t* firstLeafOffsets = trees.FirstLeafOffsets;
+            size_t treeId = 0;
+            if (trees.ApproxDimension == 1) {
+                for (; treeId + 4 <= trees.TreeCount; treeId += 4) {
+                    for (size_t subTreeId = 0; subTreeId < 4; ++subTreeId) {
+                        const int curTreeSize = trees.TreeSizes[treeId + subTreeId];
+                        CalcIndexesAvx512<NeedXorMask>(
+                            binFeatures,
+                            docCountInBlock,
+                            indexesVec + docCountInBlock * subTreeId,
+                            treeSplitsCurPtr,
+                            curTreeSize);
+                        treeSplitsCurPtr += curTreeSize;
+                    }
+                    GatherAddLeafs4Avx512(
+                        docCountInBlock,
+                        leafValues + firstLeafOffsets[treeId + 0],
+                        leafValues + firstLeafOffsets[treeId + 1],
+                        leafValues + firstLeafOffsets[treeId + 2],
+                        leafValues + firstLeafOffsets[treeId + 3],
+                        indexesVec + docCountInBlock * 0,
+                        indexesVec + docCountInBlock * 1,
+                        indexesVec + docCountInBlock * 2,
+                        indexesVec + docCountInBlock * 3,
+                        results);
+                }
+            }
+            for (; treeId < trees.TreeCount; ++treeId) {
+                const int curTreeSize = trees.TreeSizes[treeId];
+                CalcIndexesAvx512<NeedXorMask>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+                treeSplitsCurPtr += curTreeSize;
+                if (trees.ApproxDimension == 1) {
+                    GatherAddLeafsAvx512(docCountInBlock, leafValues + firstLeafOffsets[treeId], indexesVec, results);
+                } else {
+                    AddLeafsMulti(
+                        docCountInBlock,
+                        leafValues + firstLeafOffsets[treeId],
+                        indexesVec,
+                        trees.ApproxDimension,
+                        results);
+                }
+            }
+        }
+    }
+
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx512(bool needXorMask) {
+        if (needXorMask) {
+            return CalcShallowTreesAvx512<true>;
+        } else {
+            return CalcShallowTreesAvx512<false>;
+        }
+    }
+
+#else
+
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx512(bool) {
+        return nullptr;
+    }
+
+#endif
+
+}
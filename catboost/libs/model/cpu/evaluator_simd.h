@@ -0,0 +1,56 @@
+#pragma once
+
+#include <catboost/libs/model/repacked_bin.h>
+
+#include <util/system/types.h>
+
+#include <cstddef>
+
+namespace NCB::NModelEvaluation {
+
+    /**
+     * Plain pointer view of a range of oblivious trees.
+     * Wide SIMD kernels are compiled in separate translation units with extended instruction sets (see ya.make),
+     * so they must not instantiate any inline code shared with the rest of the library - we pass them raw data only.
+     */
+    struct TObliviousTreesRawView {
+        //! Splits of the first tree in range, subsequent trees follow each other
+        const TRepackedBin* RepackedBins = nullptr;
+        const int* TreeSizes = nullptr;
+        const size_t* FirstLeafOffsets = nullptr;
+        const double* LeafValues = nullptr;
+        size_t TreeCount = 0;
+        size_t ApproxDimension = 1;
+    };
+
+    /**
+     * Accumulates leaf values of all trees from `trees` into `results` for docCountInBlock documents.
+     * All trees must have depth <= 8. `indexesVec` is scratch space of at least 4 * docCountInBlock bytes.
+     */
+    using TCalcShallowTreesKernel = void (*)(
+        const TObliviousTreesRawView& trees,
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        ui8* __restrict indexesVec,
+        double* __restrict results);
+
+    /**
+     * Adds leafValues[indexes[docId]] to accumulators[docId] for docCount documents, used by fp32 evaluation
+     * of trees with depth <= 8.
+     */
+    using TGatherAddFloatLeafsKernel = void (*)(
+        const float* __restrict leafValues,
+        const ui8* __restrict indexes,
+        size_t docCount,
+        float* __restrict accumulators);
+
+    // Kernel getters return nullptr if the library was built without support of corresponding instruction set.
+    // Caller is responsible for checking CPU capabilities before running returned kernel.
+
+    // defined in evaluator_impl_avx2.cpp
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx2(bool needXorMask);
+    TGatherAddFloatLeafsKernel GetGatherAddFloatLeafsKernelAvx2();
+
+    // defined in evaluator_impl_avx512.cpp
+    TCalcShallowTreesKernel GetCalcShallowTreesKernelAvx512(bool needXorMask);
+}
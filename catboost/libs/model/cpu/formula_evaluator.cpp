@@ -3,10 +3,16 @@
 
 #include "evaluator.h"
 
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/ymath.h>
+#include <util/string/cast.h>
+
 namespace NCB::NModelEvaluation {
     namespace NDetail {
         template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
-        inline void CalcGeneric(
+        inline void CalcGenericSequential(
             const TModelTrees& trees,
             const TIntrusivePtr<ICtrProvider>& ctrProvider,
             const TIntrusivePtr<TTextProcessingCollection>& textProcessingCollection,
@@ -14,14 +20,17 @@ namespace NCB::NModelEvaluation {
             TCatFeatureAccessor catFeaturesAccessor,
             TTextFeatureAccessor textFeatureAccessor,
             size_t docCount,
+            const TEvaluationSchedule& schedule,
             size_t treeStart,
             size_t treeEnd,
             EPredictionType predictionType,
             TArrayRef<double> results,
             const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr
         ) {
-            const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
-            auto calcTrees = GetCalcTreesFunction(trees, blockSize);
+            const size_t blockSize = Min(schedule.BlockSize, docCount);
+            auto calcTrees = schedule.FloatLeafValues
+                ? GetFloatCalcTreesFunction(trees, schedule.FloatLeafValues, schedule.TreeGroupSize)
+                : GetCalcTreesFunction(trees, blockSize, /*calcIndexesOnly*/ false, schedule.TreeGroupSize);
             if (trees.GetTreeCount() == 0) {
                 Fill(results.begin(), results.end(), trees.GetScaleAndBias().Bias);
                 return;
@@ -64,6 +73,90 @@ namespace NCB::NModelEvaluation {
             );
         }
 
+        //! Number of document chunks for parallel evaluation, chunks are aligned to evaluation blocks
+        inline size_t GetParallelChunkCount(
+            const NPar::TLocalExecutor* localExecutor,
+            size_t docCount,
+            size_t blockSize
+        ) {
+            if (!localExecutor || localExecutor->GetThreadCount() == 0 || docCount < 2 * blockSize) {
+                return 1;
+            }
+            return Min<size_t>(localExecutor->GetThreadCount() + 1, CeilDiv(docCount, blockSize));
+        }
+
+        template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor, typename TTextFeatureAccessor>
+        inline void CalcGeneric(
+            const TModelTrees& trees,
+            const TIntrusivePtr<ICtrProvider>& ctrProvider,
+            const TIntrusivePtr<TTextProcessingCollection>& textProcessingCollection,
+            TFloatFeatureAccessor floatFeatureAccessor,
+            TCatFeatureAccessor catFeaturesAccessor,
+            TTextFeatureAccessor textFeatureAccessor,
+            size_t docCount,
+            const TEvaluationSchedule& schedule,
+            size_t treeStart,
+            size_t treeEnd,
+            EPredictionType predictionType,
+            TArrayRef<double> results,
+            NPar::TLocalExecutor* localExecutor,
+            const NCB::NModelEvaluation::TFeatureLayout* featureInfo = nullptr
+        ) {
+            const size_t blockSize = Min(schedule.BlockSize, docCount);
+            const size_t parallelChunkCount = GetParallelChunkCount(localExecutor, docCount, blockSize);
+            if (parallelChunkCount == 1) {
+                CalcGenericSequential(
+                    trees,
+                    ctrProvider,
+                    textProcessingCollection,
+                    floatFeatureAccessor,
+                    catFeaturesAccessor,
+                    textFeatureAccessor,
+                    docCount,
+                    schedule,
+                    treeStart,
+                    treeEnd,
+                    predictionType,
+                    results,
+                    featureInfo
+                );
+                return;
+            }
+            // every chunk writes its own slice of results, so there are no intermediate copies
+            const size_t chunkSize = CeilDiv(CeilDiv(docCount, parallelChunkCount), blockSize) * blockSize;
+            const size_t resultsPerDocument = results.size() / docCount;
+            localExecutor->ExecRangeWithThrow(
+                [&] (int chunkId) {
+                    const size_t chunkStart = chunkId * chunkSize;
+                    const size_t chunkDocCount = Min(chunkSize, docCount - chunkStart);
+                    CalcGenericSequential(
+                        trees,
+                        ctrProvider,
+                        textProcessingCollection,
+                        [&floatFeatureAccessor, chunkStart] (TFeaturePosition position, size_t index) {
+                            return floatFeatureAccessor(position, chunkStart + index);
+                        },
+                        [&catFeaturesAccessor, chunkStart] (TFeaturePosition position, size_t index) {
+                            return catFeaturesAccessor(position, chunkStart + index);
+                        },
+                        [&textFeatureAccessor, chunkStart] (TFeaturePosition position, size_t index) {
+                            return textFeatureAccessor(position, chunkStart + index);
+                        },
+                        chunkDocCount,
+                        schedule,
+                        treeStart,
+                        treeEnd,
+                        predictionType,
+                        results.Slice(chunkStart * resultsPerDocument, chunkDocCount * resultsPerDocument),
+                        featureInfo
+                    );
+                },
+                0,
+                SafeIntegerCast<int>(CeilDiv(docCount, chunkSize)),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+        }
+
         class TCpuEvaluator final : public IModelEvaluator {
         public:
             explicit TCpuEvaluator(const TFullModel& fullModel)
@@ -97,8 +190,54 @@ namespace NCB::NModelEvaluation {
             }
 
             void SetProperty(const TStringBuf propName, const TStringBuf propValue) override {
-                CB_ENSURE(false, "CPU evaluator don't have any properties. Got: " << propName);
-                Y_UNUSED(propValue);
+                if (propName == "BlockSize") {
+                    if (propValue == "Auto") {
+                        BlockSize.Clear();
+                    } else {
+                        const size_t blockSize = FromString<size_t>(propValue);
+                        CB_ENSURE(
+                            blockSize > 0 && blockSize <= MAX_FORMULA_EVALUATION_BLOCK_SIZE,
+                            "BlockSize should be Auto or in range [1, " << MAX_FORMULA_EVALUATION_BLOCK_SIZE << "]. Got: " << propValue
+                        );
+                        BlockSize = blockSize;
+                    }
+                } else if (propName == "ThreadCount") {
+                    const int threadCount = FromString<int>(propValue);
+                    CB_ENSURE(threadCount > 0, "ThreadCount should be positive. Got: " << propValue);
+                    if (threadCount == 1) {
+                        OwnedLocalExecutor.Reset();
+                    } else {
+                        OwnedLocalExecutor = MakeAtomicShared<NPar::TLocalExecutor>();
+                        OwnedLocalExecutor->RunAdditionalThreads(threadCount - 1);
+                    }
+                    LocalExecutor = OwnedLocalExecutor.Get();
+                } else if (propName == "Schedule") {
+                    if (propValue == "Auto") {
+                        ScheduleType.Clear();
+                    } else if (propValue == "DocMajor") {
+                        ScheduleType = EEvaluationSchedule::DocMajor;
+                    } else if (propValue == "TreeMajor") {
+                        ScheduleType = EEvaluationSchedule::TreeMajor;
+                    } else {
+                        CB_ENSURE(false, "Schedule should be Auto, DocMajor or TreeMajor. Got: " << propValue);
+                    }
+                } else if (propName == "Precision") {
+                    if (propValue == "Double") {
+                        FloatLeafValues.Reset();
+                    } else if (propValue == "Float") {
+                        CB_ENSURE(ModelTrees->IsOblivious(), "Float precision is supported only for oblivious trees");
+                        FloatLeafValues = MakeAtomicShared<TVector<float>>(ConvertLeafValuesToFloat(*ModelTrees));
+                    } else {
+                        CB_ENSURE(false, "Precision should be Double or Float. Got: " << propValue);
+                    }
+                } else {
+                    CB_ENSURE(false, "CPU evaluator don't have property " << propName);
+                }
+            }
+
+            void SetLocalExecutor(NPar::TLocalExecutor* localExecutor) override {
+                OwnedLocalExecutor.Reset();
+                LocalExecutor = localExecutor;
             }
 
             void CalcFlatTransposed(
@@ -155,10 +294,12 @@ namespace NCB::NModelEvaluation {
                     },
                     TCpuEvaluator::TextFeatureAccessorStub,
                     *docCount,
+                    GetSchedule(*docCount),
                     treeStart,
                     treeEnd,
                     PredictionType,
                     results,
+                    LocalExecutor,
                     featureInfo
                 );
             }
@@ -199,10 +340,12 @@ namespace NCB::NModelEvaluation {
                     },
                     TCpuEvaluator::TextFeatureAccessorStub,
                     features.size(),
+                    GetSchedule(features.size()),
                     treeStart,
                     treeEnd,
                     PredictionType,
                     results,
+                    LocalExecutor,
                     featureInfo
                 );
             }
@@ -233,10 +376,12 @@ namespace NCB::NModelEvaluation {
                     },
                     TCpuEvaluator::TextFeatureAccessorStub,
                     1,
+                    GetSchedule(1),
                     treeStart,
                     treeEnd,
                     PredictionType,
                     results,
+                    LocalExecutor,
                     featureInfo
                 );
             }
@@ -292,10 +437,12 @@ namespace NCB::NModelEvaluation {
                         return textFeatures[index][position.Index];
                     },
                     docCount,
+                    GetSchedule(docCount),
                     treeStart,
                     treeEnd,
                     PredictionType,
                     results,
+                    LocalExecutor,
                     featureInfo
                 );
             }
@@ -351,10 +498,12 @@ namespace NCB::NModelEvaluation {
                         return textFeatures[index][position.Index];
                     },
                     docCount,
+                    GetSchedule(docCount),
                     treeStart,
                     treeEnd,
                     PredictionType,
                     results,
+                    LocalExecutor,
                     featureInfo
                 );
             }
@@ -436,27 +585,40 @@ namespace NCB::NModelEvaluation {
                 CB_ENSURE(cpuQuantizedFeatures->BlocksCount * FORMULA_EVALUATION_BLOCK_SIZE >= cpuQuantizedFeatures->ObjectsCount);
                 std::fill(results.begin(), results.end(), 0.0);
                 auto subBlockSize = Min<size_t>(FORMULA_EVALUATION_BLOCK_SIZE, cpuQuantizedFeatures->ObjectsCount);
-                auto calcFunction = GetCalcTreesFunction(
-                    *ModelTrees,
-                    subBlockSize,
-                    false
-                );
+                auto calcFunction = FloatLeafValues
+                    ? GetFloatCalcTreesFunction(*ModelTrees, FloatLeafValues->data())
+                    : GetCalcTreesFunction(*ModelTrees, subBlockSize, false);
                 CB_ENSURE(results.size() == ModelTrees->GetDimensionsCount() * cpuQuantizedFeatures->ObjectsCount);
-                TVector<TCalcerIndexType> indexesVec(subBlockSize);
-                double* resultPtr = results.data();
-                for (size_t blockId = 0; blockId < cpuQuantizedFeatures->BlocksCount; ++blockId) {
-                    auto subBlock = cpuQuantizedFeatures->ExtractBlock(blockId);
-                    calcFunction(
-                        *ModelTrees, &subBlock,
-                        subBlock.ObjectsCount,
-                        indexesVec.data(),
-                        treeStart,
-                        treeEnd,
-                        resultPtr
-                    );
-                    size_t items = subBlock.GetObjectsCount() * ModelTrees->GetDimensionsCount();
-                    ApplyScaleAndBias(ModelTrees->GetScaleAndBias(), TArrayRef<double>(resultPtr, resultPtr + items), treeStart);
-                    resultPtr += items;
+                const size_t blockCount = cpuQuantizedFeatures->BlocksCount;
+                const size_t chunkCount = GetParallelChunkCount(LocalExecutor, blockCount, 1);
+                const size_t blocksPerChunk = CeilDiv(blockCount, chunkCount);
+                auto calcBlocks = [&] (int chunkId) {
+                    TVector<TCalcerIndexType> indexesVec(subBlockSize);
+                    const size_t chunkBlockEnd = Min(blockCount, (chunkId + 1) * blocksPerChunk);
+                    for (size_t blockId = chunkId * blocksPerChunk; blockId < chunkBlockEnd; ++blockId) {
+                        auto subBlock = cpuQuantizedFeatures->ExtractBlock(blockId);
+                        // all blocks except the last one are full
+                        double* resultPtr = results.data() + blockId * FORMULA_EVALUATION_BLOCK_SIZE * ModelTrees->GetDimensionsCount();
+                        calcFunction(
+                            *ModelTrees, &subBlock,
+                            subBlock.ObjectsCount,
+                            indexesVec.data(),
+                            treeStart,
+                            treeEnd,
+                            resultPtr
+                        );
+                        size_t items = subBlock.GetObjectsCount() * ModelTrees->GetDimensionsCount();
+                        ApplyScaleAndBias(ModelTrees->GetScaleAndBias(), TArrayRef<double>(resultPtr, resultPtr + items), treeStart);
+                    }
+                };
+                if (chunkCount == 1) {
+                    calcBlocks(0);
+                } else {
+                    LocalExecutor->ExecRangeWithThrow(
+                        calcBlocks,
+                        0,
+                        SafeIntegerCast<int>(CeilDiv(blockCount, blocksPerChunk)),
+                        NPar::TLocalExecutor::WAIT_COMPLETE);
                 }
             }
 
@@ -510,6 +672,14 @@ namespace NCB::NModelEvaluation {
             }
 
         private:
+            TEvaluationSchedule GetSchedule(size_t docCount) const {
+                TEvaluationSchedule schedule = GetEvaluationSchedule(*ModelTrees, docCount, ScheduleType, BlockSize);
+                if (FloatLeafValues) {
+                    schedule.FloatLeafValues = FloatLeafValues->data();
+                }
+                return schedule;
+            }
+
             template <typename TCatFeatureContainer = TConstArrayRef<int>>
             void ValidateInputFeatures(
                 TConstArrayRef<TConstArrayRef<float>> floatFeatures,
@@ -589,6 +759,15 @@ namespace NCB::NModelEvaluation {
             const TIntrusivePtr<TTextProcessingCollection> TextProcessingCollection;
             EPredictionType PredictionType = EPredictionType::RawFormulaVal;
             TMaybe<TFeatureLayout> ExtFeatureLayout;
+            //! Documents block size set by user, cache friendly block size is used if not defined
+            TMaybe<size_t> BlockSize;
+            //! Evaluation schedule set by user, chosen by model size and document count if not defined
+            TMaybe<EEvaluationSchedule> ScheduleType;
+            //! Leaf values converted to float by Precision property, shared between evaluator clones
+            TAtomicSharedPtr<TVector<float>> FloatLeafValues;
+            //! Persistent thread pool created by ThreadCount property, shared between evaluator clones
+            TAtomicSharedPtr<NPar::TLocalExecutor> OwnedLocalExecutor;
+            NPar::TLocalExecutor* LocalExecutor = nullptr;
         };
     }
 
@@ -10,10 +10,13 @@
 
 #include <util/generic/array_ref.h>
 #include <util/generic/hash.h>
+#include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 
 namespace NCB::NModelEvaluation {
     constexpr size_t FORMULA_EVALUATION_BLOCK_SIZE = 128;
+    //! Upper limit for block size set via CPU evaluator "BlockSize" property
+    constexpr size_t MAX_FORMULA_EVALUATION_BLOCK_SIZE = 8 * FORMULA_EVALUATION_BLOCK_SIZE;
 
     class TCPUEvaluatorQuantizedData final : public IQuantizedData {
     public:
@@ -258,6 +261,88 @@ namespace NCB::NModelEvaluation {
 
 #endif
 
+    /**
+     * Same result as BinarizeFloats for sorted borders, but with branchless binary search over borderSearchTree
+     *  (see BuildBorderSearchTree): O(log(borders.size())) per value instead of O(borders.size()).
+     * Searches of all documents of a block go level by level, so memory accesses of different documents overlap.
+     */
+    template <bool UseNanSubstitution, typename TFloatFeatureAccessor>
+    Y_FORCE_INLINE void BinarizeFloatsWithSearchTree(
+        TFeaturePosition position,
+        const size_t docCount,
+        TFloatFeatureAccessor floatAccessor,
+        const size_t borderCount,
+        const TConstArrayRef<float> borderSearchTree,
+        size_t start,
+        ui8*& result,
+        const float nanSubstitutionValue = 0.0f
+    ) {
+        Y_ASSERT(docCount <= FORMULA_EVALUATION_BLOCK_SIZE);
+        Y_ASSERT(borderSearchTree.size() > borderCount);
+        float val[FORMULA_EVALUATION_BLOCK_SIZE];
+        ui32 node[FORMULA_EVALUATION_BLOCK_SIZE];
+        for (size_t docId = 0; docId < docCount; ++docId) {
+            val[docId] = floatAccessor(position, start + docId);
+            if (UseNanSubstitution) {
+                if (IsNan(val[docId])) {
+                    val[docId] = nanSubstitutionValue;
+                }
+            }
+            node[docId] = 1;
+        }
+        const float* tree = borderSearchTree.data();
+        const ui32 firstLeaf = borderSearchTree.size();
+        for (ui32 levelSize = 1; levelSize < firstLeaf; levelSize *= 2) {
+            for (size_t docId = 0; docId < docCount; ++docId) {
+                // NaN is not greater than any border, so it goes down to the leftmost leaf like in BinarizeFloats
+                node[docId] = 2 * node[docId] + (val[docId] > tree[node[docId]]);
+            }
+        }
+        for (size_t blockStart = 0; blockStart < borderCount; blockStart += MAX_VALUES_PER_BIN) {
+            const ui32 blockSize = Min<size_t>(MAX_VALUES_PER_BIN, borderCount - blockStart);
+            for (size_t docId = 0; docId < docCount; ++docId) {
+                const ui32 lessBorderCount = node[docId] - firstLeaf;
+                result[docId] = Min<ui32>(lessBorderCount - Min<ui32>(lessBorderCount, blockStart), blockSize);
+            }
+            result += docCount;
+        }
+    }
+
+    template <bool UseNanSubstitution, typename TFloatFeatureAccessor>
+    Y_FORCE_INLINE void BinarizeFloatFeature(
+        TFeaturePosition position,
+        const size_t docCount,
+        TFloatFeatureAccessor floatAccessor,
+        const TConstArrayRef<float> borders,
+        const TConstArrayRef<float> borderSearchTree,
+        size_t start,
+        ui8*& result,
+        const float nanSubstitutionValue = 0.0f
+    ) {
+        if (borderSearchTree.empty()) {
+            BinarizeFloats<UseNanSubstitution>(
+                position,
+                docCount,
+                floatAccessor,
+                borders,
+                start,
+                result,
+                nanSubstitutionValue
+            );
+        } else {
+            BinarizeFloatsWithSearchTree<UseNanSubstitution>(
+                position,
+                docCount,
+                floatAccessor,
+                borders.size(),
+                borderSearchTree,
+                start,
+                result,
+                nanSubstitutionValue
+            );
+        }
+    }
+
 /**
 * This function binarizes
 */
@@ -291,43 +376,49 @@ namespace NCB::NModelEvaluation {
             ui8* resultPtrForBlockStart = resultPtr;
             ++cpuEvaluatorQuantizedData->BlocksCount;
             auto docCount = Min(end - start, FORMULA_EVALUATION_BLOCK_SIZE);
-            for (const auto& floatFeature : trees.GetFloatFeatures()) {
+            const auto& borderSearchTrees = trees.GetFloatFeatureBorderSearchTrees();
+            for (size_t floatFeatureIdx : xrange(trees.GetFloatFeatures().size())) {
+                const auto& floatFeature = trees.GetFloatFeatures()[floatFeatureIdx];
                 if (!floatFeature.UsedInModel()) {
                     continue;
                 }
+                const TConstArrayRef<float> borderSearchTree = borderSearchTrees[floatFeatureIdx];
                 TFeaturePosition position = floatFeature.Position;
                 if (featureInfo) {
                     position = featureInfo->GetRemappedPosition(floatFeature);
                 }
                 if (!floatFeature.HasNans ||
                     floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsIs) {
-                    BinarizeFloats<false>(
+                    BinarizeFloatFeature<false>(
                         position,
                         docCount,
                         floatAccessor,
                         floatFeature.Borders,
+                        borderSearchTree,
                         start,
                         resultPtr
                     );
                 } else {
                     const float infinity = std::numeric_limits<float>::infinity();
                     if (floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsFalse) {
-                        BinarizeFloats<true>(
+                        BinarizeFloatFeature<true>(
                             position,
                             docCount,
                             floatAccessor,
                             floatFeature.Borders,
+                            borderSearchTree,
                             start,
                             resultPtr,
                             -infinity
                         );
                     } else {
                         Y_ASSERT(floatFeature.NanValueTreatment == TFloatFeature::ENanValueTreatment::AsTrue);
-                        BinarizeFloats<true>(
+                        BinarizeFloatFeature<true>(
                             position,
                             docCount,
                             floatAccessor,
                             floatFeature.Borders,
+                            borderSearchTree,
                             start,
                             resultPtr,
                             infinity
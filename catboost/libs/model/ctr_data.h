@@ -27,6 +27,9 @@ public:
     void Save(IOutputStream* s) const;
 
     void Load(IInputStream* s);
+
+    //! Load tables referencing memory of `s` owned by `storage` instead of copying them
+    void LoadThin(TMemoryInput* s, TIntrusivePtr<NCB::IResourceHolder> storage);
 };
 
 class TCtrDataStreamWriter {
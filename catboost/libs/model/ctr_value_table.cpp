@@ -3,6 +3,8 @@
 #include "flatbuffers_serializer_helper.h"
 #include <catboost/libs/model/flatbuffers/ctr_data.fbs.h>
 
+#include <catboost/libs/helpers/exception.h>
+
 #include <util/generic/fwd.h>
 #include <util/generic/ptr.h>
 #include <util/stream/input.h>
@@ -10,38 +12,46 @@
 #include <util/system/compiler.h>
 #include <util/ysaveload.h>
 
+#include <cstring>
+
 
 void TCtrValueTable::Save(IOutputStream* s) const {
     using namespace flatbuffers;
     using namespace NCatBoostFbs;
-    TModelPartsCachingSerializer serializer;
+    TConstArrayRef<NCatboost::TBucket> indexBuckets;
+    TConstArrayRef<NCatboost::TBucketGroup> indexBucketGroups;
+    TConstArrayRef<ui8> ctrBlobData;
     if (HoldsAlternative<TSolidTable>(Impl)) {
         auto& solid = Get<TSolidTable>(Impl);
-        auto indexHashOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) solid.IndexBuckets.data(),
-                                                sizeof(NCatboost::TBucket) * solid.IndexBuckets.size());
-        auto ctrBlob = serializer.FlatbufBuilder.CreateVector(solid.CTRBlob);
-        auto ctrValueTable = CreateTCtrValueTable(
-            serializer.FlatbufBuilder,
-            serializer.GetOffset(ModelCtrBase),
-            indexHashOffset,
-            ctrBlob,
-            CounterDenominator,
-            TargetClassesCount);
-        serializer.FlatbufBuilder.Finish(ctrValueTable);
+        indexBuckets = solid.IndexBuckets;
+        indexBucketGroups = solid.IndexBucketGroups;
+        ctrBlobData = solid.CTRBlob;
     } else {
         auto& thin = Get<TThinTable>(Impl);
-        auto indexHashOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) thin.IndexBuckets.data(),
-                                                sizeof(NCatboost::TBucket) * thin.IndexBuckets.size());
-        auto ctrBlob = serializer.FlatbufBuilder.CreateVector(thin.CTRBlob.data(), thin.CTRBlob.size());
-        auto ctrValueTable = CreateTCtrValueTable(
-            serializer.FlatbufBuilder,
-            serializer.GetOffset(ModelCtrBase),
-            indexHashOffset,
-            ctrBlob,
-            CounterDenominator,
-            TargetClassesCount);
-        serializer.FlatbufBuilder.Finish(ctrValueTable);
+        indexBuckets = thin.IndexBuckets;
+        indexBucketGroups = thin.IndexBucketGroups;
+        ctrBlobData = thin.CTRBlob;
     }
+    TModelPartsCachingSerializer serializer;
+    auto indexHashOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) indexBuckets.data(),
+                                            sizeof(NCatboost::TBucket) * indexBuckets.size());
+    flatbuffers::Offset<flatbuffers::Vector<ui8>> indexBucketGroupsOffset = 0;
+    if (!indexBucketGroups.empty()) {
+        serializer.FlatbufBuilder.ForceVectorAlignment(
+            sizeof(NCatboost::TBucketGroup) * indexBucketGroups.size(), sizeof(ui8), alignof(NCatboost::TBucketGroup));
+        indexBucketGroupsOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) indexBucketGroups.data(),
+                                            sizeof(NCatboost::TBucketGroup) * indexBucketGroups.size());
+    }
+    auto ctrBlob = serializer.FlatbufBuilder.CreateVector(ctrBlobData.data(), ctrBlobData.size());
+    auto ctrValueTable = CreateTCtrValueTable(
+        serializer.FlatbufBuilder,
+        serializer.GetOffset(ModelCtrBase),
+        indexHashOffset,
+        ctrBlob,
+        CounterDenominator,
+        TargetClassesCount,
+        indexBucketGroupsOffset);
+    serializer.FlatbufBuilder.Finish(ctrValueTable);
     SaveSize(s, serializer.FlatbufBuilder.GetSize());
     s->Write(serializer.FlatbufBuilder.GetBufferPointer(), serializer.FlatbufBuilder.GetSize());
 }
@@ -65,6 +75,88 @@ void TCtrValueTable::LoadSolid(void* buf, size_t length) {
     solid.IndexBuckets.assign((NCatboost::TBucket*)ctrValueTable->IndexHashRaw()->data(),
                               (NCatboost::TBucket*)(ctrValueTable->IndexHashRaw()->data() + ctrValueTable->IndexHashRaw()->size()));
 
+    if (ctrValueTable->IndexBucketGroupsRaw()) {
+        const auto* groupsRaw = ctrValueTable->IndexBucketGroupsRaw();
+        solid.IndexBucketGroups.resize(groupsRaw->size() / sizeof(NCatboost::TBucketGroup));
+        std::memcpy(
+            solid.IndexBucketGroups.data(),
+            groupsRaw->data(),
+            solid.IndexBucketGroups.size() * sizeof(NCatboost::TBucketGroup));
+    }
+
     solid.CTRBlob.assign(ctrValueTable->CTRBlob()->data(),
                          ctrValueTable->CTRBlob()->data() + ctrValueTable->CTRBlob()->size());
 }
+
+void TCtrValueTable::LoadThin(TMemoryInput* in, TIntrusivePtr<NCB::IResourceHolder> storage) {
+    using namespace flatbuffers;
+    const ui32 size = LoadSize(in);
+    CB_ENSURE(size <= in->Avail(), "CTR table is truncated: expected " << size << " bytes, got " << in->Avail());
+    const ui8* buf = reinterpret_cast<const ui8*>(in->Buf());
+    in->Skip(size);
+    {
+        flatbuffers::Verifier verifier(buf, size);
+        CB_ENSURE(verifier.VerifyBuffer<NCatBoostFbs::TCtrValueTable>(nullptr), "Flatbuffers CTR table verification failed");
+    }
+    auto ctrValueTable = flatbuffers::GetRoot<NCatBoostFbs::TCtrValueTable>(buf);
+    ModelCtrBase.FBDeserialize(ctrValueTable->ModelCtrBase());
+    CounterDenominator = ctrValueTable->CounterDenominator();
+    TargetClassesCount = ctrValueTable->TargetClassesCount();
+
+    Impl = TThinTable();
+    auto& thin = Get<TThinTable>(Impl);
+    const ui8* bucketsData = ctrValueTable->IndexHashRaw()->data();
+    const size_t bucketCount = ctrValueTable->IndexHashRaw()->size() / sizeof(NCatboost::TBucket);
+    // TBucket is packed, so buckets are referenced in place at any offset
+    static_assert(alignof(NCatboost::TBucket) == 1, "TBucket is expected to be packed");
+    thin.IndexBuckets = MakeArrayRef(reinterpret_cast<const NCatboost::TBucket*>(bucketsData), bucketCount);
+    thin.IndexBucketsHolder = storage;
+    if (ctrValueTable->IndexBucketGroupsRaw()) {
+        const ui8* groupsData = ctrValueTable->IndexBucketGroupsRaw()->data();
+        const size_t groupCount = ctrValueTable->IndexBucketGroupsRaw()->size() / sizeof(NCatboost::TBucketGroup);
+        if (reinterpret_cast<uintptr_t>(groupsData) % alignof(NCatboost::TBucketGroup) == 0) {
+            thin.IndexBucketGroups = MakeArrayRef(
+                reinterpret_cast<const NCatboost::TBucketGroup*>(groupsData),
+                groupCount);
+            thin.IndexBucketGroupsHolder = storage;
+        } else {
+            TVector<NCatboost::TBucketGroup> groups(groupCount);
+            std::memcpy(groups.data(), groupsData, groupCount * sizeof(NCatboost::TBucketGroup));
+            auto groupsHolder = MakeIntrusive<NCB::TVectorHolder<NCatboost::TBucketGroup>>(std::move(groups));
+            thin.IndexBucketGroups = groupsHolder->Data;
+            thin.IndexBucketGroupsHolder = std::move(groupsHolder);
+        }
+    }
+    thin.CTRBlob = MakeArrayRef(ctrValueTable->CTRBlob()->data(), ctrValueTable->CTRBlob()->size());
+    thin.CTRBlobHolder = std::move(storage);
+}
+
+void TCtrValueTable::SetIndexLayout(ECtrTableIndexLayout layout) {
+    if (layout == GetIndexLayout()) {
+        return;
+    }
+    if (HoldsAlternative<TThinTable>(Impl)) {
+        TSolidTable solid;
+        Get<TThinTable>(Impl).ToSolidTable(&solid);
+        Impl = std::move(solid);
+    }
+    auto& solid = Get<TSolidTable>(Impl);
+    switch (layout) {
+        case ECtrTableIndexLayout::Linear:
+            solid.IndexBuckets = NCatboost::ConvertToLinearBuckets(solid.IndexBucketGroups);
+            solid.IndexBucketGroups.clear();
+            break;
+        case ECtrTableIndexLayout::CacheLineBuckets:
+            solid.IndexBucketGroups = NCatboost::ConvertToBucketGroups(solid.IndexBuckets);
+            solid.IndexBuckets.clear();
+            break;
+    }
+}
+
+TVector<NCatboost::TBucket> TCtrValueTable::GetLinearIndexBuckets() const {
+    if (GetIndexLayout() == ECtrTableIndexLayout::CacheLineBuckets) {
+        return NCatboost::ConvertToLinearBuckets(GetIndexBucketGroups());
+    }
+    const auto buckets = GetIndexHashViewer().GetBuckets();
+    return TVector<NCatboost::TBucket>(buckets.begin(), buckets.end());
+}
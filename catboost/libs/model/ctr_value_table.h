@@ -1,13 +1,16 @@
 #pragma once
 
+#include "enums.h"
 #include "online_ctr.h"
 
 #include <catboost/libs/helpers/dense_hash_view.h>
+#include <catboost/libs/helpers/resource_holder.h>
 
 #include <util/generic/array_ref.h>
 #include <util/generic/variant.h>
 #include <util/generic/vector.h>
 #include <util/stream/fwd.h>
+#include <util/stream/mem.h>
 #include <util/system/types.h>
 
 #include <algorithm>
@@ -17,24 +20,34 @@
 class TCtrValueTable {
     struct TSolidTable {
         TVector<NCatboost::TBucket> IndexBuckets;
+        //! Not empty only for ECtrTableIndexLayout::CacheLineBuckets, IndexBuckets are empty then
+        TVector<NCatboost::TBucketGroup> IndexBucketGroups;
         TVector<ui8> CTRBlob;
 
     public:
         bool operator==(const TSolidTable& other) const {
-            return std::tie(IndexBuckets, CTRBlob) == std::tie(other.IndexBuckets, other.CTRBlob);
+            return std::tie(IndexBuckets, IndexBucketGroups, CTRBlob) ==
+                std::tie(other.IndexBuckets, other.IndexBucketGroups, other.CTRBlob);
         }
     };
     struct TThinTable {
         TConstArrayRef<NCatboost::TBucket> IndexBuckets;
+        TConstArrayRef<NCatboost::TBucketGroup> IndexBucketGroups;
         TConstArrayRef<ui8> CTRBlob;
+        //! Owners of memory referenced by IndexBuckets, IndexBucketGroups and CTRBlob
+        TIntrusivePtr<NCB::IResourceHolder> IndexBucketsHolder;
+        TIntrusivePtr<NCB::IResourceHolder> IndexBucketGroupsHolder;
+        TIntrusivePtr<NCB::IResourceHolder> CTRBlobHolder;
 
     public:
         bool operator==(const TThinTable& other) const {
-            return std::tie(IndexBuckets, CTRBlob) == std::tie(other.IndexBuckets, other.CTRBlob);
+            return std::tie(IndexBuckets, IndexBucketGroups, CTRBlob) ==
+                std::tie(other.IndexBuckets, other.IndexBucketGroups, other.CTRBlob);
         }
 
         void ToSolidTable(TSolidTable* table) {
             table->IndexBuckets.assign(IndexBuckets.begin(), IndexBuckets.end());
+            table->IndexBucketGroups.assign(IndexBucketGroups.begin(), IndexBucketGroups.end());
             table->CTRBlob.assign(CTRBlob.begin(), CTRBlob.end());
         }
     };
@@ -78,7 +91,22 @@ public:
         );
     }
 
+    ECtrTableIndexLayout GetIndexLayout() const {
+        return GetIndexBucketGroups().empty() ? ECtrTableIndexLayout::Linear : ECtrTableIndexLayout::CacheLineBuckets;
+    }
+
+    /**
+     * Rebuild hash index in `layout`, indexes of hashes and CTR blob stay the same.
+     * Tables referencing external memory are copied.
+     */
+    void SetIndexLayout(ECtrTableIndexLayout layout);
+
+    //! Index buckets in ECtrTableIndexLayout::Linear layout (converted if the table has another layout)
+    TVector<NCatboost::TBucket> GetLinearIndexBuckets() const;
+
+    //! Only for tables with ECtrTableIndexLayout::Linear
     NCatboost::TDenseIndexHashView GetIndexHashViewer() const {
+        Y_ENSURE(GetIndexLayout() == ECtrTableIndexLayout::Linear, "CTR table index has no linear layout");
         if (HoldsAlternative<TSolidTable>(Impl)) {
             auto& solid = Get<TSolidTable>(Impl);
             return NCatboost::TDenseIndexHashView(solid.IndexBuckets);
@@ -88,6 +116,14 @@ public:
         }
     }
 
+    //! Only for tables with ECtrTableIndexLayout::CacheLineBuckets
+    NCatboost::TBucketGroupIndexHashView GetBucketGroupIndexHashViewer() const {
+        Y_ENSURE(
+            GetIndexLayout() == ECtrTableIndexLayout::CacheLineBuckets,
+            "CTR table index has no cache line buckets layout");
+        return NCatboost::TBucketGroupIndexHashView(GetIndexBucketGroups());
+    }
+
     NCatboost::TDenseIndexHashBuilder GetIndexHashBuilder(size_t uniqueValuesCount) {
         auto& solid = Get<TSolidTable>(Impl);
         auto bucketCount = NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(uniqueValuesCount);
@@ -100,6 +136,21 @@ public:
 
     void LoadSolid(void* buf, size_t length);
 
+    /**
+     * Load table without copying: it will reference memory of `in` owned by `storage`.
+     * Bucket groups are copied only if they are misaligned in `in` memory.
+     */
+    void LoadThin(TMemoryInput* in, TIntrusivePtr<NCB::IResourceHolder> storage);
+
+private:
+    TConstArrayRef<NCatboost::TBucketGroup> GetIndexBucketGroups() const {
+        if (HoldsAlternative<TSolidTable>(Impl)) {
+            return Get<TSolidTable>(Impl).IndexBucketGroups;
+        } else {
+            return Get<TThinTable>(Impl).IndexBucketGroups;
+        }
+    }
+
 public:
     TModelCtrBase ModelCtrBase;
     int CounterDenominator = 0;
@@ -76,6 +76,11 @@ namespace NCB::NModelEvaluation {
                 }
             }
 
+            void SetLocalExecutor(NPar::TLocalExecutor* localExecutor) override {
+                // all documents are evaluated on device in one batch
+                Y_UNUSED(localExecutor);
+            }
+
             EPredictionType GetPredictionType() const override {
                 return PredictionType;
             }
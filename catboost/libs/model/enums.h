@@ -26,3 +26,11 @@ enum class EModelType {
     Pmml           /* "PMML", "pmml" */,
     CPUSnapshot    /* "CpuSnapshot" */
 };
+
+//! Layout of hash index of CTR value tables
+enum class ECtrTableIndexLayout {
+    //! Open addressing over 12-byte buckets, see NCatboost::TDenseIndexHashView
+    Linear           /* "Linear" */,
+    //! Open addressing over 64-byte groups of buckets, see NCatboost::TBucketGroupIndexHashView
+    CacheLineBuckets /* "CacheLineBuckets" */
+};
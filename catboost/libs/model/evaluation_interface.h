@@ -10,6 +10,10 @@
 #include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
 
+namespace NPar {
+    class TLocalExecutor;
+}
+
 namespace NCB {  // split due to CUDA-compiler inability to parse nested namespace definitions
     namespace NModelEvaluation {
         class TFeatureLayout {
@@ -69,6 +73,12 @@ namespace NCB {  // split due to CUDA-compiler inability to parse nested namespa
 
             virtual void SetProperty(const TStringBuf propName, const TStringBuf propValue) = 0;
 
+            /**
+             * Split big document batches into chunks evaluated in parallel on localExecutor threads.
+             * Evaluator doesn't own localExecutor, nullptr disables parallel evaluation.
+             */
+            virtual void SetLocalExecutor(NPar::TLocalExecutor* localExecutor) = 0;
+
             // TODO(kirillovs): maybe write special class for results (on gpu it'll hold floats in possibly managed memory)
             TVector<double> CreateVectorForPredictions(size_t docCount) const {
                 switch (GetPredictionType())
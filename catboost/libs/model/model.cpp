@@ -21,6 +21,7 @@
 #include <library/dbg_output/auto.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/bitops.h>
 #include <util/generic/cast.h>
 #include <util/generic/fwd.h>
 #include <util/generic/guid.h>
@@ -31,6 +32,8 @@
 #include <util/string/builder.h>
 #include <util/stream/str.h>
 
+#include <limits>
+
 
 static const char MODEL_FILE_DESCRIPTOR_CHARS[4] = {'C', 'B', 'M', '1'};
 
@@ -71,6 +74,11 @@ TFullModel ReadModel(const void* binaryBuffer, size_t binaryBufferSize, EModelTy
     return modelLoader->ReadModel(binaryBuffer, binaryBufferSize);
 }
 
+TFullModel ReadModelMapped(const TString& modelFile) {
+    THolder<NCB::IModelLoader> modelLoader = NCB::TModelLoaderFactory::Construct(EModelType::CatboostBinary);
+    return modelLoader->ReadModelMapped(modelFile);
+}
+
 TString SerializeModel(const TFullModel& model) {
     TStringStream ss;
     OutputModel(model, &ss);
@@ -153,6 +161,7 @@ void TModelTrees::TruncateTrees(size_t begin, size_t end) {
     auto savedScaleAndBias = GetScaleAndBias();
     TObliviousTreeBuilder builder(FloatFeatures, CatFeatures, TextFeatures, ApproxDimension);
     const auto& leafOffsets = RuntimeData->TreeFirstLeafOffsets;
+    const auto leafValues = GetLeafValues();
     for (size_t treeIdx = begin; treeIdx < end; ++treeIdx) {
         TVector<TModelSplit> modelSplits;
         for (int splitIdx = TreeStartOffsets[treeIdx];
@@ -162,8 +171,8 @@ void TModelTrees::TruncateTrees(size_t begin, size_t end) {
             modelSplits.push_back(RuntimeData->BinFeatures[TreeSplits[splitIdx]]);
         }
         TConstArrayRef<double> leafValuesRef(
-            LeafValues.begin() + leafOffsets[treeIdx],
-            LeafValues.begin() + leafOffsets[treeIdx] + ApproxDimension * (1u << TreeSizes[treeIdx])
+            leafValues.begin() + leafOffsets[treeIdx],
+            leafValues.begin() + leafOffsets[treeIdx] + ApproxDimension * (1u << TreeSizes[treeIdx])
         );
         builder.AddTree(
             modelSplits,
@@ -212,6 +221,10 @@ TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
             nonSymmetricStep.RightSubtreeDiff
         });
     }
+    TVector<double> externalLeafValues;
+    if (ExternalLeafValues.Defined()) {
+        externalLeafValues.assign(ExternalLeafValues->begin(), ExternalLeafValues->end());
+    }
     return NCatBoostFbs::CreateTModelTreesDirect(
         serializer.FlatbufBuilder,
         ApproxDimension,
@@ -222,7 +235,7 @@ TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
         &floatFeaturesOffsets,
         &oneHotFeaturesOffsets,
         &ctrFeaturesOffsets,
-        &LeafValues,
+        ExternalLeafValues.Defined() ? &externalLeafValues : &LeafValues,
         &LeafWeights,
         &fbsNonSymmetricTreeStepNode,
         &NonSymmetricNodeIdToLeafId,
@@ -233,6 +246,31 @@ TModelTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
     );
 }
 
+static void FillBorderSearchTree(
+    TConstArrayRef<float> paddedBorders,
+    size_t nodeIdx,
+    size_t* nextBorderIdx,
+    TArrayRef<float> tree
+) {
+    if (nodeIdx >= tree.size()) {
+        return;
+    }
+    FillBorderSearchTree(paddedBorders, 2 * nodeIdx, nextBorderIdx, tree);
+    tree[nodeIdx] = paddedBorders[(*nextBorderIdx)++];
+    FillBorderSearchTree(paddedBorders, 2 * nodeIdx + 1, nextBorderIdx, tree);
+}
+
+TVector<float> BuildBorderSearchTree(TConstArrayRef<float> sortedBorders) {
+    const size_t treeSize = FastClp2(sortedBorders.size() + 1);
+    TVector<float> paddedBorders(sortedBorders.begin(), sortedBorders.end());
+    paddedBorders.resize(treeSize - 1, std::numeric_limits<float>::infinity());
+    TVector<float> tree(treeSize, std::numeric_limits<float>::quiet_NaN());
+    size_t nextBorderIdx = 0;
+    FillBorderSearchTree(paddedBorders, 1, &nextBorderIdx, tree);
+    Y_ASSERT(nextBorderIdx == paddedBorders.size());
+    return tree;
+}
+
 void TModelTrees::UpdateRuntimeData() const {
     struct TFeatureSplitId {
         ui32 FeatureIdx = 0;
@@ -286,10 +324,15 @@ void TModelTrees::UpdateRuntimeData() const {
     ref.UsedEstimatedFeaturesCount = 0;
     ref.MinimalSufficientFloatFeaturesVectorSize = 0;
     ref.MinimalSufficientCatFeaturesVectorSize = 0;
-    for (const auto& feature : FloatFeatures) {
+    ref.FloatFeatureBorderSearchTrees.resize(FloatFeatures.size());
+    for (size_t featureIdx : xrange(FloatFeatures.size())) {
+        const auto& feature = FloatFeatures[featureIdx];
         if (!feature.UsedInModel()) {
             continue;
         }
+        if (feature.Borders.size() >= MIN_BORDER_COUNT_FOR_BORDER_SEARCH && IsSorted(feature.Borders.begin(), feature.Borders.end())) {
+            ref.FloatFeatureBorderSearchTrees[featureIdx] = BuildBorderSearchTree(feature.Borders);
+        }
         ++ref.UsedFloatFeaturesCount;
         ref.MinimalSufficientFloatFeaturesVectorSize = static_cast<size_t>(feature.Position.Index) + 1;
         for (int borderId = 0; borderId < feature.Borders.ysize(); ++borderId) {
@@ -437,7 +480,7 @@ TVector<ui32> TModelTrees::GetTreeLeafCounts() const {
         const size_t currTreeLeafValuesEnd = (
             treeNum + 1 < GetTreeCount()
             ? firstLeafOfsets[treeNum + 1]
-            : LeafValues.size()
+            : GetLeafValues().size()
         );
         const size_t currTreeLeafValuesCount = currTreeLeafValuesEnd - firstLeafOfsets[treeNum];
         Y_ASSERT(currTreeLeafValuesCount % ApproxDimension == 0);
@@ -452,7 +495,10 @@ void TModelTrees::SetScaleAndBias(const TScaleAndBias& scaleAndBias) {
     ScaleAndBias = scaleAndBias;
 }
 
-void TModelTrees::FBDeserialize(const NCatBoostFbs::TModelTrees* fbObj) {
+void TModelTrees::FBDeserialize(
+    const NCatBoostFbs::TModelTrees* fbObj,
+    TIntrusivePtr<NCB::IResourceHolder> externalStorage
+) {
     ApproxDimension = fbObj->ApproxDimension();
     if (fbObj->TreeSplits()) {
         TreeSplits.assign(fbObj->TreeSplits()->begin(), fbObj->TreeSplits()->end());
@@ -464,11 +510,20 @@ void TModelTrees::FBDeserialize(const NCatBoostFbs::TModelTrees* fbObj) {
         TreeStartOffsets.assign(fbObj->TreeStartOffsets()->begin(), fbObj->TreeStartOffsets()->end());
     }
 
+    LeafValues.clear();
+    ExternalLeafValues.Clear();
     if (fbObj->LeafValues()) {
-        LeafValues.assign(
-            fbObj->LeafValues()->data(),
-            fbObj->LeafValues()->data() + fbObj->LeafValues()->size()
-        );
+        const double* leafValuesData = fbObj->LeafValues()->data();
+        const size_t leafValuesCount = fbObj->LeafValues()->size();
+        // flatbuffers keep vectors aligned relative to buffer start, but the buffer itself can be misaligned
+        if (externalStorage && reinterpret_cast<uintptr_t>(leafValuesData) % alignof(double) == 0) {
+            ExternalLeafValues = NCB::TMaybeOwningConstArrayHolder<double>::CreateOwning(
+                TConstArrayRef<double>(leafValuesData, leafValuesCount),
+                std::move(externalStorage)
+            );
+        } else {
+            LeafValues.assign(leafValuesData, leafValuesData + leafValuesCount);
+        }
     }
     if (fbObj->NonSymmetricStepNodes()) {
         NonSymmetricStepNodes.resize(fbObj->NonSymmetricStepNodes()->size());
@@ -640,9 +695,15 @@ void TFullModel::Save(IOutputStream* s) const {
     }
 }
 
+static void ThrowUnknownModelPart(const TString& modelPartId) {
+    CB_ENSURE(
+        false,
+        "Got unknown partId = " << modelPartId << " via deserialization"
+            << "only static ctr and text processing collection model parts are supported"
+    );
+}
+
 void TFullModel::Load(IInputStream* s) {
-    using namespace flatbuffers;
-    using namespace NCatBoostFbs;
     ui32 fileDescriptor;
     ::Load(s, fileDescriptor);
     CB_ENSURE(fileDescriptor == GetModelFormatDescriptor(), "Incorrect model file descriptor");
@@ -650,17 +711,78 @@ void TFullModel::Load(IInputStream* s) {
     TArrayHolder<ui8> arrayHolder = new ui8[coreSize];
     s->LoadOrFail(arrayHolder.Get(), coreSize);
 
+    const TVector<TString> modelParts = LoadModelCore(arrayHolder.Get(), coreSize, nullptr);
+    for (const auto& modelPartId : modelParts) {
+        if (modelPartId == TStaticCtrProvider::ModelPartId()) {
+            CtrProvider = new TStaticCtrProvider;
+            CtrProvider->Load(s);
+        } else if (modelPartId == NCB::TTextProcessingCollection::GetStringIdentifier()) {
+            TextProcessingCollection = new NCB::TTextProcessingCollection();
+            TextProcessingCollection->Load(s);
+        } else {
+            ThrowUnknownModelPart(modelPartId);
+        }
+    }
+    UpdateDynamicData();
+}
+
+namespace {
+    class TBlobHolder : public NCB::IResourceHolder {
+    public:
+        explicit TBlobHolder(TBlob blob)
+            : Blob(std::move(blob))
+        {}
+
+    private:
+        TBlob Blob;
+    };
+}
+
+void TFullModel::LoadMapped(TBlob modelBlob) {
+    TMemoryInput in(modelBlob.Data(), modelBlob.Size());
+    ui32 fileDescriptor;
+    ::Load(&in, fileDescriptor);
+    CB_ENSURE(fileDescriptor == GetModelFormatDescriptor(), "Incorrect model file descriptor");
+    auto coreSize = ::LoadSize(&in);
+    CB_ENSURE(coreSize <= in.Avail(), "Model is truncated: expected " << coreSize << " bytes of model core, got " << in.Avail());
+    const char* coreData = in.Buf();
+    in.Skip(coreSize);
+
+    TIntrusivePtr<NCB::IResourceHolder> blobHolder = MakeIntrusive<TBlobHolder>(std::move(modelBlob));
+    const TVector<TString> modelParts = LoadModelCore(coreData, coreSize, blobHolder);
+    for (const auto& modelPartId : modelParts) {
+        if (modelPartId == TStaticCtrProvider::ModelPartId()) {
+            auto ctrProvider = MakeIntrusive<TStaticCtrProvider>();
+            ctrProvider->CtrData.LoadThin(&in, blobHolder);
+            CtrProvider = std::move(ctrProvider);
+        } else if (modelPartId == NCB::TTextProcessingCollection::GetStringIdentifier()) {
+            TextProcessingCollection = new NCB::TTextProcessingCollection();
+            TextProcessingCollection->Load(&in);
+        } else {
+            ThrowUnknownModelPart(modelPartId);
+        }
+    }
+    UpdateDynamicData();
+}
+
+TVector<TString> TFullModel::LoadModelCore(
+    const void* coreData,
+    size_t coreSize,
+    TIntrusivePtr<NCB::IResourceHolder> externalStorage
+) {
+    using namespace flatbuffers;
+    using namespace NCatBoostFbs;
     {
-        flatbuffers::Verifier verifier(arrayHolder.Get(), coreSize);
+        flatbuffers::Verifier verifier(static_cast<const ui8*>(coreData), coreSize);
         CB_ENSURE(VerifyTModelCoreBuffer(verifier), "Flatbuffers model verification failed");
     }
-    auto fbModelCore = GetTModelCore(arrayHolder.Get());
+    auto fbModelCore = GetTModelCore(coreData);
     CB_ENSURE(
         fbModelCore->FormatVersion() && fbModelCore->FormatVersion()->str() == CURRENT_CORE_FORMAT_STRING,
         "Unsupported model format: " << fbModelCore->FormatVersion()->str()
     );
     if (fbModelCore->ModelTrees()) {
-        ModelTrees.GetMutable()->FBDeserialize(fbModelCore->ModelTrees());
+        ModelTrees.GetMutable()->FBDeserialize(fbModelCore->ModelTrees(), std::move(externalStorage));
     }
     ModelInfo.clear();
     if (fbModelCore->InfoMap()) {
@@ -674,24 +796,7 @@ void TFullModel::Load(IInputStream* s) {
             modelParts.emplace_back(part->str());
         }
     }
-    if (!modelParts.empty()) {
-        for (const auto& modelPartId : modelParts) {
-            if (modelPartId == TStaticCtrProvider::ModelPartId()) {
-                CtrProvider = new TStaticCtrProvider;
-                CtrProvider->Load(s);
-            } else if (modelPartId == NCB::TTextProcessingCollection::GetStringIdentifier()) {
-                TextProcessingCollection = new NCB::TTextProcessingCollection();
-                TextProcessingCollection->Load(s);
-            } else {
-                CB_ENSURE(
-                    false,
-                    "Got unknown partId = " << modelPartId << " via deserialization"
-                        << "only static ctr and text processing collection model parts are supported"
-                );
-            }
-        }
-    }
-    UpdateDynamicData();
+    return modelParts;
 }
 
 void TFullModel::UpdateDynamicData() {
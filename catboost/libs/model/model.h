@@ -5,10 +5,12 @@
 #include "evaluation_interface.h"
 #include "features.h"
 #include "online_ctr.h"
+#include "repacked_bin.h"
 #include "scale_and_bias.h"
 #include "split.h"
 
 #include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/maybe_owning_array_holder.h>
 #include <catboost/private/libs/options/enums.h>
 #include <catboost/private/libs/text_features/text_processing_collection.h>
 
@@ -23,6 +25,7 @@
 #include <util/generic/string.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/memory/blob.h>
 #include <util/stream/fwd.h>
 #include <util/stream/mem.h>
 #include <util/system/spinlock.h>
@@ -57,14 +60,19 @@ class TModelPartsCachingSerializer;
     - TreeSizes - holds tree depth.
     - TreeStartOffsets - holds offset of first tree split in TreeSplits vector
 */
-struct TRepackedBin {
-    ui16 FeatureIndex = 0;
-    ui8 XorMask = 0;
-    ui8 SplitIdx = 0;
-};
-
 constexpr ui32 MAX_VALUES_PER_BIN = 254;
 
+//! Float features with at least this many borders are binarized with binary search over borders
+//! instead of comparison with every border
+constexpr size_t MIN_BORDER_COUNT_FOR_BORDER_SEARCH = 128;
+
+/**
+ * Sorted borders in Eytzinger (breadth-first) order for branchless binary search: tree[1] is the root,
+ *  children of tree[i] are tree[2i] and tree[2i + 1], borders are padded with +inf to 2^k - 1 values,
+ *  tree[0] is unused. Descent of k levels from the root ends at leaf 2^k + (count of borders less than value).
+ */
+TVector<float> BuildBorderSearchTree(TConstArrayRef<float> sortedBorders);
+
 // If selected diff is 0 we are in the last node in path
 struct TNonSymmetricTreeStepNode {
     static constexpr ui16 InvalidDiff = Max<ui16>();
@@ -124,10 +132,18 @@ public:
 
         //! Offset of first tree leaf in flat tree leafs array
         TVector<size_t> TreeFirstLeafOffsets;
+
+        /**
+         * [float feature idx in FloatFeatures] -> BuildBorderSearchTree result for used features with
+         *  at least MIN_BORDER_COUNT_FOR_BORDER_SEARCH sorted borders, empty for other features
+         */
+        TVector<TVector<float>> FloatFeatureBorderSearchTrees;
     };
 
 public:
     bool operator==(const TModelTrees& other) const {
+        const auto leafValues = GetLeafValues();
+        const auto otherLeafValues = other.GetLeafValues();
         return std::tie(
             ApproxDimension,
             TreeSplits,
@@ -135,7 +151,7 @@ public:
             TreeStartOffsets,
             NonSymmetricStepNodes,
             NonSymmetricNodeIdToLeafId,
-            LeafValues,
+            leafValues,
             CatFeatures,
             FloatFeatures,
             TextFeatures,
@@ -150,7 +166,7 @@ public:
             other.TreeStartOffsets,
             other.NonSymmetricStepNodes,
             other.NonSymmetricNodeIdToLeafId,
-            other.LeafValues,
+            otherLeafValues,
             other.CatFeatures,
             other.FloatFeatures,
             other.TextFeatures,
@@ -181,8 +197,12 @@ public:
     /**
      * Deserialize from flatbuffers object
      * @param fbObj
+     * @param externalStorage if not null, fbObj memory is owned by externalStorage and big arrays (leaf values)
+     *  are referenced instead of copied
      */
-    void FBDeserialize(const NCatBoostFbs::TModelTrees* fbObj);
+    void FBDeserialize(
+        const NCatBoostFbs::TModelTrees* fbObj,
+        TIntrusivePtr<NCB::IResourceHolder> externalStorage = nullptr);
 
     /**
      * Internal usage only.
@@ -229,9 +249,17 @@ public:
     }
 
     TConstArrayRef<double> GetLeafValues() const {
+        if (ExternalLeafValues.Defined()) {
+            return **ExternalLeafValues;
+        }
         return TConstArrayRef<double>(LeafValues.begin(), LeafValues.end());
     }
 
+    //! Leaf values are not owned by model trees and are referenced in external memory (e.g. memory-mapped file)
+    bool HasExternalLeafValues() const {
+        return ExternalLeafValues.Defined();
+    }
+
     TConstArrayRef<double> GetLeafWeights() const {
         return TConstArrayRef<double>(LeafWeights.begin(), LeafWeights.end());
     }
@@ -266,6 +294,7 @@ public:
 
     void SetLeafValues(const TVector<double>& leafValues) {
         LeafValues = leafValues;
+        ExternalLeafValues.Clear();
     }
 
     void SetLeafWeights(const TVector<double>& leafWeights) {
@@ -358,6 +387,9 @@ public:
     }
 
     void AddLeafValue(double leafValue) {
+        if (ExternalLeafValues.Defined()) {
+            SetLeafValues(TVector<double>(ExternalLeafValues->begin(), ExternalLeafValues->end()));
+        }
         LeafValues.push_back(leafValue);
     }
 
@@ -405,6 +437,11 @@ public:
         return RuntimeData->RepackedBins;
     }
 
+    const TVector<TVector<float>>& GetFloatFeatureBorderSearchTrees() const {
+        CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
+        return RuntimeData->FloatFeatureBorderSearchTrees;
+    }
+
     const TVector<size_t>& GetFirstLeafOffsets() const {
         CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
         return RuntimeData->TreeFirstLeafOffsets;
@@ -412,7 +449,7 @@ public:
 
     const double* GetFirstLeafPtrForTree(size_t treeIdx) const {
         CB_ENSURE(RuntimeData.Defined(), "runtime data should be initialized");
-        return &LeafValues[RuntimeData->TreeFirstLeafOffsets[treeIdx]];
+        return GetLeafValues().data() + RuntimeData->TreeFirstLeafOffsets[treeIdx];
     }
     /**
      * List all unique CTR bases (feature combination + ctr type) in model
@@ -527,6 +564,9 @@ private:
     //! Leaf values layout: [treeIndex][leafId * ApproxDimension + dimension]
     TVector<double> LeafValues;
 
+    //! If defined, leaf values are referenced in external memory instead of LeafValues (which is empty then)
+    TMaybe<NCB::TMaybeOwningConstArrayHolder<double>> ExternalLeafValues;
+
     /**
      * Leaf Weights are sums of weights or group weights of samples from the learn dataset that go to that leaf.
      * This information can be absent (this vector will be empty) in some models:
@@ -606,20 +646,34 @@ private:
     EFormulaEvaluatorType FormulaEvaluatorType = EFormulaEvaluatorType::CPU;
     TAdaptiveLock CurrentEvaluatorLock;
     mutable NCB::NModelEvaluation::TModelEvaluatorPtr Evaluator;
+    NPar::TLocalExecutor* LocalExecutor = nullptr;
 public:
     void SetEvaluatorType(EFormulaEvaluatorType evaluatorType) {
         with_lock(CurrentEvaluatorLock) {
             if (FormulaEvaluatorType != evaluatorType) {
                 Evaluator = NCB::NModelEvaluation::CreateEvaluator(evaluatorType, *this); // we can fail here
+                Evaluator->SetLocalExecutor(LocalExecutor);
                 FormulaEvaluatorType = evaluatorType;
             }
         }
     }
 
+    /**
+     * Evaluate big document batches in parallel on localExecutor threads.
+     * Model doesn't own localExecutor, nullptr disables parallel evaluation.
+     */
+    void SetLocalExecutor(NPar::TLocalExecutor* localExecutor) {
+        with_lock(CurrentEvaluatorLock) {
+            LocalExecutor = localExecutor;
+            Evaluator.Reset(); // evaluator can be shared with copies of this model, so recreate it
+        }
+    }
+
     NCB::NModelEvaluation::TConstModelEvaluatorPtr GetCurrentEvaluator() const {
         with_lock(CurrentEvaluatorLock) {
             if (!Evaluator) {
                 Evaluator = NCB::NModelEvaluation::CreateEvaluator(FormulaEvaluatorType, *this);
+                Evaluator->SetLocalExecutor(LocalExecutor);
             }
             return Evaluator;
         }
@@ -642,6 +696,7 @@ public:
                 DoSwap(CtrProvider, other.CtrProvider);
                 DoSwap(FormulaEvaluatorType, other.FormulaEvaluatorType);
                 DoSwap(Evaluator, other.Evaluator);
+                DoSwap(LocalExecutor, other.LocalExecutor);
             }
         }
         DoSwap(TextProcessingCollection, other.TextProcessingCollection);
@@ -757,6 +812,13 @@ public:
      */
     void Load(IInputStream* s);
 
+    /**
+     * Deserialize model from memory blob (usually memory-mapped model file) without copying.
+     * Leaf values and CTR tables reference blob memory, the model keeps the blob alive.
+     * @param modelBlob serialized model
+     */
+    void LoadMapped(TBlob modelBlob);
+
     //! Check if TFullModel instance has valid CTR provider.
     // If no ctr features present it will return true
     bool HasValidCtrProvider() const {
@@ -1112,6 +1174,16 @@ public:
      * Update indexes between TextProcessingCollection and Estimated features in ModelTrees
      */
     void UpdateEstimatedFeaturesIndices(TVector<TEstimatedFeature>&& newEstimatedFeatures);
+
+private:
+    /**
+     * Deserialize flatbuffers model core (trees and model info)
+     * @return identifiers of model parts following the core in serialized model
+     */
+    TVector<TString> LoadModelCore(
+        const void* coreData,
+        size_t coreSize,
+        TIntrusivePtr<NCB::IResourceHolder> externalStorage);
 };
 
 void OutputModel(const TFullModel& model, TStringBuf modelFile);
@@ -1125,6 +1197,15 @@ TFullModel ReadModel(
     size_t binaryBufferSize,
     EModelType format = EModelType::CatboostBinary);
 
+/**
+ * Memory-map model file in CatboostBinary format instead of reading it.
+ * Big model parts (leaf values and CTR tables) are not copied, so several processes loading the same model
+ *  share one copy of it in page cache.
+ * @param modelFile
+ * @return
+ */
+TFullModel ReadModelMapped(const TString& modelFile);
+
 /**
  * Serialize model to string
  * @param model
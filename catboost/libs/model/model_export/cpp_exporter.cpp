@@ -5,17 +5,52 @@
 #include <catboost/libs/model/ctr_helpers.h>
 #include <catboost/libs/model/static_ctr_provider.h>
 
+#include <library/json/json_reader.h>
 #include <library/resource/resource.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/map.h>
 #include <util/generic/set.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 #include <util/stream/input.h>
+#include <util/stream/str.h>
 
 namespace NCB {
     using namespace NCatboostModelExportHelpers;
 
+    static bool IsOptimizedExportMode(const TString& userParametersJson) {
+        if (userParametersJson.empty()) {
+            return false;
+        }
+        TStringInput is(userParametersJson);
+        NJson::TJsonValue params;
+        CB_ENSURE(NJson::ReadJsonTree(&is, &params), "Can't parse JSON user params for exporting the model to C++");
+        bool isOptimized = false;
+        for (const auto& [key, value] : params.GetMapSafe()) {
+            CB_ENSURE(key == "cpp_export_mode", "Unknown JSON user param for exporting the model to C++: " << key);
+            const TString& mode = value.GetStringSafe();
+            CB_ENSURE(
+                mode == "readable" || mode == "optimized",
+                "cpp_export_mode should be readable or optimized. Got: " << mode
+            );
+            isOptimized = (mode == "optimized");
+        }
+        return isOptimized;
+    }
+
+    TCatboostModelToCppConverter::TCatboostModelToCppConverter(
+        const TString& modelFile,
+        bool addFileFormatExtension,
+        const TString& userParametersJson
+    )
+        : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
+        , Optimized(IsOptimizedExportMode(userParametersJson))
+    {
+    }
+
     /*
      * Tiny code for case when cat features not present
      */
@@ -211,7 +246,7 @@ namespace NCB {
             out << indent << orderedLearnCtr.first << "ull," << '\n';
             out << indent++ << "{" << '\n';
             out << indent << WN("IndexHashViewer") << "{";
-            const TConstArrayRef<NCatboost::TBucket> HashViewerBuckets = learnCtrValueTable.GetIndexHashViewer().GetBuckets();
+            const TVector<NCatboost::TBucket> HashViewerBuckets = learnCtrValueTable.GetLinearIndexBuckets();
             commaInner.ResetCount(HashViewerBuckets.size());
             for (const auto& bucket : HashViewerBuckets) {
                 out << "{" << bucket.Hash << "ull, " << bucket.IndexValue << "}" << commaInner;
@@ -332,4 +367,229 @@ namespace NCB {
         Out << '\n';
         Out << NResource::Find("catboost_model_export_cpp_model_applicator");
     }
+
+    /*
+     * Code specialized for the model: borders are constant-folded into binarization, consecutive trees
+     * of the same depth are evaluated by depth-specialized code on blocks of documents
+     * (the same blocked structure as in CPU evaluator, loops are simple enough for compiler to vectorize them).
+     */
+
+    // features with more borders are binarized by binary search in array of borders
+    static constexpr size_t MAX_CONSTANT_FOLDED_BORDERS = 16;
+
+    void TCatboostModelToCppConverter::WriteOptimizedModel(const TFullModel& model) {
+        const TModelTrees& trees = *model.ModelTrees;
+        CB_ENSURE(!model.HasCategoricalFeatures(), "Optimized export of model with categorical features to cpp is not supported.");
+        CB_ENSURE(trees.GetTextFeatures().empty(), "Optimized export of model with text features to cpp is not supported.");
+        CB_ENSURE(trees.GetDimensionsCount() == 1, "Export of MultiClassification model to cpp is not supported.");
+        CB_ENSURE(trees.IsOblivious(), "Optimized export of non symmetric trees to cpp is not supported.");
+        CB_ENSURE(
+            AllOf(trees.GetBinFeatures(), [] (const TModelSplit& split) { return split.Type == ESplitType::FloatFeature; }),
+            "Optimized export to cpp supports only splits on float features."
+        );
+
+        // binary features are numbered by borders of used float features, binarized features - by used float features
+        TVector<ui32> binaryFeatureToBinarized;
+        TVector<ui32> binaryFeatureToBorder;
+        TVector<const TFloatFeature*> binarizedFeatures;
+        size_t maxBorderCount = 0;
+        for (const auto& floatFeature : trees.GetFloatFeatures()) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            for (size_t borderId : xrange(floatFeature.Borders.size())) {
+                binaryFeatureToBinarized.push_back(binarizedFeatures.size());
+                binaryFeatureToBorder.push_back(borderId);
+            }
+            binarizedFeatures.push_back(&floatFeature);
+            maxBorderCount = Max(maxBorderCount, floatFeature.Borders.size());
+        }
+        CB_ENSURE(binarizedFeatures.size() <= Max<ui16>(), "Too many float features for optimized export to cpp");
+        const auto treeSizes = trees.GetTreeSizes();
+        const int maxDepth = treeSizes.empty() ? 0 : *MaxElement(treeSizes.begin(), treeSizes.end());
+
+        TIndent indent(0);
+        Out << "#include <algorithm>" << '\n';
+        Out << "#include <cstddef>" << '\n';
+        Out << "#include <string>" << '\n';
+        Out << "#include <vector>" << '\n';
+        Out << '\n';
+        Out << "/* Model data */" << '\n';
+        Out << indent++ << "namespace {" << '\n';
+        Out << indent << "typedef " << (maxBorderCount <= 255 ? "unsigned char" : "unsigned short") << " TCatboostBin;" << '\n';
+        Out << indent << "typedef " << (maxDepth <= 8 ? "unsigned char" : "unsigned int") << " TCatboostLeafIndex;" << '\n';
+        Out << '\n';
+        Out << indent << "const size_t CatboostBinarizedFeatureCount = " << binarizedFeatures.size() << ";" << '\n';
+        Out << indent << "const size_t CatboostBlockSize = 128;" << '\n';
+        Out << '\n';
+
+        auto floatLiteral = [] (float value) {
+            TString str = FloatToString(value, PREC_NDIGITS, 9);
+            if (int tmpValue; TryFromString<int>(str, tmpValue)) {
+                str.append('.');
+            }
+            return str + "f";
+        };
+        for (size_t binarizedId : xrange(binarizedFeatures.size())) {
+            const auto& borders = binarizedFeatures[binarizedId]->Borders;
+            if (borders.size() > MAX_CONSTANT_FOLDED_BORDERS) {
+                Out << indent << "const float CatboostBorders" << binarizedId << "[" << borders.size() << "] = {"
+                    << OutputArrayInitializer([&] (size_t i) { return floatLiteral(borders[i]); }, borders.size()) << "};" << '\n';
+                Out << '\n';
+            }
+        }
+        Out << indent << "/* Binarized value of feature is the number of its borders less than feature value */" << '\n';
+        Out << indent++ << "void CatboostBinarizeBlock(const float* features, size_t featureStride, size_t docCount, TCatboostBin* bins) {" << '\n';
+        Out << indent++ << "for (size_t docId = 0; docId < docCount; ++docId) {" << '\n';
+        Out << indent << "const float* docFeatures = features + docId * featureStride;" << '\n';
+        Out << indent << "float value;" << '\n';
+        for (size_t binarizedId : xrange(binarizedFeatures.size())) {
+            const auto& floatFeature = *binarizedFeatures[binarizedId];
+            const auto& borders = floatFeature.Borders;
+            Out << indent << "value = docFeatures[" << floatFeature.Position.Index << "];" << '\n';
+            Out << indent << "bins[" << binarizedId << " * docCount + docId] = (TCatboostBin)(";
+            if (borders.size() > MAX_CONSTANT_FOLDED_BORDERS) {
+                const TString bordersName = "CatboostBorders" + ToString(binarizedId);
+                Out << "std::lower_bound(" << bordersName << ", " << bordersName << " + " << borders.size() << ", value) - " << bordersName;
+            } else {
+                for (size_t borderId : xrange(borders.size())) {
+                    Out << (borderId == 0 ? "" : " + ") << "(value > " << floatLiteral(borders[borderId]) << ")";
+                }
+            }
+            Out << ");" << '\n';
+        }
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << '\n';
+
+        const auto treeSplits = trees.GetTreeSplits();
+        Out << indent << "/* Split is true if binarized value of feature CatboostSplitFeatures[i] is greater than CatboostSplitBorders[i] */" << '\n';
+        Out << indent << "const unsigned short CatboostSplitFeatures[" << Max<size_t>(treeSplits.size(), 1) << "] = {"
+            << OutputArrayInitializer([&] (size_t i) { return binaryFeatureToBinarized[treeSplits[i]]; }, treeSplits.size()) << "};" << '\n';
+        Out << indent << "const TCatboostBin CatboostSplitBorders[" << Max<size_t>(treeSplits.size(), 1) << "] = {"
+            << OutputArrayInitializer([&] (size_t i) { return binaryFeatureToBorder[treeSplits[i]]; }, treeSplits.size()) << "};" << '\n';
+        Out << '\n';
+
+        struct TTreeRun {
+            int Depth;
+            size_t TreeCount;
+            size_t SplitsOffset;
+            size_t LeafValuesOffset;
+        };
+        TVector<TTreeRun> treeRuns;
+        TSet<int> runDepths;
+        for (size_t treeId : xrange(treeSizes.size())) {
+            if (treeRuns.empty() || treeRuns.back().Depth != treeSizes[treeId]) {
+                treeRuns.push_back({treeSizes[treeId], 0, (size_t)trees.GetTreeStartOffsets()[treeId], trees.GetFirstLeafOffsets()[treeId]});
+                runDepths.insert(treeSizes[treeId]);
+            }
+            ++treeRuns.back().TreeCount;
+        }
+        Out << indent << "/* Consecutive trees of the same depth are evaluated by the same depth-specialized code */" << '\n';
+        Out << indent++ << "struct TCatboostTreeRun {" << '\n';
+        Out << indent << "unsigned int Depth;" << '\n';
+        Out << indent << "unsigned int TreeCount;" << '\n';
+        Out << indent << "unsigned int SplitsOffset;" << '\n';
+        Out << indent << "unsigned int LeafValuesOffset;" << '\n';
+        Out << --indent << "};" << '\n';
+        Out << indent << "const TCatboostTreeRun CatboostTreeRuns[" << Max<size_t>(treeRuns.size(), 1) << "] = {"
+            << OutputArrayInitializer(
+                [&] (size_t i) {
+                    const auto& run = treeRuns[i];
+                    return TStringBuilder() << "{" << run.Depth << ", " << run.TreeCount << ", " << run.SplitsOffset << ", " << run.LeafValuesOffset << "}";
+                },
+                treeRuns.size())
+            << "};" << '\n';
+        Out << '\n';
+        Out << indent << "/* Leaf values packed per tree, each tree is represented by a separate line: */" << '\n';
+        Out << indent << "const double CatboostLeafValues[" << Max<size_t>(trees.GetLeafValues().size(), 1) << "] = {" << OutputLeafValues(model, indent);
+        Out << indent << "};" << '\n';
+        Out << indent << "const double CatboostScale = " << model.GetScaleAndBias().Scale << ";" << '\n';
+        Out << indent << "const double CatboostBias = " << model.GetScaleAndBias().Bias << ";" << '\n';
+        Out << '\n';
+
+        Out << indent << "template <unsigned int Depth>" << '\n';
+        Out << indent++ << "void CatboostApplyTreeRun(const TCatboostTreeRun& run, const TCatboostBin* bins, size_t docCount, TCatboostLeafIndex* indexes, double* results) {" << '\n';
+        Out << indent << "const unsigned short* splitFeatures = CatboostSplitFeatures + run.SplitsOffset;" << '\n';
+        Out << indent << "const TCatboostBin* splitBorders = CatboostSplitBorders + run.SplitsOffset;" << '\n';
+        Out << indent << "const double* leafValues = CatboostLeafValues + run.LeafValuesOffset;" << '\n';
+        Out << indent++ << "for (unsigned int treeId = 0; treeId < run.TreeCount; ++treeId) {" << '\n';
+        Out << indent++ << "for (size_t docId = 0; docId < docCount; ++docId) {" << '\n';
+        Out << indent << "indexes[docId] = 0;" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << indent << "/* Depth is a compile time constant, so this loop is unrolled */" << '\n';
+        Out << indent++ << "for (unsigned int depth = 0; depth < Depth; ++depth) {" << '\n';
+        Out << indent << "const TCatboostBin* featureBins = bins + splitFeatures[depth] * docCount;" << '\n';
+        Out << indent << "const TCatboostBin border = splitBorders[depth];" << '\n';
+        Out << indent++ << "for (size_t docId = 0; docId < docCount; ++docId) {" << '\n';
+        Out << indent << "indexes[docId] |= (TCatboostLeafIndex)((featureBins[docId] > border) << depth);" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << indent++ << "for (size_t docId = 0; docId < docCount; ++docId) {" << '\n';
+        Out << indent << "results[docId] += leafValues[indexes[docId]];" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << indent << "splitFeatures += Depth;" << '\n';
+        Out << indent << "splitBorders += Depth;" << '\n';
+        Out << indent << "leafValues += (1u << Depth);" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << '\n';
+
+        Out << indent++ << "void CatboostApplyTrees(const TCatboostBin* bins, size_t docCount, TCatboostLeafIndex* indexes, double* results) {" << '\n';
+        Out << indent++ << "for (const TCatboostTreeRun& run : CatboostTreeRuns) {" << '\n';
+        Out << indent++ << "switch (run.Depth) {" << '\n';
+        for (int depth : runDepths) {
+            Out << indent++ << "case " << depth << ":" << '\n';
+            Out << indent << "CatboostApplyTreeRun<" << depth << ">(run, bins, docCount, indexes, results);" << '\n';
+            Out << indent-- << "break;" << '\n';
+        }
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << --indent << "}" << '\n';
+        Out << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteOptimizedApplicator() {
+        Out << "/* Model applicator */" << '\n';
+        Out << "/* features of i-th document are features[i * featureStride], ..., features[i * featureStride + featureStride - 1] */" << '\n';
+        Out << "void ApplyCatboostModel(" << '\n';
+        Out << "    const float* features," << '\n';
+        Out << "    size_t docCount," << '\n';
+        Out << "    size_t featureStride," << '\n';
+        Out << "    double* results" << '\n';
+        Out << ") {" << '\n';
+        Out << "    std::vector<TCatboostBin> bins(CatboostBinarizedFeatureCount * std::min(docCount, CatboostBlockSize));" << '\n';
+        Out << "    std::vector<TCatboostLeafIndex> indexes(std::min(docCount, CatboostBlockSize));" << '\n';
+        Out << "    for (size_t blockStart = 0; blockStart < docCount; blockStart += CatboostBlockSize) {" << '\n';
+        Out << "        const size_t blockSize = std::min(CatboostBlockSize, docCount - blockStart);" << '\n';
+        Out << "        double* blockResults = results + blockStart;" << '\n';
+        Out << "        CatboostBinarizeBlock(features + blockStart * featureStride, featureStride, blockSize, bins.data());" << '\n';
+        Out << "        for (size_t docId = 0; docId < blockSize; ++docId) {" << '\n';
+        Out << "            blockResults[docId] = 0.0;" << '\n';
+        Out << "        }" << '\n';
+        Out << "        CatboostApplyTrees(bins.data(), blockSize, indexes.data(), blockResults);" << '\n';
+        Out << "        for (size_t docId = 0; docId < blockSize; ++docId) {" << '\n';
+        Out << "            blockResults[docId] = CatboostScale * blockResults[docId] + CatboostBias;" << '\n';
+        Out << "        }" << '\n';
+        Out << "    }" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& features" << '\n';
+        Out << ") {" << '\n';
+        Out << "    double result = 0.0;" << '\n';
+        Out << "    ApplyCatboostModel(features.data(), 1, features.size(), &result);" << '\n';
+        Out << "    return result;" << '\n';
+        Out << "}" << '\n';
+
+        // Also emit the API with catFeatures, for uniformity
+        Out << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& floatFeatures," << '\n';
+        Out << "    const std::vector<std::string>&" << '\n';
+        Out << ") {" << '\n';
+        Out << "    return ApplyCatboostModel(floatFeatures);" << '\n';
+        Out << "}" << '\n';
+    }
 }
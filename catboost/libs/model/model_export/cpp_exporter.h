@@ -11,16 +11,20 @@ namespace NCB {
     class TCatboostModelToCppConverter: public ICatboostModelExporter {
     private:
         TOFStream Out;
+        //! Emit code specialized for the model instead of readable generic applicator
+        bool Optimized = false;
 
     public:
-        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson)
-            : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
-        {
-            CB_ENSURE(userParametersJson.empty(), "JSON user params for exporting the model to C++ are not supported");
-        };
+        /**
+         * @param userParametersJson may contain "cpp_export_mode": "readable" (default) or "optimized"
+         */
+        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson);
 
         void Write(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString = nullptr) override {
-            if (model.HasCategoricalFeatures()) {
+            if (Optimized) {
+                WriteOptimizedModel(model);
+                WriteOptimizedApplicator();
+            } else if (model.HasCategoricalFeatures()) {
                 WriteHeader(/*forCatFeatures*/true);
                 WriteModelCatFeatures(model, catFeaturesHashToString);
                 WriteApplicatorCatFeatures();
@@ -38,5 +42,7 @@ namespace NCB {
         void WriteCTRStructs();
         void WriteModelCatFeatures(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString);
         void WriteApplicatorCatFeatures();
+        void WriteOptimizedModel(const TFullModel& model);
+        void WriteOptimizedApplicator();
     };
 }
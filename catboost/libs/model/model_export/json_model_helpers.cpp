@@ -493,10 +493,10 @@ static NJson::TJsonValue ConvertCtrsToJson(const TStaticCtrProvider* ctrProvider
         for (const auto& ctr: compressedModelCtrs[idx].ModelCtrs) {
             NJson::TJsonValue hashValue;
             auto& learnCtr = ctrProvider->CtrData.LearnCtrs.at(ctr->Base);
-            auto hashIndexResolver = learnCtr.GetIndexHashViewer();
+            const TVector<NCatboost::TBucket> indexBuckets = learnCtr.GetLinearIndexBuckets();
             const ECtrType ctrType = ctr->Base.CtrType;
             TSet<ui64> hashIndexes;
-            for (const auto& bucket: hashIndexResolver.GetBuckets()) {
+            for (const auto& bucket: indexBuckets) {
                 auto value = bucket.IndexValue;
                 if (value == NCatboost::TDenseIndexHashView::NotFoundIndex) {
                     continue;
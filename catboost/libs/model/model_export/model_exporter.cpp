@@ -7,6 +7,8 @@
 #include "pmml_helpers.h"
 #include "python_exporter.h"
 
+#include <catboost/libs/model/static_ctr_provider.h>
+
 #include <catboost/private/libs/options/output_file_options.h>
 
 #include <library/json/json_reader.h>
@@ -15,6 +17,7 @@
 #include <contrib/libs/coreml/Model.pb.h>
 
 #include <util/string/builder.h>
+#include <util/string/cast.h>
 
 namespace NCB {
     ICatboostModelExporter* CreateCatboostModelExporter(const TString& modelFile, const EModelType format, const TString& userParametersJson, bool addFileFormatExtension) {
@@ -111,6 +114,29 @@ namespace NCB {
         out.Write(data);
     }
 
+    static void OutputCatboostBinaryModel(
+        const TFullModel& model,
+        const TString& modelFile,
+        const NJson::TJsonValue& userParameters) {
+
+        for (const auto& [name, value] : userParameters.GetMap()) {
+            Y_UNUSED(value);
+            CB_ENSURE(name == "ctr_index_layout", "JSON user param " << name << " for CatBoost model export is not supported");
+        }
+        const auto* ctrProvider = dynamic_cast<const TStaticCtrProvider*>(model.CtrProvider.Get());
+        if (!userParameters.Has("ctr_index_layout") || !ctrProvider) {
+            OutputModel(model, modelFile);
+            return;
+        }
+        const auto layout = FromString<ECtrTableIndexLayout>(userParameters["ctr_index_layout"].GetStringSafe());
+        TIntrusivePtr<TStaticCtrProvider> convertedCtrProvider = new TStaticCtrProvider();
+        convertedCtrProvider->CtrData = ctrProvider->CtrData;
+        convertedCtrProvider->SetCtrIndexLayout(layout);
+        TFullModel convertedModel = model;
+        convertedModel.CtrProvider = convertedCtrProvider;
+        OutputModel(convertedModel, modelFile);
+    }
+
     void ExportModel(
         const TFullModel& model,
         const TString& modelFile,
@@ -132,11 +158,14 @@ namespace NCB {
         const auto modelFileName = NCatboostOptions::AddExtension(format, modelFile, addFileFormatExtension);
         switch (format) {
             case EModelType::CatboostBinary:
-                CB_ENSURE(
-                    userParametersJson.empty(),
-                    "JSON user params for CatBoost model export are not supported"
-                );
-                OutputModel(model, modelFileName);
+                {
+                    NJson::TJsonValue params;
+                    if (!userParametersJson.empty()) {
+                        TStringInput is(userParametersJson);
+                        NJson::ReadJsonTree(&is, &params);
+                    }
+                    OutputCatboostBinaryModel(model, modelFileName, params);
+                }
                 break;
             case EModelType::AppleCoreML:
                 {
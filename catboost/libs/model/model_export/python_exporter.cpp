@@ -113,7 +113,7 @@ namespace NCB {
             out << indent << orderedLearnCtr.first << " :" << '\n';
             out << indent++ << "catboost_ctr_value_table(" << '\n';
             out << indent << "index_hash_viewer = {";
-            const TConstArrayRef<NCatboost::TBucket> HashViewerBuckets = learnCtrValueTable.GetIndexHashViewer().GetBuckets();
+            const TVector<NCatboost::TBucket> HashViewerBuckets = learnCtrValueTable.GetLinearIndexBuckets();
             commaInner.ResetCount(HashViewerBuckets.size());
             for (const auto& bucket : HashViewerBuckets) {
                 out << bucket.Hash << " : " << bucket.IndexValue << commaInner;
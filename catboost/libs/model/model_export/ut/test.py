@@ -92,6 +92,59 @@ def test_cpp_export(dataset, parameters):
             raise
 
 
+@pytest.mark.parametrize('iterations', [2, 100])
+def test_cpp_export_optimized(iterations):
+    train_path, test_path, cd_path = _get_train_test_cd_path('higgs')
+    model_cbm = yatest.common.test_output_path('model.bin')
+    yatest.common.execute([
+        CATBOOST_APP_PATH, 'fit',
+        '-f', train_path,
+        '--cd', cd_path,
+        '-i', str(iterations),
+        '-r', '1234',
+        '-m', model_cbm,
+    ])
+    model = CatBoost()
+    model.load_model(model_cbm)
+    model_cpp = yatest.common.test_output_path('model.cpp')
+    model.save_model(model_cpp, format='cpp', export_parameters={'cpp_export_mode': 'optimized'})
+
+    applicator_cpp = yatest.common.source_path('catboost/libs/model/model_export/ut/applicator.cpp')
+    applicator_exe = yatest.common.test_output_path('applicator.exe')
+    predictions_by_catboost_path = yatest.common.test_output_path('predictions_by_catboost.txt')
+    predictions_path = yatest.common.test_output_path('predictions.txt')
+
+    if os.name == 'posix':
+        compile_cmd = ['g++', '-std=c++14', '-O2', '-o', applicator_exe]
+    else:
+        compile_cmd = ['cl.exe', '-O2', '-Fe' + applicator_exe]
+    compile_cmd += [applicator_cpp, model_cpp]
+    apply_cmd = [applicator_exe, test_path, cd_path, predictions_path]
+    calc_cmd = [CATBOOST_APP_PATH, 'calc',
+                '-m', model_cbm,
+                '--input-path', test_path,
+                '--cd', cd_path,
+                '--output-path', predictions_by_catboost_path,
+                ]
+    compare_cmd = [APPROXIMATE_DIFF_PATH,
+                   '--have-header',
+                   '--diff-limit', '1e-6',
+                   predictions_path,
+                   predictions_by_catboost_path,
+                   ]
+
+    try:
+        yatest.common.execute(compile_cmd)
+        yatest.common.execute(apply_cmd)
+        yatest.common.execute(calc_cmd)
+        yatest.common.execute(compare_cmd)
+    except OSError as e:
+        if re.search(r"No such file or directory.*'{}'".format(re.escape(compile_cmd[0])), str(e)):
+            pytest.xfail(reason='We ignore `compiler not found` error: {}\n'.format(str(e)))
+        else:
+            raise
+
+
 def test_read_model_after_train():
     train_path, test_path, cd_path = _get_train_test_cd_path('adult')
     eval_file = yatest.common.test_output_path('eval-file')
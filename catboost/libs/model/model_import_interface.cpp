@@ -13,6 +13,13 @@ namespace NCB {
             CheckModel(&model);
             return model;
         }
+        TFullModel ReadModelMapped(const TString& modelPath) const override {
+            CB_ENSURE(NFs::Exists(modelPath), "Model file doesn't exist: " << modelPath);
+            TFullModel model;
+            model.LoadMapped(TBlob::FromFile(modelPath));
+            CheckModel(&model);
+            return model;
+        }
     };
 
     NCB::TModelLoaderFactory::TRegistrator<TBinaryModelLoader> BinaryModelLoaderRegistrator(EModelType::CatboostBinary);
@@ -25,6 +25,10 @@ namespace NCB {
             TBufferInput bs(buf);
             return ReadModel(&bs);
         }
+        virtual TFullModel ReadModelMapped(const TString& modelPath) const {
+            Y_UNUSED(modelPath);
+            ythrow TCatBoostException() << "Memory-mapped loading is supported only for models in CatboostBinary format";
+        }
         virtual ~IModelLoader() = default;
     protected:
         void CheckModel(TFullModel* model) const;
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <util/system/types.h>
+
+/**
+ * Split of oblivious tree in evaluation friendly form.
+ * Plain data without dependencies, so it can be used in code compiled with extended instruction sets.
+ */
+struct TRepackedBin {
+    ui16 FeatureIndex = 0;
+    ui8 XorMask = 0;
+    ui8 SplitIdx = 0;
+};
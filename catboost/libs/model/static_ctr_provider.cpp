@@ -2,6 +2,7 @@
 
 #include "ctr_helpers.h"
 
+#include <util/generic/deque.h>
 #include <util/generic/xrange.h>
 #include <util/string/cast.h>
 
@@ -17,7 +18,7 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
     auto compressedModelCtrs = NCB::CompressModelCtrs(neededCtrs);
     size_t samplesCount = docCount;
     TVector<ui64> ctrHashes(samplesCount);
-    TVector<ui64> buckets(samplesCount);
+    TVector<ui32> buckets(samplesCount);
     size_t resultIdx = 0;
     float* resultPtr = result.data();
     TVector<int> transposedCatFeatureIndexes;
@@ -38,11 +39,12 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
         CalcHashes(binarizedFeatures, hashedCatFeatures, transposedCatFeatureIndexes, binarizedIndexes, docCount, &ctrHashes);
         for (const auto& ctr: compressedModelCtrs[idx].ModelCtrs) {
             auto& learnCtr = CtrData.LearnCtrs.at(ctr->Base);
-            auto hashIndexResolver = learnCtr.GetIndexHashViewer();
             const ECtrType ctrType = ctr->Base.CtrType;
             auto ptrBuckets = buckets.data();
-            for (size_t docId = 0; docId < samplesCount; ++docId) {
-                ptrBuckets[docId] = hashIndexResolver.GetIndex(ctrHashes[docId]);
+            if (learnCtr.GetIndexLayout() == ECtrTableIndexLayout::CacheLineBuckets) {
+                learnCtr.GetBucketGroupIndexHashViewer().GetIndexes(ctrHashes, buckets);
+            } else {
+                learnCtr.GetIndexHashViewer().GetIndexes(ctrHashes, buckets);
             }
             if (ctrType == ECtrType::BinarizedTargetMeanValue || ctrType == ECtrType::FloatTargetMeanValue) {
                 const auto emptyVal = ctr->Calc(0.f, 0.f);
@@ -74,7 +76,7 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                     if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                         int goodCount = 0;
                         int totalCount = 0;
-                        auto ctrHistory = MakeArrayRef(ctrIntArray.data() + ptrBuckets[doc] * targetClassesCount, targetClassesCount);
+                        auto ctrHistory = MakeArrayRef(ctrIntArray.data() + size_t(ptrBuckets[doc]) * targetClassesCount, targetClassesCount);
                         goodCount = ctrHistory[ctr->TargetBorderIdx];
                         for (int classId = 0; classId < targetClassesCount; ++classId) {
                             totalCount += ctrHistory[classId];
@@ -94,7 +96,7 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                         int goodCount = 0;
                         int totalCount = 0;
                         if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
-                            auto ctrHistory = MakeArrayRef(ctrIntArray.data() + ptrBuckets[doc] * targetClassesCount, targetClassesCount);
+                            auto ctrHistory = MakeArrayRef(ctrIntArray.data() + size_t(ptrBuckets[doc]) * targetClassesCount, targetClassesCount);
                             for (int classId = 0; classId < ctr->TargetBorderIdx + 1; ++classId) {
                                 totalCount += ctrHistory[classId];
                             }
@@ -108,7 +110,7 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                 } else {
                     for (size_t doc = 0; doc < samplesCount; ++doc) {
                         if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
-                            const int* ctrHistory = &ctrIntArray[ptrBuckets[doc] * 2];
+                            const int* ctrHistory = &ctrIntArray[size_t(ptrBuckets[doc]) * 2];
                             resultPtr[doc + resultIdx] = ctr->Calc(ctrHistory[1], ctrHistory[0] + ctrHistory[1]);
                         } else {
                             resultPtr[doc + resultIdx] = emptyVal;
@@ -293,9 +295,17 @@ TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(const TVector<cons
         return result;
     }
     THashMap<TModelCtrBase, TVector<const TCtrValueTable*>> valuesMap;
+    // merging works with linear indexes only
+    TDeque<TCtrValueTable> linearTables;
     for (const auto& provider: providers) {
         for (const auto& [ctrBase, ctrValueTables] : provider->CtrData.LearnCtrs) {
-            valuesMap[ctrBase].push_back(&ctrValueTables);
+            if (ctrValueTables.GetIndexLayout() == ECtrTableIndexLayout::Linear) {
+                valuesMap[ctrBase].push_back(&ctrValueTables);
+            } else {
+                linearTables.push_back(ctrValueTables);
+                linearTables.back().SetIndexLayout(ECtrTableIndexLayout::Linear);
+                valuesMap[ctrBase].push_back(&linearTables.back());
+            }
         }
     }
     for (const auto& [ctrBase, ctrValueTables] : valuesMap) {
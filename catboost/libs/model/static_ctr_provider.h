@@ -75,6 +75,14 @@ public:
 
     virtual TIntrusivePtr<ICtrProvider> Clone() const override;
 
+    //! Rebuild hash indexes of all CTR tables in `layout`, see TCtrValueTable::SetIndexLayout
+    void SetCtrIndexLayout(ECtrTableIndexLayout layout) {
+        for (auto& [ctrBase, valueTable] : CtrData.LearnCtrs) {
+            Y_UNUSED(ctrBase);
+            valueTable.SetIndexLayout(layout);
+        }
+    }
+
 public:
     TCtrData CtrData;
 private:
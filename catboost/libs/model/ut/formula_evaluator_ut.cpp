@@ -6,8 +6,11 @@
 #include <catboost/libs/train_lib/train_model.h>
 #include <catboost/private/libs/text_features/ut/lib/text_features_data.h>
 
+#include <library/threading/local_executor/local_executor.h>
 #include <library/unittest/registar.h>
 
+#include <util/string/cast.h>
+
 using namespace NCB;
 using namespace NCB::NModelEvaluation;
 
@@ -32,6 +35,40 @@ TVector<TConstArrayRef<float>> GetFeatureRef(const TVector<TVector<float>>& data
 
 const auto FLOAT_FEATURES = GetFeatureRef(DATA);
 
+// depths of trees are 2, 3, ..., 8, 2, 3, ...
+static TFullModel ManyShallowTreesModel(size_t featureCount = 8, size_t treeCount = 7) {
+    TFullModel model;
+    TModelTrees* trees = model.ModelTrees.GetMutable();
+    for (size_t featureIndex : xrange(featureCount)) {
+        trees->AddFloatFeature(TFloatFeature(false, featureIndex, featureIndex, {0.25f, 0.5f, 0.75f}, ""));
+    }
+    for (size_t treeId : xrange(treeCount)) {
+        const size_t treeDepth = treeId % 7 + 2;
+        TVector<int> tree;
+        for (size_t depth : xrange(treeDepth)) {
+            tree.push_back(((treeId + depth) % featureCount) * 3 + depth % 3);
+        }
+        trees->AddBinTree(tree);
+        for (size_t leafId : xrange(1 << treeDepth)) {
+            trees->AddLeafValue(leafId * 0.5 + treeId);
+        }
+    }
+    model.UpdateDynamicData();
+    return model;
+}
+
+static TVector<TVector<float>> ManyDocumentsData(size_t docCount, size_t featureCount = 8) {
+    TVector<TVector<float>> data;
+    for (size_t docId : xrange(docCount)) {
+        TVector<float> docFeatures;
+        for (size_t featureIndex : xrange(featureCount)) {
+            docFeatures.push_back(((docId * 7 + featureIndex * 13) % 100) / 100.f);
+        }
+        data.push_back(std::move(docFeatures));
+    }
+    return data;
+}
+
 void CheckFlatCalcResult(
     const TFullModel& model,
     const TVector<double>& expectedPredicts,
@@ -128,6 +165,220 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         CheckFlatCalcResult(model, expectedPredicts, expectedLeafIndexes, features);
     }
 
+    Y_UNIT_TEST(TestBlockedCalcMatchesSingleDocCalc) {
+        // enough documents and trees to run wide SIMD kernels on full registers and on tails
+        const auto model = ManyShallowTreesModel();
+        const auto data = ManyDocumentsData(2 * FORMULA_EVALUATION_BLOCK_SIZE + 37);
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> predicts(data.size());
+        model.CalcFlat(features, predicts);
+        for (size_t docId : xrange(data.size())) {
+            double singlePredict = 0;
+            model.CalcFlatSingle(features[docId], MakeArrayRef(&singlePredict, 1));
+            UNIT_ASSERT_VALUES_EQUAL(singlePredict, predicts[docId]);
+        }
+    }
+
+    Y_UNIT_TEST(TestManyBordersBinarization) {
+        // features with many borders are binarized with binary search, splits are in different bins of 254 borders
+        const size_t borderCount = 1000;
+        TVector<float> borders;
+        for (size_t borderId : xrange(borderCount)) {
+            borders.push_back(borderId * 0.001f);
+        }
+        const TVector<int> splitBorderIds = {3, 253, 254, 700, 999};
+        for (auto nanTreatment : {TFloatFeature::ENanValueTreatment::AsIs, TFloatFeature::ENanValueTreatment::AsTrue}) {
+            TFullModel model;
+            TModelTrees* trees = model.ModelTrees.GetMutable();
+            TFloatFeature feature(true, 0, 0, borders, "");
+            feature.NanValueTreatment = nanTreatment;
+            trees->AddFloatFeature(feature);
+            trees->AddBinTree(splitBorderIds);
+            for (size_t leafId : xrange(1 << splitBorderIds.size())) {
+                trees->AddLeafValue(leafId);
+            }
+            model.UpdateDynamicData();
+            UNIT_ASSERT(!model.ModelTrees->GetFloatFeatureBorderSearchTrees()[0].empty());
+
+            TVector<TVector<float>> data;
+            TVector<double> expectedPredicts;
+            for (size_t docId : xrange(3 * FORMULA_EVALUATION_BLOCK_SIZE + 11)) {
+                float value = docId * 0.0027f - 0.1f;
+                if (docId % 10 == 0) {
+                    value = borders[docId % borderCount];
+                } else if (docId % 17 == 0) {
+                    value = std::numeric_limits<float>::quiet_NaN();
+                }
+                const float binarizedValue = (IsNan(value) && nanTreatment == TFloatFeature::ENanValueTreatment::AsTrue)
+                    ? std::numeric_limits<float>::infinity()
+                    : value;
+                size_t leafId = 0;
+                for (size_t depth : xrange(splitBorderIds.size())) {
+                    leafId |= size_t(binarizedValue > borders[splitBorderIds[depth]]) << depth;
+                }
+                data.push_back({value});
+                expectedPredicts.push_back(leafId);
+            }
+            TVector<double> predicts(data.size());
+            model.CalcFlat(GetFeatureRef(data), predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+    }
+
+    Y_UNIT_TEST(TestBlockSizeProperty) {
+        const auto model = ManyShallowTreesModel();
+        const auto data = ManyDocumentsData(3 * FORMULA_EVALUATION_BLOCK_SIZE + 5);
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> expectedPredicts(data.size());
+        model.CalcFlat(features, expectedPredicts);
+
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        for (TStringBuf blockSize : {"1", "16", "40", "128", "300", "1024", "Auto"}) {
+            evaluator->SetProperty("BlockSize", blockSize);
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+        UNIT_ASSERT_EXCEPTION(evaluator->SetProperty("BlockSize", "0"), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(evaluator->SetProperty("BlockSize", "100500"), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(evaluator->SetProperty("UnknownProperty", "1"), TCatBoostException);
+
+        const size_t autoBlockSize = GetCacheFriendlyBlockSize(*model.ModelTrees);
+        UNIT_ASSERT(autoBlockSize > 0 && autoBlockSize <= FORMULA_EVALUATION_BLOCK_SIZE);
+    }
+
+    Y_UNIT_TEST(TestEvaluationSchedules) {
+        // leaf values of this model don't fit into L2 cache
+        const auto model = ManyShallowTreesModel(8, 10000);
+        UNIT_ASSERT(GetCacheFriendlyTreeGroupSize(*model.ModelTrees) != 0);
+        const auto data = ManyDocumentsData(4 * FORMULA_EVALUATION_BLOCK_SIZE + 3);
+        const auto features = GetFeatureRef(data);
+
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        evaluator->SetProperty("Schedule", "DocMajor");
+        TVector<double> expectedPredicts(data.size());
+        evaluator->CalcFlat(features, expectedPredicts);
+        for (TStringBuf schedule : {"TreeMajor", "Auto"}) {
+            evaluator->SetProperty("Schedule", schedule);
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+        UNIT_ASSERT_EXCEPTION(evaluator->SetProperty("Schedule", "Random"), TCatBoostException);
+
+        const auto schedule = GetEvaluationSchedule(*model.ModelTrees, data.size(), EEvaluationSchedule::TreeMajor);
+        UNIT_ASSERT(schedule.TreeGroupSize != 0);
+        UNIT_ASSERT(schedule.BlockSize >= FORMULA_EVALUATION_BLOCK_SIZE);
+        UNIT_ASSERT_VALUES_EQUAL(GetEvaluationSchedule(*model.ModelTrees, data.size()).TreeGroupSize, 0);
+        UNIT_ASSERT_VALUES_EQUAL(GetEvaluationSchedule(*model.ModelTrees, 1).TreeGroupSize, 0);
+    }
+
+    Y_UNIT_TEST(TestDefaultScheduleMatchesDocMajor) {
+        const auto model = ManyShallowTreesModel(8, 10000);
+        const auto data = ManyDocumentsData(5 * FORMULA_EVALUATION_BLOCK_SIZE + 11);
+        const auto features = GetFeatureRef(data);
+
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        TVector<double> defaultPredicts(data.size());
+        evaluator->CalcFlat(features, defaultPredicts);
+
+        evaluator->SetProperty("Schedule", "DocMajor");
+        evaluator->SetProperty("BlockSize", ToString(FORMULA_EVALUATION_BLOCK_SIZE));
+        TVector<double> docMajorPredicts(data.size());
+        evaluator->CalcFlat(features, docMajorPredicts);
+        UNIT_ASSERT_EQUAL(docMajorPredicts, defaultPredicts);
+
+        TVector<double> singleDocPredicts(data.size());
+        for (size_t docId : xrange(data.size())) {
+            evaluator->CalcFlatSingle(features[docId], MakeArrayRef(&singleDocPredicts[docId], 1));
+        }
+        UNIT_ASSERT_EQUAL(docMajorPredicts, singleDocPredicts);
+    }
+
+    Y_UNIT_TEST(TestParallelCalc) {
+        auto model = ManyShallowTreesModel();
+        const auto data = ManyDocumentsData(10 * FORMULA_EVALUATION_BLOCK_SIZE + 7);
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> expectedPredicts(data.size());
+        model.CalcFlat(features, expectedPredicts);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        evaluator->SetLocalExecutor(&localExecutor);
+        for (auto predictionType : {EPredictionType::RawFormulaVal, EPredictionType::Probability, EPredictionType::Class}) {
+            evaluator->SetPredictionType(predictionType);
+            TVector<double> expected(data.size());
+            TVector<double> predicts(data.size());
+            auto sequentialEvaluator = evaluator->Clone();
+            sequentialEvaluator->SetLocalExecutor(nullptr);
+            sequentialEvaluator->CalcFlat(features, expected);
+            evaluator->CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expected, predicts);
+        }
+
+        evaluator->SetPredictionType(EPredictionType::RawFormulaVal);
+        evaluator->SetProperty("ThreadCount", "4");
+        {
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+
+        model.SetLocalExecutor(&localExecutor);
+        {
+            TVector<double> predicts(data.size());
+            model.CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+    }
+
+    Y_UNIT_TEST(TestFloatPrecision) {
+        // sums of half-integer leaf values exceed 2^23, so fp32 accumulation is not exact
+        auto model = ManyShallowTreesModel(8, 6000);
+        model.SetScaleAndBias({0.5, 1.0});
+        const auto data = ManyDocumentsData(2 * FORMULA_EVALUATION_BLOCK_SIZE + 37);
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> expectedPredicts(data.size());
+        model.CalcFlat(features, expectedPredicts);
+
+        const double maxDeviation = GetFloatEvaluationMaxDeviation(*model.ModelTrees);
+        UNIT_ASSERT(maxDeviation > 0 && maxDeviation < 1e-2 * Abs(expectedPredicts[0]));
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        evaluator->SetProperty("Precision", "Float");
+        for (TStringBuf schedule : {"DocMajor", "TreeMajor"}) {
+            evaluator->SetProperty("Schedule", schedule);
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            for (size_t docId : xrange(data.size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL(expectedPredicts[docId], predicts[docId], maxDeviation);
+                double singlePredict = 0;
+                evaluator->CalcFlatSingle(features[docId], MakeArrayRef(&singlePredict, 1));
+                UNIT_ASSERT_DOUBLES_EQUAL(expectedPredicts[docId], singlePredict, maxDeviation);
+            }
+        }
+        evaluator->SetProperty("Schedule", "DocMajor");
+        evaluator->SetProperty("BlockSize", "1024");
+        {
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            for (size_t docId : xrange(data.size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL(expectedPredicts[docId], predicts[docId], maxDeviation);
+            }
+        }
+        evaluator->SetProperty("BlockSize", "Auto");
+
+        evaluator->SetProperty("Precision", "Double");
+        TVector<double> predicts(data.size());
+        evaluator->CalcFlat(features, predicts);
+        UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        UNIT_ASSERT_EXCEPTION(evaluator->SetProperty("Precision", "Half"), TCatBoostException);
+    }
+
     Y_UNIT_TEST(TestFlatCalcMultiVal) {
         auto model = MultiValueFloatModel();
         TVector<TConstArrayRef<float>> features(FLOAT_FEATURES.begin(), FLOAT_FEATURES.begin() + 4);
@@ -286,4 +537,23 @@ Y_UNIT_TEST_SUITE(TNonSymmetricTreeModel) {
         deserializedModel.Load(&strStream);
         CheckFlatCalcResult(deserializedModel, canonVals, expectedLeafIndexes);
     }
+
+    Y_UNIT_TEST(TestBlockSizeProperty) {
+        const auto model = SimpleAsymmetricModel();
+        const auto data = ManyDocumentsData(3 * FORMULA_EVALUATION_BLOCK_SIZE + 5, 3);
+        const auto features = GetFeatureRef(data);
+
+        TVector<double> expectedPredicts(data.size());
+        for (size_t docId : xrange(data.size())) {
+            model.CalcFlatSingle(features[docId], MakeArrayRef(&expectedPredicts[docId], 1));
+        }
+
+        auto evaluator = CreateEvaluator(EFormulaEvaluatorType::CPU, model);
+        for (TStringBuf blockSize : {"40", "128", "300", "1024"}) {
+            evaluator->SetProperty("BlockSize", blockSize);
+            TVector<double> predicts(data.size());
+            evaluator->CalcFlat(features, predicts);
+            UNIT_ASSERT_EQUAL(expectedPredicts, predicts);
+        }
+    }
 }
@@ -2,6 +2,7 @@
 #include <catboost/libs/model/features.h>
 #include <catboost/libs/model/model.h>
 #include <catboost/libs/model/model_build_helper.h>
+#include <catboost/libs/model/static_ctr_provider.h>
 #include <catboost/libs/model/model_export/json_model_helpers.h>
 #include <catboost/libs/model/model_export/model_exporter.h>
 #include <catboost/libs/train_lib/train_model.h>
@@ -39,6 +40,54 @@ Y_UNIT_TEST_SUITE(TModelSerialization) {
         DoSerializeDeserialize(trainedModel);
     }
 
+    Y_UNIT_TEST(TestReadModelMapped) {
+        TFullModel trainedModel = TrainCatOnlyModel();
+        OutputModel(trainedModel, "mapped_model.bin");
+        {
+            TFullModel mappedModel = ReadModelMapped("mapped_model.bin");
+            UNIT_ASSERT(mappedModel.ModelTrees->HasExternalLeafValues());
+            UNIT_ASSERT_EQUAL(trainedModel, mappedModel);
+            UNIT_ASSERT_EQUAL(SerializeModel(trainedModel), SerializeModel(mappedModel));
+
+            TVector<TConstArrayRef<float>> floatFeatures(3);
+            TVector<TVector<TStringBuf>> catFeatures = {{"a", "d", "g"}, {"b", "e", "h"}, {"c", "f", "k"}};
+            TVector<double> expectedPredictions(3);
+            trainedModel.Calc(floatFeatures, catFeatures, expectedPredictions);
+            TVector<double> predictions(3);
+            mappedModel.Calc(floatFeatures, catFeatures, predictions);
+            UNIT_ASSERT_EQUAL(expectedPredictions, predictions);
+
+            // modification of mapped model copies leaf values
+            mappedModel.Truncate(0, 2);
+            UNIT_ASSERT(!mappedModel.ModelTrees->HasExternalLeafValues());
+        }
+    }
+
+    Y_UNIT_TEST(TestCtrIndexLayoutExport) {
+        TFullModel trainedModel = TrainCatOnlyModel();
+        ExportModel(
+            trainedModel,
+            "bucket_groups_model.bin",
+            EModelType::CatboostBinary,
+            "{\"ctr_index_layout\": \"CacheLineBuckets\"}");
+
+        TVector<TConstArrayRef<float>> floatFeatures(3);
+        TVector<TVector<TStringBuf>> catFeatures = {{"a", "d", "g"}, {"b", "e", "h"}, {"c", "f", "k"}};
+        TVector<double> expectedPredictions(3);
+        trainedModel.Calc(floatFeatures, catFeatures, expectedPredictions);
+        for (TFullModel model : {ReadModel("bucket_groups_model.bin"), ReadModelMapped("bucket_groups_model.bin")}) {
+            const auto* ctrProvider = dynamic_cast<const TStaticCtrProvider*>(model.CtrProvider.Get());
+            UNIT_ASSERT(ctrProvider);
+            for (const auto& [ctrBase, valueTable] : ctrProvider->CtrData.LearnCtrs) {
+                Y_UNUSED(ctrBase);
+                UNIT_ASSERT_EQUAL(valueTable.GetIndexLayout(), ECtrTableIndexLayout::CacheLineBuckets);
+            }
+            TVector<double> predictions(3);
+            model.Calc(floatFeatures, catFeatures, predictions);
+            UNIT_ASSERT_EQUAL(expectedPredictions, predictions);
+        }
+    }
+
     Y_UNIT_TEST(TestSerializeDeserializeCoreML) {
         TFullModel trainedModel = TrainFloatCatboostModel();
         TStringStream strStream;
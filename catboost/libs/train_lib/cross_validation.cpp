@@ -24,6 +24,7 @@
 #include <catboost/private/libs/options/plain_options_helper.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
 #include <util/generic/scope.h>
 #include <util/generic/ymath.h>
@@ -44,6 +45,37 @@ TVector<TArraySubsetIndexing<ui32>> CalcTrainSubsets(
     const TVector<TArraySubsetIndexing<ui32>>& testSubsets,
     ui32 groupCount
 ) {
+    const bool allTestSubsetsAreRanges = AllOf(
+        testSubsets,
+        [] (const TArraySubsetIndexing<ui32>& testSubset) {
+            return HoldsAlternative<TRangesSubset<ui32>>(testSubset);
+        }
+    );
+    if (allTestSubsetsAreRanges) {
+        /* train subsets are unions of a few ranges, keep them as blocks instead of index vectors,
+         * so folds' data are cheap views of the source data
+         */
+        TVector<TArraySubsetIndexing<ui32>> result;
+        for (ui32 fold = 0; fold < testSubsets.size(); ++fold) {
+            TVector<TSubsetBlock<ui32>> trainBlocks;
+            ui32 dstBegin = 0;
+            for (ui32 testFold = 0; testFold < testSubsets.size(); ++testFold) {
+                if (testFold == fold) {
+                    continue;
+                }
+                for (const auto& block : testSubsets[testFold].Get<TRangesSubset<ui32>>().Blocks) {
+                    if (!trainBlocks.empty() && (trainBlocks.back().SrcEnd == block.SrcBegin)) {
+                        trainBlocks.back().SrcEnd = block.SrcEnd;
+                    } else {
+                        trainBlocks.emplace_back(TIndexRange<ui32>(block.SrcBegin, block.SrcEnd), dstBegin);
+                    }
+                    dstBegin += block.GetSize();
+                }
+            }
+            result.push_back(TArraySubsetIndexing<ui32>(TRangesSubset<ui32>(dstBegin, std::move(trainBlocks))));
+        }
+        return result;
+    }
 
     TVector<TVector<ui32>> trainSubsetIndices(testSubsets.size());
     for (ui32 fold = 0; fold < testSubsets.size(); ++fold) {
@@ -100,6 +132,27 @@ inline bool DivisibleOrLastIteration(int currentIteration, int iterationsCount,
 }
 
 
+// training of a single model doesn't load all threads on smaller datasets, so several folds are trained at once
+constexpr ui32 MaxObjectCountForParallelFolds = 1000000;
+constexpr ui32 MinThreadCountPerFold = 4;
+
+static ui32 GetParallelFoldCount(
+    const TCrossValidationParams& cvParams,
+    ETaskType taskType,
+    ui32 objectCount,
+    ui32 threadCount
+) {
+    if (taskType != ETaskType::CPU) {
+        return 1;
+    }
+    ui32 parallelFoldCount = cvParams.ParallelFoldCount;
+    if (!parallelFoldCount) {
+        parallelFoldCount = (objectCount < MaxObjectCountForParallelFolds) ? threadCount / MinThreadCountPerFold : 1;
+    }
+    return Max<ui32>(1, Min(Min(parallelFoldCount, cvParams.FoldCount), threadCount));
+}
+
+
 /*
  * For CPU foldContexts contain LearnProgress that allows quick learning resume when switching
  *  between folds, so use one iteration batches.
@@ -615,6 +668,27 @@ void CrossValidate(
     }
 
 
+    const ui32 threadCount = SafeIntegerCast<ui32>(localExecutor->GetThreadCount() + 1);
+    const ui32 parallelFoldCount = GetParallelFoldCount(cvParams, taskType, allDataObjectCount, threadCount);
+    TVector<THolder<NPar::TLocalExecutor>> foldExecutors;
+    TVector<NCatboostOptions::TCatBoostOptions> foldCatBoostOptions; // with folds' shares of threads and RAM
+    if (parallelFoldCount > 1) {
+        for (auto slotIdx : xrange(parallelFoldCount)) {
+            const ui32 foldThreadCount
+                = threadCount / parallelFoldCount + (slotIdx < threadCount % parallelFoldCount ? 1 : 0);
+            foldExecutors.push_back(MakeHolder<NPar::TLocalExecutor>());
+            foldExecutors.back()->RunAdditionalThreads(foldThreadCount - 1);
+
+            foldCatBoostOptions.push_back(catBoostOptions);
+            foldCatBoostOptions.back().SystemOptions->NumThreads.Set(foldThreadCount);
+            foldCatBoostOptions.back().SystemOptions->CpuUsedRamLimit.Set(
+                ToString(cpuUsedRamLimit / parallelFoldCount));
+        }
+        // perfect hash is loaded from disk on first access without synchronization
+        foldContexts[0].TrainingData.Learn->ObjectsData->GetQuantizedFeaturesInfo()->LoadCatFeaturePerfectHashToRam();
+        CATBOOST_INFO_LOG << "CrossValidation: train " << parallelFoldCount << " folds at once" << Endl;
+    }
+
     EMetricBestValue bestValueType;
     float bestPossibleValue;
     metrics.front()->GetBestValue(&bestValueType, &bestPossibleValue);
@@ -696,30 +770,79 @@ void CrossValidate(
          */
         TMaybe<ui32> batchEndIteration;
 
-        for (auto foldIdx : xrange(foldContexts.size())) {
-            THPTimer timer;
-
-            TrainBatch(
-                catBoostOptions,
-                objectiveDescriptor,
-                evalMetricDescriptor,
-                labelConverter,
-                metrics,
-                skipMetricOnTrain,
-                cvParams.MaxTimeSpentOnFixedCostRatio,
-                cvParams.DevMaxIterationsBatchSize,
-                globalMaxIteration,
-                errorTracker.IsActive(),
-                loggingLevel,
-                &foldContexts[foldIdx],
-                modelTrainerHolder.Get(),
-                localExecutor,
-                &batchEndIteration);
-
-            Y_ASSERT(batchEndIteration); // should be inited right after the first iteration of the first fold
-            CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
-                << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
-                << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+        if (parallelFoldCount == 1) {
+            for (auto foldIdx : xrange(foldContexts.size())) {
+                THPTimer timer;
+
+                TrainBatch(
+                    catBoostOptions,
+                    objectiveDescriptor,
+                    evalMetricDescriptor,
+                    labelConverter,
+                    metrics,
+                    skipMetricOnTrain,
+                    cvParams.MaxTimeSpentOnFixedCostRatio,
+                    cvParams.DevMaxIterationsBatchSize,
+                    globalMaxIteration,
+                    errorTracker.IsActive(),
+                    loggingLevel,
+                    &foldContexts[foldIdx],
+                    modelTrainerHolder.Get(),
+                    localExecutor,
+                    &batchEndIteration);
+
+                Y_ASSERT(batchEndIteration); // should be inited right after the first iteration of the first fold
+                CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
+                    << ',' << *batchEndIteration << ") for fold " << foldIdx << '/' << cvParams.FoldCount
+                    << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec" << Endl;
+            }
+        } else {
+            /* CPU batches consist of one iteration, so every fold computes the same batch end by itself.
+             * Logging level is global, so it is set once here and not switched from the folds' threads.
+             */
+            for (size_t waveStart = 0; waveStart < foldContexts.size(); waveStart += parallelFoldCount) {
+                const size_t waveEnd = Min(waveStart + parallelFoldCount, foldContexts.size());
+                THPTimer timer;
+
+                TVector<TMaybe<ui32>> foldBatchEndIterations(waveEnd - waveStart);
+                {
+                    TSetLoggingSilent silentMode;
+                    localExecutor->ExecRangeWithThrow(
+                        [&] (int slotIdx) {
+                            TrainBatch(
+                                foldCatBoostOptions[slotIdx],
+                                objectiveDescriptor,
+                                evalMetricDescriptor,
+                                labelConverter,
+                                metrics,
+                                skipMetricOnTrain,
+                                cvParams.MaxTimeSpentOnFixedCostRatio,
+                                cvParams.DevMaxIterationsBatchSize,
+                                globalMaxIteration,
+                                errorTracker.IsActive(),
+                                ELoggingLevel::Silent,
+                                &foldContexts[waveStart + slotIdx],
+                                modelTrainerHolder.Get(),
+                                foldExecutors[slotIdx].Get(),
+                                &foldBatchEndIterations[slotIdx]);
+                        },
+                        0,
+                        SafeIntegerCast<int>(waveEnd - waveStart),
+                        NPar::TLocalExecutor::WAIT_COMPLETE);
+                }
+
+                for (const auto& foldBatchEndIteration : foldBatchEndIterations) {
+                    CB_ENSURE_INTERNAL(
+                        foldBatchEndIteration && (!batchEndIteration || (*foldBatchEndIteration == *batchEndIteration)),
+                        "Folds trained at once have different batch end iterations"
+                    );
+                    batchEndIteration = foldBatchEndIteration;
+                }
+                CATBOOST_INFO_LOG << "CrossValidation: Processed batch of iterations [" << batchStartIteration
+                    << ',' << *batchEndIteration << ") for folds [" << waveStart << ',' << waveEnd << ")/"
+                    << cvParams.FoldCount << " in " << FloatToString(timer.Passed(), PREC_NDIGITS, 2) << " sec"
+                    << Endl;
+            }
         }
 
         while (true) {
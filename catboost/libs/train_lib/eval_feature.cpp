@@ -667,8 +667,6 @@ static void CalcMetricsForTest(
     const auto docCount = testData->GetObjectCount();
     TVector<TVector<double>> approx;
     ResizeRank2(approxDimension, docCount, approx);
-    TVector<TVector<double>> partialApprox;
-    ResizeRank2(approxDimension, docCount, partialApprox);
     TVector<double> flatApproxBuffer;
     flatApproxBuffer.yresize(docCount * approxDimension);
 
@@ -683,17 +681,7 @@ static void CalcMetricsForTest(
         //     calculate error for each model,
         //     error on test fold idx = error on entire dataset for model idx - error on learn fold idx
         //     refactor using the Visitor pattern
-        modelCalcer.ApplyModelMulti(
-            EPredictionType::RawFormulaVal,
-            treeIdx,
-            treeIdx + 1,
-            &flatApproxBuffer,
-            &partialApprox);
-        for (auto dimensionIdx : xrange(approxDimension)) {
-            for (auto docIdx : xrange(docCount)) {
-                approx[dimensionIdx][docIdx] += partialApprox[dimensionIdx][docIdx];
-            }
-        }
+        modelCalcer.AddTreeRangeApprox(treeIdx, treeIdx + 1, &flatApproxBuffer, &approx);
         for (auto metricIdx : xrange(metricCount)) {
             metricValuesOnTest[treeIdx][metricIdx] = CalcMetric(
                 *metrics[metricIdx],
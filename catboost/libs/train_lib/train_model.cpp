@@ -39,8 +39,12 @@
 #include <catboost/private/libs/pairs/util.h>
 #include <catboost/private/libs/target/classification_target_helper.h>
 
+#include <library/chromium_trace/global.h>
+#include <library/chromium_trace/interface.h>
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
+#include <library/threading/future/future.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/cast.h>
 #include <util/generic/mapfindptr.h>
@@ -305,7 +309,9 @@ static void InitializeSamplingStructures(
                 *data.Learn->ObjectsData->GetFeaturesLayout(),
                 *data.Learn->ObjectsData->GetQuantizedFeaturesInfo(),
                 ctx->Params.CatFeatureParams->OneHotMaxSize),
-            static_cast<int>(ctx->Params.ObliviousTreeOptions->MaxDepth)
+            static_cast<int>(ctx->Params.ObliviousTreeOptions->MaxDepth),
+            GetBucketStatsCacheMemoryLimit(
+                ParseMemorySizeDescription(ctx->Params.SystemOptions->CpuUsedRamLimit.Get()))
         );
     }
     ctx->SampledDocs.Create(
@@ -330,6 +336,134 @@ static void CalcErrors(
     CalcErrors(data, metricsData.Metrics, ShouldCalcAllMetrics(iter, metricsData, *ctx), ShouldCalcErrorTrackerMetric(iter, metricsData, *ctx), ctx);
 }
 
+// Add eval metric value of the last test to error trackers, testApprox is used to remember best test approx
+static void AddErrorTrackerMetricValue(
+    ui32 iter,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    TMetricsData* metricsData,
+    TLearnContext* ctx) {
+
+    auto& errorTracker = metricsData->ErrorTracker;
+    if (!ShouldCalcErrorTrackerMetric(iter, *metricsData, *ctx) || !errorTracker) {
+        return;
+    }
+    const bool useBestModel = ctx->OutputOptions.ShrinkModelToBestIteration();
+    const auto& testErrors = ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory.back();
+    const TString& errorTrackerMetricDescription
+        = metricsData->Metrics[metricsData->ErrorTrackerMetricIdx]->GetDescription();
+    // it is possible that metric has not been calculated because it requires target data
+    // that is absent
+    if (!testErrors.empty()) {
+        const double* error = MapFindPtr(testErrors.back(), errorTrackerMetricDescription);
+        if (error) {
+            errorTracker->AddError(*error, iter);
+            if (useBestModel && iter == static_cast<ui32>(errorTracker->GetBestIteration())) {
+                ctx->LearnProgress->BestTestApprox = testApprox.back();
+            }
+            if (useBestModel && static_cast<int>(iter + 1) >= ctx->OutputOptions.BestModelMinTrees) {
+                metricsData->BestModelMinTreesTracker->AddError(*error, iter);
+            }
+        }
+    }
+}
+
+namespace {
+// Copy of approxes of the iteration, kept until metrics of the iteration are processed
+struct TIterationApproxes {
+    TVector<TVector<double>> AvrgApprox; // [dim][docIdx]
+    TVector<TVector<TVector<double>>> TestApprox; // [test][dim][docIdx]
+};
+
+struct TIterationMetrics {
+    ui32 Iteration = 0;
+    TIterationMetricValues Values;
+    TAtomicSharedPtr<TIterationApproxes> Approxes;
+};
+
+/* Calculates metrics of the last trained iteration while the next tree is built.
+ * Metrics task runs on training executor with low priority, so it uses threads that are idle in tree search
+ * and doesn't add threads over thread_count.
+ * Approxes are copied at start, because the next iteration updates them in place.
+ */
+class TAsyncMetricsCalcer {
+public:
+    explicit TAsyncMetricsCalcer(NPar::TLocalExecutor* localExecutor)
+        : LocalExecutor(localExecutor)
+    {
+        // metrics task has to be taken by one of additional threads while the main thread trains
+        Y_ASSERT(localExecutor->GetThreadCount() > 0);
+    }
+
+    ~TAsyncMetricsCalcer() {
+        if (IsRunning()) {
+            Metrics.Wait();
+        }
+    }
+
+    bool IsRunning() const {
+        return Metrics.Initialized();
+    }
+
+    void Start(
+        const TTrainingForCPUDataProviders& data,
+        const TMetricsData& metricsData,
+        ui32 iter,
+        const TLearnContext& ctx) {
+
+        Y_ASSERT(!IsRunning());
+        auto approxes = MakeAtomicShared<TIterationApproxes>();
+        approxes->AvrgApprox = ctx.LearnProgress->AvrgApprox;
+        approxes->TestApprox = ctx.LearnProgress->TestApprox;
+        auto promise = NThreading::NewPromise<TIterationMetrics>();
+        Metrics = promise.GetFuture();
+        LocalExecutor->Exec(
+            [
+                promise,
+                &data,
+                &metrics = metricsData.Metrics,
+                iter,
+                calcAllMetrics = ShouldCalcAllMetrics(iter, metricsData, ctx),
+                calcErrorTrackerMetric = ShouldCalcErrorTrackerMetric(iter, metricsData, ctx),
+                approxes = std::move(approxes),
+                localExecutor = LocalExecutor
+            ] (int /*id*/) mutable {
+                try {
+                    TIterationMetrics iterationMetrics;
+                    iterationMetrics.Iteration = iter;
+                    iterationMetrics.Values = CalcMetricValues(
+                        data,
+                        metrics,
+                        calcAllMetrics,
+                        calcErrorTrackerMetric,
+                        /*calcLearnMetrics*/ true,
+                        approxes->AvrgApprox,
+                        approxes->TestApprox,
+                        localExecutor
+                    );
+                    iterationMetrics.Approxes = approxes;
+                    promise.SetValue(std::move(iterationMetrics));
+                } catch (...) {
+                    promise.SetException(std::current_exception());
+                }
+            },
+            0,
+            NPar::TLocalExecutor::LOW_PRIORITY
+        );
+    }
+
+    TIterationMetrics Finish() {
+        Y_ASSERT(IsRunning());
+        TIterationMetrics iterationMetrics = Metrics.ExtractValueSync();
+        Metrics = NThreading::TFuture<TIterationMetrics>();
+        return iterationMetrics;
+    }
+
+private:
+    NPar::TLocalExecutor* LocalExecutor;
+    NThreading::TFuture<TIterationMetrics> Metrics;
+};
+}
+
 static void Train(
     const TTrainModelInternalOptions& internalOptions,
     const TTrainingForCPUDataProviders& data,
@@ -368,6 +502,63 @@ static void Train(
         trainingCallbacks->OnSaveSnapshot(out);
     };
 
+    // metric values of the iteration must already be added to metrics history
+    const auto processIterationMetrics = [&] (ui32 iter, const TVector<TVector<TVector<double>>>& testApprox) {
+        if (hasTest) {
+            AddErrorTrackerMetricValue(iter, testApprox, &metricsData, ctx);
+        }
+
+        TProfileResults profileResults = profile.GetProfileResults();
+        ctx->LearnProgress->MetricsAndTimeHistory.TimeHistory.push_back(TTimeInfo(profileResults));
+
+        Log(
+            iter,
+            GetMetricsDescription(metrics),
+            ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory,
+            ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory,
+            errorTracker ? TMaybe<double>(errorTracker->GetBestError()) : Nothing(),
+            errorTracker ? TMaybe<int>(errorTracker->GetBestIteration()) : Nothing(),
+            profileResults,
+            loggingData.LearnToken,
+            loggingData.TestTokens,
+            ShouldCalcAllMetrics(iter, metricsData, *ctx),
+            &loggingData.Logger
+        );
+    };
+
+    /* In async mode overfitting detector and callbacks get metrics one iteration late,
+     * so if training has to be stopped after them the next iteration is already trained.
+     * This iteration is removed from the model and approxes are restored from the copy used for metrics,
+     * learn folds can't be restored, so they are marked as invalid.
+     */
+    THolder<TAsyncMetricsCalcer> asyncMetricsCalcer;
+    // with a single thread there is nothing to overlap metrics calculation with
+    if (ctx->Params.SystemOptions->AsyncMetricsCalc.Get()
+        && ctx->Params.SystemOptions->IsSingleHost()
+        && ctx->LocalExecutor->GetThreadCount() > 0)
+    {
+        asyncMetricsCalcer = MakeHolder<TAsyncMetricsCalcer>(ctx->LocalExecutor);
+    }
+    const auto finishAsyncMetrics = [&] () -> bool {
+        TIterationMetrics iterationMetrics = asyncMetricsCalcer->Finish();
+        profile.AddOperation("Calc errors");
+        AddMetricValues(iterationMetrics.Values, &ctx->LearnProgress->MetricsAndTimeHistory);
+        processIterationMetrics(iterationMetrics.Iteration, iterationMetrics.Approxes->TestApprox);
+
+        continueTraining = trainingCallbacks->IsContinueTraining(ctx->LearnProgress->MetricsAndTimeHistory);
+        const bool isNeedStop = !continueTraining || (errorTracker && errorTracker->GetIsNeedStop());
+        const ui32 iterationCount = iterationMetrics.Iteration + 1;
+        if (isNeedStop && ctx->LearnProgress->GetCurrentTrainingIterationCount() > iterationCount) {
+            if (errorTracker && errorTracker->GetIsNeedStop()) {
+                LogThatStoppingOccured(*errorTracker);
+            }
+            ShrinkModel(iterationCount, ctx->CtrsHelper, ctx->LearnProgress.Get());
+            ctx->LearnProgress->AvrgApprox = std::move(iterationMetrics.Approxes->AvrgApprox);
+            ctx->LearnProgress->TestApprox = std::move(iterationMetrics.Approxes->TestApprox);
+        }
+        return isNeedStop;
+    };
+
     for (ui32 iter = ctx->LearnProgress->GetCurrentTrainingIterationCount();
          continueTraining && (iter < ctx->Params.BoostingOptions->IterationCount);
          ++iter)
@@ -378,57 +569,47 @@ static void Train(
             break;
         }
 
+        CHROMIUM_TRACE_SCOPE("Iteration");
         profile.StartNextIteration();
 
         if (timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval()) {
+            // snapshot must contain metrics of all trained iterations
+            if (asyncMetricsCalcer && asyncMetricsCalcer->IsRunning() && finishAsyncMetrics()) {
+                break;
+            }
             profile.AddOperation("Save snapshot");
-            ctx->SaveProgress(onSaveSnapshotCallback);
+            ctx->SaveProgress(onSaveSnapshotCallback, /*async*/ true);
             timer.Reset();
         }
 
         TrainOneIteration(data, ctx);
 
-        CalcErrors(data, metricsData, iter, ctx);
-
-        profile.AddOperation("Calc errors");
-
-        if (hasTest && ShouldCalcErrorTrackerMetric(iter, metricsData, *ctx) && errorTracker) {
-            const auto testErrors = ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory.back();
-            const TString& errorTrackerMetricDescription = metrics[metricsData.ErrorTrackerMetricIdx]->GetDescription();
-            // it is possible that metric has not been calculated because it requires target data
-            // that is absent
-            if (!testErrors.empty()) {
-                const double* error = MapFindPtr(testErrors.back(), errorTrackerMetricDescription);
-                if (error) {
-                    errorTracker->AddError(*error, iter);
-                    if (useBestModel && iter == static_cast<ui32>(errorTracker->GetBestIteration())) {
-                        ctx->LearnProgress->BestTestApprox = ctx->LearnProgress->TestApprox.back();
-                    }
-                    if (useBestModel && static_cast<int>(iter + 1) >= ctx->OutputOptions.BestModelMinTrees) {
-                        metricsData.BestModelMinTreesTracker->AddError(*error, iter);
-                    }
+        if (asyncMetricsCalcer) {
+            if (HasInvalidValues(ctx->LearnProgress->LeafValues.back())) {
+                ctx->LearnProgress->LeafValues.pop_back();
+                ctx->LearnProgress->TreeStruct.pop_back();
+                if (!ctx->LearnProgress->ModelShrinkHistory.empty()) {
+                    ctx->LearnProgress->ModelShrinkHistory.pop_back();
                 }
+                CATBOOST_WARNING_LOG << "Training has stopped (degenerate solution on iteration "
+                    << iter << ", probably too small l2-regularization, try to increase it)" << Endl;
+                break;
             }
+            if (asyncMetricsCalcer->IsRunning() && finishAsyncMetrics()) {
+                break;
+            }
+            asyncMetricsCalcer->Start(data, metricsData, iter, *ctx);
+            profile.FinishIteration();
+            continue;
         }
 
-        profile.FinishIteration();
+        CalcErrors(data, metricsData, iter, ctx);
 
-        TProfileResults profileResults = profile.GetProfileResults();
-        ctx->LearnProgress->MetricsAndTimeHistory.TimeHistory.push_back(TTimeInfo(profileResults));
+        profile.AddOperation("Calc errors");
 
-        Log(
-            iter,
-            GetMetricsDescription(metrics),
-            ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory,
-            ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory,
-            errorTracker ? TMaybe<double>(errorTracker->GetBestError()) : Nothing(),
-            errorTracker ? TMaybe<int>(errorTracker->GetBestIteration()) : Nothing(),
-            profileResults,
-            loggingData.LearnToken,
-            loggingData.TestTokens,
-            ShouldCalcAllMetrics(iter, metricsData, *ctx),
-            &loggingData.Logger
-        );
+        profile.FinishIteration();
+
+        processIterationMetrics(iter, ctx->LearnProgress->TestApprox);
 
         if (HasInvalidValues(ctx->LearnProgress->LeafValues.back())) {
             ctx->LearnProgress->LeafValues.pop_back();
@@ -444,7 +625,16 @@ static void Train(
         continueTraining = trainingCallbacks->IsContinueTraining(ctx->LearnProgress->MetricsAndTimeHistory);
     }
 
-    ctx->SaveProgress(onSaveSnapshotCallback);
+    if (asyncMetricsCalcer && asyncMetricsCalcer->IsRunning()) {
+        finishAsyncMetrics();
+    }
+
+    if (ctx->LearnProgress->IsFoldsAndApproxDataValid) {
+        ctx->SaveProgress(onSaveSnapshotCallback);
+    } else {
+        CATBOOST_INFO_LOG << "Last trained iteration has been rolled back, keeping previous snapshot" << Endl;
+        ctx->WaitForSavedProgress();
+    }
 
     if (hasTest) {
         (*testMultiApprox) = ctx->LearnProgress->TestApprox;
@@ -822,6 +1012,45 @@ static bool IsDistributedShared(
     return catBoostOptions.SystemOptions->IsMaster() && loadOptions != nullptr && IsSharedFs(loadOptions->LearnSetPath);
 }
 
+static bool CanQuantizeWhileLoading(
+    const NCatboostOptions::TPoolLoadParams& loadOptions,
+    bool hasFeatures,
+    bool needPoolAfterTrain
+) {
+    if (!hasFeatures) {
+        return false;
+    }
+    TStringBuf reason;
+    if (loadOptions.CvParams.FoldCount != 0) {
+        reason = "cross-validation mode";
+    } else if (needPoolAfterTrain) {
+        reason = "eval or feature importance output";
+    } else if (!NCB::IsQuantizationWhileLoadingSupported(loadOptions)) {
+        reason = "datasets that are not dsv or contain categorical or text features";
+    } else {
+        return true;
+    }
+    CATBOOST_WARNING_LOG << "Quantization while loading is not supported for " << reason
+        << ", datasets will be loaded without it" << Endl;
+    return false;
+}
+
+// The global tracer has a single output, so the sink is installed once per top-level training run,
+// not per model trainer: cross-validation and hyperparameter search train many models in parallel.
+// All training threads, including local executor workers, write their spans to it.
+static THolder<NChromiumTrace::TGlobalJsonFileSink> CreateTraceSinkIfNeeded(
+    const NCatboostOptions::TOutputFilesOptions& outputOptions
+) {
+    if (!outputOptions.AllowWriteFiles()) {
+        return nullptr;
+    }
+    const TString traceFileName = outputOptions.CreateTraceFullPath();
+    if (traceFileName.empty()) {
+        return nullptr;
+    }
+    return MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(traceFileName);
+}
+
 static void TrainModel(
     const NJson::TJsonValue& trainOptionsJson,
     const NCatboostOptions::TOutputFilesOptions& outputOptions,
@@ -1012,6 +1241,8 @@ void TrainModel(
 
     TSetLogging inThisScope(catBoostOptions.LoggingLevel);
 
+    const auto traceSink = CreateTraceSinkIfNeeded(outputOptions);
+
     TProfileInfo profile;
 
     CB_ENSURE(
@@ -1056,14 +1287,27 @@ void TrainModel(
     const auto objectsOrder = catBoostOptions.DataProcessingOptions->HasTimeFlag.Get() ?
         EObjectsOrder::Ordered : EObjectsOrder::Undefined;
     const bool hasFeatures = !IsDistributedShared(&loadOptions, catBoostOptions);
-    TDataProviders pools = LoadPools(
-        loadOptions,
-        ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get()),
-        objectsOrder,
-        TDatasetSubset::MakeColumns(hasFeatures),
-        &classLabels,
-        &executor,
-        &profile);
+    TDataProviders pools;
+    if (loadOptions.QuantizeWhileLoading
+        && CanQuantizeWhileLoading(loadOptions, hasFeatures, !evalOutputFileName.empty() || needFstr))
+    {
+        pools = NCB::ReadAndQuantizeTrainDatasets(
+            loadOptions,
+            catBoostOptions,
+            objectsOrder,
+            &classLabels,
+            &executor,
+            &profile);
+    } else {
+        pools = LoadPools(
+            loadOptions,
+            ParseMemorySizeDescription(catBoostOptions.SystemOptions->CpuUsedRamLimit.Get()),
+            objectsOrder,
+            TDatasetSubset::MakeColumns(hasFeatures),
+            &classLabels,
+            &executor,
+            &profile);
+    }
 
     const bool hasTextFeatures = pools.Learn->MetaInfo.FeaturesLayout->GetTextFeatureCount() > 0;
     if (hasTextFeatures) {
@@ -1395,6 +1639,8 @@ void TrainModel(
     NCatboostOptions::TOutputFilesOptions outputOptions;
     outputOptions.Load(outputFilesOptionsJson);
 
+    const auto traceSink = CreateTraceSinkIfNeeded(outputOptions);
+
     NPar::TLocalExecutor executor;
     executor.RunAdditionalThreads(
         NCatboostOptions::GetThreadCount(trainOptionsJson) - 1);
@@ -0,0 +1,151 @@
+#include <catboost/libs/data/data_provider_builders.h>
+#include <catboost/libs/data/objects_grouping.h>
+#include <catboost/libs/train_lib/cross_validation.h>
+
+#include <library/json/json_reader.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+using namespace NCB;
+
+
+static TVector<ui32> GetSrcIndices(const TArraySubsetIndexing<ui32>& subset) {
+    TVector<ui32> srcIndices;
+    subset.ForEach([&] (ui32 /*idx*/, ui32 srcIdx) { srcIndices.push_back(srcIdx); });
+    return srcIndices;
+}
+
+static TDataProviderPtr RandomRegressionPool(ui32 objectCount, ui32 featureCount) {
+    TFastRng64 rng(0);
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            TVector<float> target(objectCount, 0.0f);
+            for (auto featureIdx : xrange(featureCount)) {
+                TVector<float> values(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    values[objectIdx] = rng.GenRandReal1();
+                    target[objectIdx] += values[objectIdx] * (featureIdx + 1);
+                }
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(values))
+                );
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+
+            visitor->Finish();
+        }
+    );
+}
+
+Y_UNIT_TEST_SUITE(CrossValidation) {
+    Y_UNIT_TEST(CalcTrainSubsetsRangesSameAsIndexed) {
+        TVector<TVector<TArraySubsetIndexing<ui32>>> testSubsetsCases;
+        testSubsetsCases.push_back(Split(TObjectsGrouping(10), 3));
+        testSubsetsCases.push_back(Split(TObjectsGrouping(10), 3, /*oldCvStyle*/ true));
+        testSubsetsCases.push_back(Split(TObjectsGrouping(7), 7));
+
+        // several blocks in a test fold, adjacent blocks of train folds are merged
+        testSubsetsCases.emplace_back();
+        testSubsetsCases.back().push_back(
+            TArraySubsetIndexing<ui32>(
+                TRangesSubset<ui32>(
+                    4,
+                    TVector<TSubsetBlock<ui32>>{{{0, 2}, 0}, {{6, 8}, 2}}
+                )
+            )
+        );
+        testSubsetsCases.back().push_back(
+            TArraySubsetIndexing<ui32>(
+                TRangesSubset<ui32>(
+                    4,
+                    TVector<TSubsetBlock<ui32>>{{{2, 4}, 0}, {{8, 10}, 2}}
+                )
+            )
+        );
+        testSubsetsCases.back().push_back(
+            TArraySubsetIndexing<ui32>(TRangesSubset<ui32>(2, TVector<TSubsetBlock<ui32>>{{{4, 6}, 0}}))
+        );
+
+        for (const auto& testSubsets : testSubsetsCases) {
+            ui32 groupCount = 0;
+            TVector<TVector<ui32>> testIndices;
+            for (const auto& testSubset : testSubsets) {
+                UNIT_ASSERT(HoldsAlternative<TRangesSubset<ui32>>(testSubset));
+                testIndices.push_back(GetSrcIndices(testSubset));
+                groupCount += testSubset.Size();
+            }
+
+            const auto trainSubsets = CalcTrainSubsets(testSubsets, groupCount);
+            const auto expectedTrainSubsets = CalcTrainSubsets(
+                TransformToVectorArrayIndexing(testIndices),
+                groupCount);
+
+            UNIT_ASSERT_VALUES_EQUAL(trainSubsets.size(), expectedTrainSubsets.size());
+            for (auto fold : xrange(trainSubsets.size())) {
+                UNIT_ASSERT(HoldsAlternative<TRangesSubset<ui32>>(trainSubsets[fold]));
+                UNIT_ASSERT(HoldsAlternative<TIndexedSubset<ui32>>(expectedTrainSubsets[fold]));
+                UNIT_ASSERT_VALUES_EQUAL(trainSubsets[fold].Size(), expectedTrainSubsets[fold].Size());
+                UNIT_ASSERT_VALUES_EQUAL(
+                    GetSrcIndices(trainSubsets[fold]),
+                    GetSrcIndices(expectedTrainSubsets[fold]));
+            }
+        }
+    }
+
+    Y_UNIT_TEST(ParallelFoldsSameAsSequential) {
+        const auto data = RandomRegressionPool(/*objectCount*/ 2000, /*featureCount*/ 4);
+
+        const NJson::TJsonValue params = NJson::ReadJsonFastTree(
+            "{\"iterations\": 30, \"loss_function\": \"RMSE\", \"custom_metric\": [\"MAE\"],"
+            " \"thread_count\": 4, \"allow_writing_files\": false}");
+
+        TVector<TVector<TCVResult>> results;
+        for (ui32 parallelFoldCount : {1, 2, 4}) {
+            TCrossValidationParams cvParams;
+            cvParams.FoldCount = 4;
+            cvParams.ParallelFoldCount = parallelFoldCount;
+
+            results.emplace_back();
+            CrossValidate(
+                params,
+                TQuantizedFeaturesInfoPtr(nullptr),
+                /*objectiveDescriptor*/ Nothing(),
+                /*evalMetricDescriptor*/ Nothing(),
+                data,
+                cvParams,
+                &results.back());
+        }
+
+        const auto& expected = results[0];
+        UNIT_ASSERT_VALUES_EQUAL(expected.size(), 2);
+        for (const auto& result : results) {
+            UNIT_ASSERT_VALUES_EQUAL(result.size(), expected.size());
+            for (auto metricIdx : xrange(expected.size())) {
+                const auto& metricResult = result[metricIdx];
+                const auto& expectedMetricResult = expected[metricIdx];
+                UNIT_ASSERT_VALUES_EQUAL(metricResult.Metric, expectedMetricResult.Metric);
+                UNIT_ASSERT_VALUES_EQUAL(metricResult.Iterations, expectedMetricResult.Iterations);
+                for (auto i : xrange(expectedMetricResult.Iterations.size())) {
+                    UNIT_ASSERT_DOUBLES_EQUAL(metricResult.AverageTrain[i], expectedMetricResult.AverageTrain[i], 1e-6);
+                    UNIT_ASSERT_DOUBLES_EQUAL(metricResult.AverageTest[i], expectedMetricResult.AverageTest[i], 1e-6);
+                    UNIT_ASSERT_DOUBLES_EQUAL(metricResult.StdDevTest[i], expectedMetricResult.StdDevTest[i], 1e-6);
+                }
+            }
+        }
+    }
+}
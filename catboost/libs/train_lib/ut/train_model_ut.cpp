@@ -4,12 +4,16 @@
 #include <catboost/libs/model/model.h>
 #include <catboost/libs/train_lib/train_model.h>
 
+#include <library/json/json_reader.h>
 #include <library/unittest/registar.h>
 
 #include <util/folder/tempdir.h>
 #include <util/generic/array_ref.h>
+#include <util/generic/hash_set.h>
 #include <util/generic/xrange.h>
 #include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/system/fs.h>
 
 #include <limits>
 
@@ -69,6 +73,40 @@ static TDataProviderPtr SmallFloatPool() {
     );
 }
 
+template <typename Prng>
+static TDataProviderPtr RandomFloatPool(ui32 objectCount, ui32 featureCount, Prng& prng) {
+    TVector<TVector<float>> factors(featureCount);
+    ResizeRank2(featureCount, objectCount, factors);
+    TVector<float> target(objectCount);
+    FillWithRandom(factors, prng);
+    FillWithRandom(target, prng);
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.TargetType = ERawTargetType::Float;
+            metaInfo.TargetCount = 1;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                featureCount,
+                TVector<ui32>{},
+                TVector<ui32>{},
+                TVector<TString>{});
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            for (auto featureIdx : xrange(featureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(factors[featureIdx]))
+                );
+            }
+            visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+
+            visitor->Finish();
+        }
+    );
+}
+
 Y_UNIT_TEST_SUITE(TrainModelTests) {
     Y_UNIT_TEST(TrainWithoutNansTestWithNans) {
         // Train doesn't have NaNs, so TrainModel implicitly forbids them (during quantization), but
@@ -259,4 +297,112 @@ Y_UNIT_TEST_SUITE(TrainModelTests) {
 
         UNIT_ASSERT_VALUES_UNEQUAL(predictions[0][0], predictions[1][0]);
     }
+
+    Y_UNIT_TEST(TrainWithAsyncMetricsCalc) {
+        // Metrics calculated in background reach overfitting detector one iteration late,
+        // the extra iteration must be rolled back, so results are the same as with synchronous calculation
+
+        TFastRng<ui64> prng(20200101);
+        // target doesn't depend on features, so test error starts growing quickly and detector stops training
+        const auto learn = RandomFloatPool(200, 4, prng);
+        const auto test = RandomFloatPool(100, 4, prng);
+
+        TFullModel models[2];
+        TMetricsAndTimeLeftHistory histories[2];
+        for (auto asyncMetricsCalc : {false, true}) {
+            TTempDir trainDir;
+
+            TDataProviders dataProviders;
+            dataProviders.Learn = learn;
+            dataProviders.Test.push_back(test);
+
+            TEvalResult evalResult;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 200);
+            params.InsertValue("learning_rate", 0.3);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("thread_count", 4);
+            params.InsertValue("od_type", "Iter");
+            params.InsertValue("od_wait", 5);
+            params.InsertValue("use_best_model", true);
+            params.InsertValue("custom_metric", "MAE");
+            params.InsertValue("train_dir", trainDir.Name());
+            params.InsertValue("async_metrics_calc", asyncMetricsCalc);
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                "",
+                &models[asyncMetricsCalc],
+                {&evalResult},
+                &histories[asyncMetricsCalc]
+            );
+        }
+
+        UNIT_ASSERT(histories[0].LearnMetricsHistory.size() < 200);
+        UNIT_ASSERT(*models[0].ModelTrees == *models[1].ModelTrees);
+        UNIT_ASSERT_EQUAL(histories[0].LearnMetricsHistory, histories[1].LearnMetricsHistory);
+        UNIT_ASSERT_EQUAL(histories[0].TestMetricsHistory, histories[1].TestMetricsHistory);
+        UNIT_ASSERT_EQUAL(histories[0].BestIteration, histories[1].BestIteration);
+        UNIT_ASSERT_EQUAL(histories[0].TestBestError, histories[1].TestBestError);
+    }
+
+    Y_UNIT_TEST(TrainWithTraceFile) {
+        TFastRng<ui64> prng(20200102);
+        const auto learn = RandomFloatPool(100, 4, prng);
+
+        for (auto allowWritingFiles : {true, false}) {
+            TTempDir trainDir;
+
+            TDataProviders dataProviders;
+            dataProviders.Learn = learn;
+
+            TFullModel model;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 5);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("thread_count", 2);
+            params.InsertValue("train_dir", trainDir.Name());
+            params.InsertValue("trace_file", "trace.json");
+            params.InsertValue("allow_writing_files", allowWritingFiles);
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                /*initModel*/ Nothing(),
+                /*initLearnProgress*/ nullptr,
+                "",
+                &model,
+                {}
+            );
+
+            const TString traceFileName = trainDir.Name() + "/trace.json";
+            if (!allowWritingFiles) {
+                UNIT_ASSERT(!NFs::Exists(traceFileName));
+                continue;
+            }
+
+            // the sink is destroyed when training finishes, so the file must be a complete JSON list of events
+            NJson::TJsonValue trace;
+            UNIT_ASSERT(NJson::ReadJsonTree(TFileInput(traceFileName).ReadAll(), &trace));
+            UNIT_ASSERT(trace.IsArray());
+
+            THashSet<TString> spanNames;
+            for (const auto& event : trace.GetArray()) {
+                UNIT_ASSERT(event.Has("ph"));
+                if (event.Has("name")) {
+                    spanNames.insert(event["name"].GetString());
+                }
+            }
+            for (const auto* spanName : {"Iteration", "TrainOneIteration", "GreedyTensorSearch"}) {
+                UNIT_ASSERT_C(spanNames.contains(spanName), spanName);
+            }
+        }
+    }
 }
@@ -309,6 +309,69 @@ void TModelCalcerOnPool::ApplyModelMulti(
     flatApproxBuffer->clear();
 }
 
+void TModelCalcerOnPool::AddTreeRangeApprox(
+    int begin,
+    int end,
+    TVector<double>* flatApproxBuffer,
+    TVector<TVector<double>>* approx)
+{
+    const ui32 docCount = ObjectsData->GetObjectCount();
+    const auto approxDimension = Model->GetDimensionsCount();
+    if (approx->empty()) {
+        ResizeRank2(approxDimension, docCount, *approx);
+    }
+    CB_ENSURE_INTERNAL(approx->size() == approxDimension, "Unexpected approx dimension: " << approx->size());
+    for (const auto& approxProjection : *approx) {
+        CB_ENSURE_INTERNAL(approxProjection.size() == docCount, "Unexpected approx size: " << approxProjection.size());
+    }
+    if (docCount == 0) {
+        return;
+    }
+
+    FixupTreeEnd(Model->GetTreeCount(), begin, &end);
+
+    TVector<double>& approxFlat = *flatApproxBuffer;
+    approxFlat.yresize(static_cast<unsigned long>(docCount * approxDimension));
+
+    // approx is updated by the same tasks while their part of approxFlat is in cache
+    Executor->ExecRangeWithThrow(
+        [&, this](int blockId) {
+            const int blockFirstId = BlockParams.FirstId + blockId * BlockParams.GetBlockSize();
+            const int blockLastId = Min(BlockParams.LastId, blockFirstId + BlockParams.GetBlockSize());
+            TArrayRef<double> resultRef(
+                approxFlat.data() + blockFirstId * approxDimension,
+                (blockLastId - blockFirstId) * approxDimension);
+            ModelEvaluator->Calc(QuantizedDataForThreads[blockId].Get(), begin, end, resultRef);
+            for (ui32 dim = 0; dim < approxDimension; ++dim) {
+                double* approxProjection = (*approx)[dim].data();
+                for (int doc = blockFirstId; doc < blockLastId; ++doc) {
+                    approxProjection[doc] += approxFlat[approxDimension * doc + dim];
+                }
+            }
+        },
+        0,
+        BlockParams.GetBlockCount(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+void TModelCalcerOnPool::ApplyModelStaged(
+    int begin,
+    int end,
+    int evalPeriod,
+    TVector<TVector<double>>* approx,
+    const std::function<void(int, const TVector<TVector<double>>&)>& stageCallback)
+{
+    CB_ENSURE(evalPeriod > 0, "Eval period should be positive");
+    FixupTreeEnd(Model->GetTreeCount(), begin, &end);
+
+    TVector<double> flatApproxBuffer;
+    for (int stageBegin = begin; stageBegin < end; stageBegin += evalPeriod) {
+        const int stageEnd = Min(stageBegin + evalPeriod, end);
+        AddTreeRangeApprox(stageBegin, stageEnd, &flatApproxBuffer, approx);
+        stageCallback(stageEnd, *approx);
+    }
+}
+
 TModelCalcerOnPool::TModelCalcerOnPool(
     const TFullModel& model,
     TObjectsDataProviderPtr objectsData,
@@ -12,6 +12,8 @@
 #include <util/generic/ptr.h>
 #include <util/generic/vector.h>
 
+#include <functional>
+
 namespace NCB {
     template <class TTObjectsDataProvider>
     class TDataProviderTemplate;
@@ -71,6 +73,31 @@ public:
         TVector<double>* flatApproxBuffer,
         TVector<TVector<double>>* approx);
 
+    /*
+     * Adds raw approxes (as for InternalRawFormulaVal) of trees [begin, end) to approx [dim][docIdx],
+     *  approx is initialized by zeros if it is empty.
+     * Allows to calculate predictions of truncated models incrementally: features are binarized once
+     *  in constructor and each call applies only trees of its range.
+     */
+    void AddTreeRangeApprox(
+        int begin,
+        int end,
+        TVector<double>* flatApproxBuffer,
+        TVector<TVector<double>>* approx);
+
+    /*
+     * Staged prediction: stageCallback(stageEnd, approx) is called for stageEnd = begin + evalPeriod,
+     *  begin + 2 * evalPeriod, ..., end with raw approxes of trees [begin, stageEnd) added to initial approx
+     *  (that is initialized by zeros if it is empty).
+     * Only the current stage is kept in memory, approx passed to stageCallback is updated by the next stage.
+     */
+    void ApplyModelStaged(
+        int begin,
+        int end,
+        int evalPeriod,
+        TVector<TVector<double>>* approx,
+        const std::function<void(int, const TVector<TVector<double>>&)>& stageCallback);
+
 private:
     const TFullModel* Model;
     NCB::NModelEvaluation::TConstModelEvaluatorPtr ModelEvaluator;
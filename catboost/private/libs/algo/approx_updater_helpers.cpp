@@ -2,6 +2,8 @@
 
 #include "learn_context.h"
 
+#include <library/chromium_trace/interface.h>
+
 #include <util/generic/cast.h>
 
 
@@ -80,6 +82,7 @@ void UpdateAvrgApprox(
     TLearnProgress* learnProgress,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("UpdateAvrgApprox");
     if (storeExpApprox) {
         ::UpdateAvrgApprox<true>(learnSampleCount, indices, treeDelta, testData, learnProgress, localExecutor);
     } else {
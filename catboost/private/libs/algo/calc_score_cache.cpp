@@ -3,10 +3,15 @@
 #include <catboost/libs/helpers/restorable_rng.h>
 #include <catboost/private/libs/options/oblivious_tree_options.h>
 
+#include <library/blockcodecs/codecs.h>
+
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
+#include <util/system/env.h>
 #include <util/system/guard.h>
+#include <util/system/mem_info.h>
 
 
 using namespace NCB;
@@ -16,38 +21,126 @@ bool IsSamplingPerTree(const NCatboostOptions::TObliviousTreeLearnerOptions& fit
     return fitParams.SamplingFrequency.Get() == ESamplingFrequency::PerTree;
 }
 
-TVector<TBucketStats, TPoolAllocator>& TBucketStatsCache::GetStats(
+void TBucketStatsCache::Create(
+    const TVector<TFold>& folds,
+    int bucketCount,
+    int depth,
+    ui64 memoryLimit
+) {
+    ApproxDimension = folds[0].GetApproxDimension();
+    MaxBodyTailCount = GetMaxBodyTailCount(folds);
+    InitialSize = sizeof(TBucketStats) * bucketCount * (1ULL << depth) * ApproxDimension * MaxBodyTailCount;
+    if (InitialSize == 0) {
+        InitialSize = NSystemInfo::GetPageSize();
+    }
+    MemoryPool = new TMemoryPool(Min<ui64>(InitialSize, Max<ui64>(memoryLimit, NSystemInfo::GetPageSize())));
+    MemoryLimit = memoryLimit;
+    AllocatedSize = 0;
+    Stats.clear();
+    EvictionQueue.clear();
+    Counters = TBucketStatsCacheCounters();
+}
+
+TBucketStatsCache::TStatsVector* TBucketStatsCache::GetStats(
     const TSplitEnsemble& splitEnsemble,
     int splitStatsCount,
     bool* areStatsDirty
 ) {
-    TVector<TBucketStats, TPoolAllocator>* splitStats;
-    with_lock(Lock) {
-        if (Stats.contains(splitEnsemble) && Stats[splitEnsemble] != nullptr) {
-            splitStats = Stats[splitEnsemble].Get();
-            Y_ASSERT(splitStats->ysize() >= splitStatsCount);
-            *areStatsDirty = false;
-        } else {
-            splitStats = new TVector<TBucketStats, TPoolAllocator>(MemoryPool.Get());
-            splitStats->yresize(MaxBodyTailCount * ApproxDimension * splitStatsCount);
-            Stats[splitEnsemble] = splitStats;
-            *areStatsDirty = true;
+    const size_t statsCount = (size_t)MaxBodyTailCount * ApproxDimension * splitStatsCount;
+
+    auto guard = Guard(Lock);
+    auto cachedStats = Stats.find(splitEnsemble);
+    if (cachedStats != Stats.end() && cachedStats->second.Stats != nullptr) {
+        Y_ASSERT(cachedStats->second.Stats->size() >= statsCount);
+        cachedStats->second.LastUsedLevel = CurrentLevel;
+        ++Counters.Hits;
+        *areStatsDirty = false;
+        return cachedStats->second.Stats.Get();
+    }
+
+    ++Counters.Misses;
+    *areStatsDirty = true;
+    THolder<TStatsVector> splitStats;
+    if (AllocatedSize + statsCount * sizeof(TBucketStats) <= MemoryLimit) {
+        splitStats = MakeHolder<TStatsVector>(MemoryPool.Get());
+        splitStats->yresize(statsCount);
+        AllocatedSize += splitStats->capacity() * sizeof(TBucketStats);
+    } else {
+        splitStats = EvictStats(statsCount);
+        if (splitStats == nullptr) {
+            return nullptr;
         }
+        splitStats->yresize(statsCount);
     }
-    return *splitStats;
+    TCachedStats& newCachedStats = Stats[splitEnsemble];
+    newCachedStats.Stats = std::move(splitStats);
+    newCachedStats.LastUsedLevel = CurrentLevel;
+    return newCachedStats.Stats.Get();
+}
+
+THolder<TBucketStatsCache::TStatsVector> TBucketStatsCache::EvictStats(size_t minCapacity) {
+    if (EvictionQueueLevel != CurrentLevel) {
+        TVector<std::pair<ui64, const TSplitEnsemble*>> evictionCandidates;
+        for (const auto& [splitEnsemble, cachedStats] : Stats) {
+            if (cachedStats.LastUsedLevel < CurrentLevel && cachedStats.Stats != nullptr) {
+                evictionCandidates.emplace_back(cachedStats.LastUsedLevel, &splitEnsemble);
+            }
+        }
+        StableSort(
+            evictionCandidates,
+            [] (const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; }
+        );
+        EvictionQueue.clear();
+        EvictionQueue.reserve(evictionCandidates.size());
+        for (const auto& evictionCandidate : evictionCandidates) {
+            EvictionQueue.push_back(*evictionCandidate.second);
+        }
+        EvictionQueueLevel = CurrentLevel;
+    }
+    while (!EvictionQueue.empty()) {
+        const auto cachedStats = Stats.find(EvictionQueue.back());
+        EvictionQueue.pop_back();
+        if (cachedStats == Stats.end()
+            || cachedStats->second.LastUsedLevel == CurrentLevel
+            || cachedStats->second.Stats == nullptr
+            || cachedStats->second.Stats->capacity() < minCapacity)
+        {
+            continue;
+        }
+        THolder<TStatsVector> evictedStats = std::move(cachedStats->second.Stats);
+        Stats.erase(cachedStats);
+        ++Counters.Evictions;
+        return evictedStats;
+    }
+    return nullptr;
+}
+
+void TBucketStatsCache::StartTreeLevel() {
+    ++CurrentLevel;
 }
 
 void TBucketStatsCache::GarbageCollect() {
     if (MemoryPool->MemoryWaste() > InitialSize) { // limit memory overhead
         Stats.clear();
+        EvictionQueue.clear();
         MemoryPool->Clear();
+        AllocatedSize = 0;
+    }
+}
+
+ui64 GetBucketStatsCacheMemoryLimit(ui64 cpuUsedRamLimit) {
+    if (cpuUsedRamLimit == Max<ui64>()) {
+        return Max<ui64>();
     }
+    const ui64 currentMemoryUsage = NMemInfo::GetMemInfo().RSS;
+    // leave a half of the rest for ctrs and other per tree data
+    return cpuUsedRamLimit > currentMemoryUsage ? (cpuUsedRamLimit - currentMemoryUsage) / 2 : 0;
 }
 
 TVector<TBucketStats> TBucketStatsCache::GetStatsInUse(int segmentCount,
     int segmentSize,
     int statsCount,
-    const TVector<TBucketStats, TPoolAllocator>& cachedStats
+    const TStatsVector& cachedStats
 ) {
     TVector<TBucketStats> stats;
     stats.yresize(segmentCount * statsCount);
@@ -963,53 +1056,56 @@ void TCalcScoreFold::SetSmallestSideControl(
 ) {
     Y_ASSERT(curDepth > 0);
 
+    // Smallest side is selected for each leaf of the previous level separately, so stats of the bigger side
+    // of every leaf are obtained by subtraction from parent stats (see FixUpStats in scoring.cpp)
+    const TIndexType splitWeight = 1 << (curDepth - 1);
+    const int leafCount = 2 * splitWeight;
+
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, docCount);
-    blockParams.SetBlockSize(4000);
+    blockParams.SetBlockSize(Max(4000, 16 * leafCount));
     const int blockCount = blockParams.GetBlockCount();
 
-    TVector<int> blockSize(blockCount, 0);
+    TVector<int> blockLeafSizes(blockCount * leafCount, 0);
     const TIndexType* indicesData = GetDataPtr(indices);
     localExecutor->ExecRange(
-        [=, &blockSize](int blockIdx) {
-            int size = 0;
+        [=, &blockLeafSizes](int blockIdx) {
+            int* leafSizes = blockLeafSizes.data() + blockIdx * leafCount;
             NPar::TLocalExecutor::BlockedLoopBody(
                 blockParams,
-                [=, &size](int docIdx) {
-                    size += indicesData[docIdx] >> (curDepth - 1);
+                [=](int docIdx) {
+                    ++leafSizes[indicesData[docIdx]];
                 }
             )(blockIdx);
-            blockSize[blockIdx] = size;
         },
         0,
         blockCount,
         NPar::TLocalExecutor::WAIT_COMPLETE
     );
 
-    int trueCount = 0;
-    for (int size : blockSize) {
-        trueCount += size;
+    TVector<int> leafSizes(leafCount, 0);
+    for (int blockIdx : xrange(blockCount)) {
+        for (int leafIdx : xrange(leafCount)) {
+            leafSizes[leafIdx] += blockLeafSizes[blockIdx * leafCount + leafIdx];
+        }
     }
-    const TIndexType splitWeight = 1 << (curDepth - 1);
-    bool* controlData = GetDataPtr(Control);
-    if (trueCount * 2 > docCount) {
-        SmallestSplitSideValue = false;
-        localExecutor->ExecRange(
-            [=](int docIdx) {
-                controlData[docIdx] = indicesData[docIdx] < splitWeight;
-            },
-            blockParams,
-            NPar::TLocalExecutor::WAIT_COMPLETE
-        );
-    } else {
-        SmallestSplitSideValue = true;
-        localExecutor->ExecRange(
-            [=](int docIdx) {
-                controlData[docIdx] = indicesData[docIdx] > splitWeight - 1;
-            },
-            blockParams,
-            NPar::TLocalExecutor::WAIT_COMPLETE
-        );
+    SmallestSplitSideValues.yresize(splitWeight);
+    for (TIndexType parentLeafIdx : xrange(splitWeight)) {
+        const int trueCount = leafSizes[parentLeafIdx | splitWeight];
+        const int falseCount = leafSizes[parentLeafIdx];
+        SmallestSplitSideValues[parentLeafIdx] = trueCount <= falseCount;
     }
+
+    bool* controlData = GetDataPtr(Control);
+    const ui8* smallestSplitSideValuesData = SmallestSplitSideValues.data();
+    localExecutor->ExecRange(
+        [=](int docIdx) {
+            const TIndexType index = indicesData[docIdx];
+            const bool splitValue = index > splitWeight - 1;
+            controlData[docIdx] = splitValue == (smallestSplitSideValuesData[index & (splitWeight - 1)] != 0);
+        },
+        blockParams,
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
 }
 
 void TCalcScoreFold::SetSampledControl(
@@ -1188,3 +1284,79 @@ void TStats3D::Add(const TStats3D& stats3D) {
         Stats[statIdx].Add(stats3D.Stats[statIdx]);
     }
 }
+
+static_assert(sizeof(TBucketStats) % sizeof(double) == 0, "TBucketStats must consist of doubles");
+
+static constexpr size_t BucketStatsFieldCount = sizeof(TBucketStats) / sizeof(double);
+
+static const NBlockCodecs::ICodec* GetBucketStatsCodec() {
+    static const NBlockCodecs::ICodec* codec = NBlockCodecs::Codec(GetEnv("CB_STATS_COMPRESS_CODEC", "lz4fast"));
+    return codec;
+}
+
+/* Each field of bucket stats is XORed with the same field of the previous bucket: neighbour buckets and leaves
+ * have close sums, so results have zero high bytes (and are zero for empty leaves and unused buckets).
+ * Bytes of XORed values are grouped by their significance and compressed.
+ */
+static TString PackBucketStats(TConstArrayRef<TBucketStats> stats, const NBlockCodecs::ICodec* codec) {
+    const size_t valueCount = stats.size() * BucketStatsFieldCount;
+    const double* values = reinterpret_cast<const double*>(stats.data());
+
+    TVector<ui8> bytePlanes;
+    bytePlanes.yresize(valueCount * sizeof(ui64));
+    for (size_t fieldIdx : xrange(BucketStatsFieldCount)) {
+        ui64 prevBits = 0;
+        for (size_t statIdx : xrange(stats.size())) {
+            const ui64 bits = BitCast<ui64>(values[statIdx * BucketStatsFieldCount + fieldIdx]);
+            const ui64 delta = bits ^ prevBits;
+            prevBits = bits;
+            const size_t valueIdx = fieldIdx * stats.size() + statIdx;
+            for (size_t byteIdx : xrange(sizeof(ui64))) {
+                bytePlanes[byteIdx * valueCount + valueIdx] = static_cast<ui8>(delta >> (8 * byteIdx));
+            }
+        }
+    }
+    return codec->Encode(bytePlanes);
+}
+
+static void UnpackBucketStats(TStringBuf packedStats, const NBlockCodecs::ICodec* codec, TVector<TBucketStats>* stats) {
+    TString bytePlanes;
+    codec->Decode(packedStats, bytePlanes);
+    const size_t valueCount = bytePlanes.size() / sizeof(ui64);
+    CB_ENSURE(
+        valueCount * sizeof(ui64) == bytePlanes.size() && valueCount % BucketStatsFieldCount == 0,
+        "Corrupted bucket stats"
+    );
+    const size_t statCount = valueCount / BucketStatsFieldCount;
+    const ui8* bytes = reinterpret_cast<const ui8*>(bytePlanes.data());
+
+    stats->yresize(statCount);
+    double* values = reinterpret_cast<double*>(stats->data());
+    for (size_t fieldIdx : xrange(BucketStatsFieldCount)) {
+        ui64 prevBits = 0;
+        for (size_t statIdx : xrange(statCount)) {
+            const size_t valueIdx = fieldIdx * statCount + statIdx;
+            ui64 delta = 0;
+            for (size_t byteIdx : xrange(sizeof(ui64))) {
+                delta |= ui64(bytes[byteIdx * valueCount + valueIdx]) << (8 * byteIdx);
+            }
+            prevBits ^= delta;
+            values[statIdx * BucketStatsFieldCount + fieldIdx] = BitCast<double>(prevBits);
+        }
+    }
+}
+
+int TStats3D::operator&(IBinSaver& binSaver) {
+    TString codecName;
+    TString packedStats;
+    if (!binSaver.IsReading()) {
+        const auto* codec = GetBucketStatsCodec();
+        codecName = codec->Name();
+        packedStats = PackBucketStats(Stats, codec);
+    }
+    binSaver.AddMulti(codecName, packedStats, BucketCount, MaxLeafCount, SplitEnsembleSpec);
+    if (binSaver.IsReading()) {
+        UnpackBucketStats(packedStats, NBlockCodecs::Codec(codecName), &Stats);
+    }
+    return 0;
+}
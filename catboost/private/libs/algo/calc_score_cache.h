@@ -120,32 +120,58 @@ inline static int CountNonCtrBuckets(
     return nonCtrBucketCount;
 }
 
+struct TBucketStatsCacheCounters {
+    ui64 Hits = 0;
+    ui64 Misses = 0;
+    ui64 Evictions = 0;
+};
+
+/* Bucket stats of split candidates from the previous tree level, used to calculate stats of the current level by
+ * subtraction. Memory used by stats is limited: when the limit is reached, stats not used at the current level are
+ * evicted in least recently used order and their memory is reused. If there are no such stats, GetStats returns
+ * nullptr and stats have to be calculated without caching.
+ */
 class TBucketStatsCache {
 public:
-    inline void Create(const TVector<TFold>& folds, int bucketCount, int depth) {
-        ApproxDimension = folds[0].GetApproxDimension();
-        MaxBodyTailCount = GetMaxBodyTailCount(folds);
-        InitialSize = sizeof(TBucketStats) * bucketCount * (1ULL << depth) * ApproxDimension * MaxBodyTailCount;
-        if (InitialSize == 0) {
-            InitialSize = NSystemInfo::GetPageSize();
-        }
-        MemoryPool = new TMemoryPool(InitialSize);
-    }
-    TVector<TBucketStats, TPoolAllocator>& GetStats(
+    using TStatsVector = TVector<TBucketStats, TPoolAllocator>;
+
+    struct TCachedStats {
+        THolder<TStatsVector> Stats;
+        ui64 LastUsedLevel = 0;
+    };
+
+public:
+    void Create(
+        const TVector<TFold>& folds,
+        int bucketCount,
+        int depth,
+        ui64 memoryLimit = Max<ui64>()
+    );
+
+    // thread-safe, returned stats stay valid until the end of the tree level
+    TStatsVector* GetStats(
         const TSplitEnsemble& splitEnsemble,
         int statsCount,
         bool* areStatsDirty
     );
+    // must be called before calculation of stats for a new tree level
+    void StartTreeLevel();
     void GarbageCollect();
+    const TBucketStatsCacheCounters& GetCounters() const {
+        return Counters;
+    }
     static TVector<TBucketStats> GetStatsInUse(
         int segmentCount,
         int segmentSize,
         int statsCount,
-        const TVector<TBucketStats, TPoolAllocator>& cachedStats
+        const TStatsVector& cachedStats
     );
 
 public:
-    THashMap<TSplitEnsemble, THolder<TVector<TBucketStats, TPoolAllocator>>> Stats;
+    THashMap<TSplitEnsemble, TCachedStats> Stats;
+
+private:
+    THolder<TStatsVector> EvictStats(size_t minCapacity);
 
 private:
     THolder<TMemoryPool> MemoryPool;
@@ -153,8 +179,19 @@ private:
     size_t InitialSize = 0;
     int MaxBodyTailCount = 0;
     int ApproxDimension = 0;
+
+    ui64 MemoryLimit = Max<ui64>();
+    ui64 AllocatedSize = 0;
+    ui64 CurrentLevel = 1;
+    TVector<TSplitEnsemble> EvictionQueue; // stats not used at the current level, most recently used first
+    ui64 EvictionQueueLevel = 0;
+    TBucketStatsCacheCounters Counters;
 };
 
+/* Part of CPU RAM left by used_ram_limit after data loading given to TBucketStatsCache
+ */
+ui64 GetBucketStatsCacheMemoryLimit(ui64 cpuUsedRamLimit);
+
 class TCalcScoreFold {
 public:
     template <typename TDataType>
@@ -367,7 +404,7 @@ public:
     TUnsizedVector<float> SampleWeights;
     TVector<TQueryInfo> LearnQueriesInfo;
     TUnsizedVector<TBodyTail> BodyTailArr; // [tail][dim][doc]
-    bool SmallestSplitSideValue;
+    TVector<ui8> SmallestSplitSideValues; // [leaf of previous level], split value with smaller doc count
     int NonCtrDataPermutationBlockSize = FoldPermutationBlockSizeNotSet;
     int CtrDataPermutationBlockSize = FoldPermutationBlockSizeNotSet;
     ui32 LeavesCount;
@@ -395,7 +432,9 @@ struct TStats3D {
     TSplitEnsembleSpec SplitEnsembleSpec;
 
 public:
-    SAVELOAD(Stats, BucketCount, MaxLeafCount, SplitEnsembleSpec);
+    // Stats are written in compact lossless form (see PackBucketStats) because they are sent over network
+    //  in distributed training
+    int operator&(IBinSaver& binSaver);
 
     void Add(const TStats3D& stats3D);
 };
@@ -20,6 +20,7 @@
 #include <catboost/private/libs/algo_helpers/langevin_utils.h>
 #include <catboost/private/libs/distributed/master.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/fast_log/fast_log.h>
 
 #include <util/generic/cast.h>
@@ -587,6 +588,7 @@ static void CalcBestScore(
     TFold* fold,
     TLearnContext* ctx) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcBestScore");
     const TFlatPairsInfo pairs = UnpackPairsFromQueries(fold->LearnQueriesInfo);
     TCandidateList& candList = candidatesContext->CandidateList;
     const auto& monotonicConstraints = ctx->Params.ObliviousTreeOptions->MonotoneConstraints.Get();
@@ -732,6 +734,7 @@ static void CalcBestScoreLeafwise(
     TFold* fold,
     TLearnContext* ctx) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcBestScoreLeafwise");
     TCandidateList& candList = candidatesContext->CandidateList;
 
     ctx->LocalExecutor->ExecRange(
@@ -876,6 +879,9 @@ TSplitTree GreedyTensorSearchOblivious(
         AddFloatFeatures(*data.Learn->ObjectsData, &candidatesContext.CandidateList);
         AddOneHotFeatures(*data.Learn->ObjectsData, ctx, &candidatesContext.CandidateList);
         CompressCandidates(*data.Learn->ObjectsData, &candidatesContext);
+        if (ctx->UseTreeLevelCaching()) {
+            ctx->PrevTreeLevelStats.StartTreeLevel();
+        }
         SelectCandidatesAndCleanupStatsFromPrevTree(ctx, &candidatesContext, &ctx->PrevTreeLevelStats);
 
         AddSimpleCtrs(
@@ -997,6 +1003,11 @@ TSplitTree GreedyTensorSearchOblivious(
             break;
         }
     }
+    if (ctx->UseTreeLevelCaching() && ctx->Params.SystemOptions->IsSingleHost()) {
+        const auto& cacheCounters = ctx->PrevTreeLevelStats.GetCounters();
+        CATBOOST_INFO_LOG << "Tree level stats cache: hits " << cacheCounters.Hits
+            << " misses " << cacheCounters.Misses << " evictions " << cacheCounters.Evictions << "\n";
+    }
     return currentSplitTree;
 }
 
@@ -1025,6 +1036,7 @@ void GreedyTensorSearch(
     TLearnContext* ctx,
     TVariant<TSplitTree, TNonSymmetricTreeStructure>* resTreeStructure) {
 
+    CHROMIUM_TRACE_FUNCTION_NAME("GreedyTensorSearch");
     TrimOnlineCTRcache({fold});
 
     ui32 learnSampleCount = data.Learn->ObjectsData->GetObjectCount();
@@ -6,6 +6,7 @@
 #include <catboost/private/libs/distributed/master.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/malloc/api/malloc.h>
 
 #include <functional>
@@ -166,47 +167,48 @@ static TVector<int> FilterTestPools(const TTrainingForCPUDataProviders& training
     return filtered;
 }
 
-void CalcErrors(
+TIterationMetricValues CalcMetricValues(
     const TTrainingForCPUDataProviders& trainingDataProviders,
     const TVector<THolder<IMetric>>& errors,
     bool calcAllMetrics,
     bool calcErrorTrackerMetric,
-    TLearnContext* ctx
+    bool calcLearnMetrics,
+    const TVector<TVector<double>>& learnApprox,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcMetricValues");
+    TIterationMetricValues metricValues;
     if (trainingDataProviders.Learn->GetObjectCount() > 0) {
-        ctx->LearnProgress->MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
-        if (calcAllMetrics) {
-            if (ctx->Params.SystemOptions->IsSingleHost()) {
-                auto trainMetrics = FilterTrainMetrics(errors);
-
-                const auto& targetData = trainingDataProviders.Learn->TargetData;
-
-                auto weights = GetWeights(*targetData);
-                auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
-
-                auto errors = EvalErrorsWithCaching(
-                    ctx->LearnProgress->AvrgApprox,
-                    /*approxDelta*/{},
-                    /*isExpApprox*/false,
-                    targetData->GetTarget().GetOrElse(TConstArrayRef<TConstArrayRef<float>>()),
-                    weights,
-                    queryInfo,
-                    trainMetrics,
-                    ctx->LocalExecutor
-                );
-
-                for (auto i : xrange(trainMetrics.size())) {
-                    auto metric = trainMetrics[i];
-                    ctx->LearnProgress->MetricsAndTimeHistory.AddLearnError(*metric, metric->GetFinalError(errors[i]));
-                }
-            } else {
-                MapCalcErrors(ctx);
+        metricValues.HasLearn = true;
+        if (calcAllMetrics && calcLearnMetrics) {
+            auto trainMetrics = FilterTrainMetrics(errors);
+
+            const auto& targetData = trainingDataProviders.Learn->TargetData;
+
+            auto weights = GetWeights(*targetData);
+            auto queryInfo = targetData->GetGroupInfo().GetOrElse(TConstArrayRef<TQueryInfo>());
+
+            auto errors = EvalErrorsWithCaching(
+                learnApprox,
+                /*approxDelta*/{},
+                /*isExpApprox*/false,
+                targetData->GetTarget().GetOrElse(TConstArrayRef<TConstArrayRef<float>>()),
+                weights,
+                queryInfo,
+                trainMetrics,
+                localExecutor
+            );
+
+            for (auto i : xrange(trainMetrics.size())) {
+                auto metric = trainMetrics[i];
+                metricValues.Learn.push_back({metric, metric->GetFinalError(errors[i])});
             }
         }
     }
 
     if (trainingDataProviders.GetTestSampleCount() > 0) {
-        ctx->LearnProgress->MetricsAndTimeHistory.TestMetricsHistory.emplace_back();
+        metricValues.HasTest = true;
         for (auto testIdx : FilterTestPools(trainingDataProviders, calcAllMetrics)) {
             const auto &targetData = trainingDataProviders.Test[testIdx]->TargetData;
 
@@ -219,28 +221,68 @@ void CalcErrors(
             auto testMetrics = FilterTestMetrics(errors, calcAllMetrics, maybeTarget.Defined(), trackerIdx, &filteredTrackerIdx);
 
             auto errors = EvalErrorsWithCaching(
-                ctx->LearnProgress->TestApprox[testIdx],
+                testApprox[testIdx],
                 /*approxDelta*/{},
                 /*isExpApprox*/false,
                 maybeTarget.GetOrElse(TConstArrayRef<TConstArrayRef<float>>()),
                 weights,
                 queryInfo,
                 testMetrics,
-                ctx->LocalExecutor
+                localExecutor
             );
 
+            auto& testValues = metricValues.Test.emplace_back(testIdx, TVector<TMetricValue>()).second;
             for (int i : xrange(testMetrics.size())) {
                 auto metric = testMetrics[i];
                 const bool updateBestIteration = filteredTrackerIdx && (i == *filteredTrackerIdx)
                     && (testIdx == SafeIntegerCast<int>(trainingDataProviders.Test.size() - 1));
 
-                ctx->LearnProgress->MetricsAndTimeHistory.AddTestError(
-                    testIdx,
-                    *metric,
-                    metric->GetFinalError(errors[i]),
-                    updateBestIteration
-                );
+                testValues.push_back({metric, metric->GetFinalError(errors[i]), updateBestIteration});
+            }
+        }
+    }
+    return metricValues;
+}
+
+void AddMetricValues(const TIterationMetricValues& metricValues, TMetricsAndTimeLeftHistory* metricsAndTimeHistory) {
+    if (metricValues.HasLearn) {
+        metricsAndTimeHistory->LearnMetricsHistory.emplace_back();
+        for (const auto& value : metricValues.Learn) {
+            metricsAndTimeHistory->AddLearnError(*value.Metric, value.Value);
+        }
+    }
+    if (metricValues.HasTest) {
+        metricsAndTimeHistory->TestMetricsHistory.emplace_back();
+        for (const auto& [testIdx, testValues] : metricValues.Test) {
+            for (const auto& value : testValues) {
+                metricsAndTimeHistory->AddTestError(testIdx, *value.Metric, value.Value, value.UpdateBestIteration);
             }
         }
     }
 }
+
+void CalcErrors(
+    const TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric,
+    TLearnContext* ctx
+) {
+    const bool isSingleHost = ctx->Params.SystemOptions->IsSingleHost();
+    AddMetricValues(
+        CalcMetricValues(
+            trainingDataProviders,
+            errors,
+            calcAllMetrics,
+            calcErrorTrackerMetric,
+            /*calcLearnMetrics*/ isSingleHost,
+            ctx->LearnProgress->AvrgApprox,
+            ctx->LearnProgress->TestApprox,
+            ctx->LocalExecutor
+        ),
+        &ctx->LearnProgress->MetricsAndTimeHistory
+    );
+    if (trainingDataProviders.Learn->GetObjectCount() > 0 && calcAllMetrics && !isSingleHost) {
+        MapCalcErrors(ctx);
+    }
+}
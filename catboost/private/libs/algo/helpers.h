@@ -7,8 +7,11 @@
 #include <util/generic/ptr.h>
 #include <util/generic/vector.h>
 
+#include <utility>
+
 
 class TLearnContext;
+struct TMetricsAndTimeLeftHistory;
 
 namespace NCB {
     class TFeaturesLayout;
@@ -34,6 +37,36 @@ double CalcMetric(
     NPar::TLocalExecutor* localExecutor
 );
 
+struct TMetricValue {
+    const IMetric* Metric;
+    double Value;
+    bool UpdateBestIteration = false;
+};
+
+// Metric values of one iteration that are not added to metrics history yet
+struct TIterationMetricValues {
+    bool HasLearn = false; // add learn metrics history entry even if there are no values for learn
+    TVector<TMetricValue> Learn;
+    bool HasTest = false;
+    TVector<std::pair<int, TVector<TMetricValue>>> Test; // [(testIdx, values)]
+};
+
+/* Doesn't access learn progress, so it is safe to call it for copies of approxes while the next tree is trained.
+ * Learn metrics are calculated only if calcLearnMetrics is set (they are calculated by workers in distributed mode).
+ */
+TIterationMetricValues CalcMetricValues(
+    const NCB::TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric,
+    bool calcLearnMetrics,
+    const TVector<TVector<double>>& learnApprox, // [dim][docIdx], averaged
+    const TVector<TVector<TVector<double>>>& testApprox, // [test][dim][docIdx]
+    NPar::TLocalExecutor* localExecutor
+);
+
+void AddMetricValues(const TIterationMetricValues& metricValues, TMetricsAndTimeLeftHistory* metricsAndTimeHistory);
+
 void CalcErrors(
     const NCB::TTrainingForCPUDataProviders& trainingDataProviders,
     const TVector<THolder<IMetric>>& errors,
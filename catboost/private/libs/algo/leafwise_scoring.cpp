@@ -304,7 +304,15 @@ static void CalcScoresForSubCandidate(
             updateSplitScoreClosure);
     };
 
-    if (!ctx->UseTreeLevelCaching()) {
+    bool areStatsDirty = true;
+    TBucketStatsCache::TStatsVector* cachedStats = nullptr;
+    if (ctx->UseTreeLevelCaching()) {
+        int maxStatsCount = bucketCount * (1 << ctx->Params.ObliviousTreeOptions->MaxDepth);
+        // nullptr if cache memory limit is reached
+        cachedStats = ctx->PrevTreeLevelStats.GetStats(candidateInfo.SplitEnsemble, maxStatsCount, &areStatsDirty);
+    }
+
+    if (cachedStats == nullptr) {
         extractBucketIndex(TIndexRange<ui32>(0, fold.GetDocCount()));
 
         TVector<TBucketStats> stats;
@@ -321,10 +329,7 @@ static void CalcScoresForSubCandidate(
             }
         }
     } else { /* UseTreeLevelCaching */
-        bool areStatsDirty;
-        int maxStatsCount = bucketCount * (1 << ctx->Params.ObliviousTreeOptions->MaxDepth);
-        TVector<TBucketStats, TPoolAllocator>& stats =
-            ctx->PrevTreeLevelStats.GetStats(candidateInfo.SplitEnsemble, maxStatsCount, &areStatsDirty);
+        TBucketStatsCache::TStatsVector& stats = *cachedStats;
 
         if (fold.LeavesBounds.size() == 1 || areStatsDirty) {
             extractBucketIndex(TIndexRange<ui32>(0, fold.GetDocCount()));
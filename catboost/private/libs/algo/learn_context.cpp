@@ -20,6 +20,7 @@
 
 #include <library/digest/crc32c/crc32c.h>
 #include <library/digest/md5/md5.h>
+#include <library/threading/future/async.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/digest/multi.h>
@@ -29,6 +30,7 @@
 #include <util/generic/xrange.h>
 #include <util/folder/path.h>
 #include <util/stream/file.h>
+#include <util/stream/str.h>
 #include <util/system/fs.h>
 
 
@@ -367,24 +369,74 @@ TLearnContext::TLearnContext(
 
 
 TLearnContext::~TLearnContext() {
+    // destructor can run during exception unwinding, so snapshot saving errors are logged, not rethrown
+    if (SnapshotSaving.Initialized()) {
+        SnapshotSaving.Wait();
+        try {
+            SnapshotSaving.TryRethrow();
+        } catch (...) {
+            CATBOOST_ERROR_LOG << "Saving snapshot to " << Files.SnapshotFile << " failed: "
+                << CurrentExceptionMessage() << Endl;
+        }
+    }
     if (Params.SystemOptions->IsMaster()) {
         FinalizeMaster(this);
     }
 }
 
-void TLearnContext::SaveProgress(std::function<void(IOutputStream*)> onSaveSnapshot) {
-    if (!OutputOptions.SaveSnapshot()) {
-        return;
-    }
-    const auto snapshotBackup = Files.SnapshotFile + ".bak";
+static void WriteSnapshot(
+    const TString& snapshotFile,
+    TStringBuf callbacksData,
+    const TLearnProgress& learnProgress,
+    const TProfileInfoData& profileInfo
+) {
+    const auto snapshotBackup = snapshotFile + ".bak";
     TProgressHelper(ToString(ETaskType::CPU)).Write(
         snapshotBackup,
         [&](IOutputStream* out) {
-            onSaveSnapshot(out);
-            ::SaveMany(out, *LearnProgress, Profile.DumpProfileInfo());
+            out->Write(callbacksData);
+            ::SaveMany(out, learnProgress, profileInfo);
         }
     );
-    TFsPath(snapshotBackup).ForceRenameTo(Files.SnapshotFile);
+    TFsPath(snapshotBackup).ForceRenameTo(snapshotFile);
+}
+
+void TLearnContext::SaveProgress(std::function<void(IOutputStream*)> onSaveSnapshot, bool async) {
+    if (!OutputOptions.SaveSnapshot()) {
+        return;
+    }
+    WaitForSavedProgress();
+    // callbacks data and progress are captured now, so training can modify progress while snapshot is written
+    TString callbacksData;
+    {
+        TStringOutput out(callbacksData);
+        onSaveSnapshot(&out);
+    }
+    if (!async) {
+        WriteSnapshot(Files.SnapshotFile, callbacksData, *LearnProgress, Profile.DumpProfileInfo());
+        return;
+    }
+    if (!SnapshotSavingQueue) {
+        SnapshotSavingQueue = CreateThreadPool(1);
+    }
+    SnapshotSaving = NThreading::Async(
+        [
+            snapshotFile = Files.SnapshotFile,
+            callbacksData = std::move(callbacksData),
+            learnProgress = MakeAtomicShared<TLearnProgress>(*LearnProgress),
+            profileInfo = Profile.DumpProfileInfo()
+        ] () {
+            WriteSnapshot(snapshotFile, callbacksData, *learnProgress, profileInfo);
+        },
+        *SnapshotSavingQueue
+    );
+}
+
+void TLearnContext::WaitForSavedProgress() {
+    if (SnapshotSaving.Initialized()) {
+        SnapshotSaving.GetValueSync();
+        SnapshotSaving = NThreading::TFuture<void>();
+    }
 }
 
 bool TLearnContext::TryLoadProgress(std::function<bool(IInputStream*)> onLoadSnapshot) {
@@ -20,10 +20,12 @@
 #include <catboost/private/libs/options/catboost_options.h>
 
 #include <library/json/json_reader.h>
+#include <library/threading/future/future.h>
 
 #include <util/generic/noncopyable.h>
 #include <util/generic/hash_set.h>
 #include <util/generic/ptr.h>
+#include <util/thread/pool.h>
 
 
 namespace NPar {
@@ -193,7 +195,15 @@ public:
 
     ~TLearnContext();
 
-    void SaveProgress(std::function<void(IOutputStream*)> onSaveSnapshot = [] (IOutputStream* /*snapshot*/) {});
+    /**
+     * Save current progress to snapshot file. If async is set, progress is copied and written in background
+     *  while training goes on. At most one snapshot is written at a time: previous one is waited for first.
+     */
+    void SaveProgress(
+        std::function<void(IOutputStream*)> onSaveSnapshot = [] (IOutputStream* /*snapshot*/) {},
+        bool async = false);
+    //! Wait for snapshot written in background by SaveProgress
+    void WaitForSavedProgress();
     bool TryLoadProgress(std::function<bool(IInputStream*)> onLoadSnapshot = [] (IInputStream* /*snapshot*/) { return true; });
     bool UseTreeLevelCaching() const;
     bool GetHasWeights() const;
@@ -213,6 +223,8 @@ public:
 private:
     bool UseTreeLevelCachingFlag;
     bool HasWeights;
+    THolder<IThreadPool> SnapshotSavingQueue;
+    NThreading::TFuture<void> SnapshotSaving;
 };
 
 bool NeedToUseTreeLevelCaching(
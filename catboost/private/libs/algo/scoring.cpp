@@ -17,11 +17,16 @@
 #include <catboost/private/libs/index_range/index_range.h>
 #include <catboost/private/libs/options/catboost_options.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/threading/local_executor/local_executor.h>
 #include <library/dot_product/dot_product.h>
 
 #include <util/generic/array_ref.h>
+#include <util/generic/xrange.h>
 
+#include <library/sse/sse.h>
+
+#include <cstddef>
 #include <type_traits>
 
 
@@ -218,6 +223,23 @@ inline static void BuildSingleIndex(
 }
 
 
+static_assert(
+    offsetof(TBucketStats, SumWeight) == offsetof(TBucketStats, SumWeightedDelta) + sizeof(double) &&
+    offsetof(TBucketStats, Count) == offsetof(TBucketStats, SumDelta) + sizeof(double),
+    "Pairs of sums updated together must be adjacent in TBucketStats"
+);
+
+// Add (der, weight) to a pair of adjacent sums in one instruction, the result is the same as of two scalar adds
+inline static void AddToSumPair(double der, double weight, double* sumPair) {
+#ifdef _sse2_
+    _mm_storeu_pd(sumPair, _mm_add_pd(_mm_loadu_pd(sumPair), _mm_set_pd(weight, der)));
+#else
+    sumPair[0] += der;
+    sumPair[1] += weight;
+#endif
+}
+
+
 // Update bootstraped sums on docIndexRange in a bucket
 template <typename TFullIndexType>
 inline static void UpdateWeighted(
@@ -227,10 +249,9 @@ inline static void UpdateWeighted(
     NCB::TIndexRange<int> docIndexRange,
     TBucketStats* stats
 ) {
+    const TFullIndexType* singleIdxData = singleIdx.data();
     for (int doc : docIndexRange.Iter()) {
-        TBucketStats& leafStats = stats[singleIdx[doc]];
-        leafStats.SumWeightedDelta += weightedDer[doc];
-        leafStats.SumWeight += sampleWeights[doc];
+        AddToSumPair(weightedDer[doc], sampleWeights[doc], &stats[singleIdxData[doc]].SumWeightedDelta);
     }
 }
 
@@ -244,17 +265,14 @@ inline static void UpdateDeltaCount(
     NCB::TIndexRange<int> docIndexRange,
     TBucketStats* stats
 ) {
+    const TFullIndexType* singleIdxData = singleIdx.data();
     if (learnWeights == nullptr) {
         for (int doc : docIndexRange.Iter()) {
-            TBucketStats& leafStats = stats[singleIdx[doc]];
-            leafStats.SumDelta += derivatives[doc];
-            leafStats.Count += 1;
+            AddToSumPair(derivatives[doc], 1.0, &stats[singleIdxData[doc]].SumDelta);
         }
     } else {
         for (int doc : docIndexRange.Iter()) {
-            TBucketStats& leafStats = stats[singleIdx[doc]];
-            leafStats.SumDelta += derivatives[doc];
-            leafStats.Count += learnWeights[doc];
+            AddToSumPair(derivatives[doc], learnWeights[doc], &stats[singleIdxData[doc]].SumDelta);
         }
     }
 }
@@ -324,21 +342,27 @@ inline static void CalcStatsKernel(
     }
 }
 
+// Stats of the side of each leaf which was not selected as the smallest one are obtained by subtraction
+// of the smallest side stats from the parent leaf stats cached at the previous level
 inline static void FixUpStats(
     int depth,
     const TStatsIndexer& indexer,
-    bool selectedSplitValue,
+    TConstArrayRef<ui8> selectedSplitValues,
     TBucketStats* stats
 ) {
+    const int parentLeafCount = 1 << (depth - 1);
     const int halfOfStats = indexer.CalcSize(depth - 1);
-    if (selectedSplitValue == true) {
-        for (int statIdx = 0; statIdx < halfOfStats; ++statIdx) {
-            stats[statIdx].Remove(stats[statIdx + halfOfStats]);
+    Y_ASSERT(selectedSplitValues.size() == (size_t)parentLeafCount);
+    for (int parentLeafIdx : xrange(parentLeafCount)) {
+        TBucketStats* parentStats = stats + indexer.GetIndex(parentLeafIdx, 0);
+        TBucketStats* selectedSideStats = parentStats + halfOfStats;
+        for (int bucketIdx : xrange(indexer.BucketCount)) {
+            parentStats[bucketIdx].Remove(selectedSideStats[bucketIdx]);
         }
-    } else {
-        for (int statIdx = 0; statIdx < halfOfStats; ++statIdx) {
-            stats[statIdx].Remove(stats[statIdx + halfOfStats]);
-            DoSwap(stats[statIdx], stats[statIdx + halfOfStats]);
+        if (!selectedSplitValues[parentLeafIdx]) {
+            for (int bucketIdx : xrange(indexer.BucketCount)) {
+                DoSwap(parentStats[bucketIdx], selectedSideStats[bucketIdx]);
+            }
         }
     }
 }
@@ -601,7 +625,7 @@ static void CalcStatsImpl(
         forEachBodyTailAndApproxDimension(
             [&](int /*bodyTailIdx*/, int /*dim*/, int bucketStatsArrayBegin) {
                 TBucketStats* statsSubset = stats->GetData().data() + bucketStatsArrayBegin;
-                FixUpStats(depth, indexer, fold.SmallestSplitSideValue, statsSubset);
+                FixUpStats(depth, indexer, fold.SmallestSplitSideValues, statsSubset);
             }
         );
     }
@@ -835,6 +859,7 @@ void CalcStatsAndScores(
     TPairwiseStats* pairwiseStats,
     IScoreCalcer* scoreCalcer
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcStatsAndScores");
     CB_ENSURE(
         stats3d || pairwiseStats || scoreCalcer,
         "stats3d, pairwiseStats, and scoreCalcer are empty - nothing to calculate"
@@ -950,7 +975,18 @@ void CalcStatsAndScores(
 
         const auto& treeOptions = fitParams.ObliviousTreeOptions.Get();
 
-        if (!useTreeLevelCaching) {
+        bool areStatsDirty = true;
+        TBucketStatsCache::TStatsVector* splitStatsFromCache = nullptr;
+        if (useTreeLevelCaching) {
+            // thread-safe access, nullptr if cache memory limit is reached
+            splitStatsFromCache = statsFromPrevTree->GetStats(
+                splitEnsemble,
+                indexer.CalcSize(treeOptions.MaxDepth),
+                &areStatsDirty
+            );
+        }
+
+        if (splitStatsFromCache == nullptr) {
             splitStatsCount = indexer.CalcSize(depth);
             const int statsCount =
                 fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
@@ -975,12 +1011,7 @@ void CalcStatsAndScores(
             );
         } else {
             splitStatsCount = indexer.CalcSize(treeOptions.MaxDepth);
-            bool areStatsDirty;
-
-            // thread-safe access
-            TVector<TBucketStats, TPoolAllocator>& splitStatsFromCache =
-                statsFromPrevTree->GetStats(splitEnsemble, splitStatsCount, &areStatsDirty);
-            extOrInSplitStats = TBucketStatsRefOptionalHolder(splitStatsFromCache);
+            extOrInSplitStats = TBucketStatsRefOptionalHolder(*splitStatsFromCache);
             if (depth == 0 || areStatsDirty) {
                 selectCalcStatsImpl(
                     /*isCaching*/ std::false_type(),
@@ -1000,7 +1031,7 @@ void CalcStatsAndScores(
                 TBucketStatsCache::GetStatsInUse(fold.GetBodyTailCount() * fold.GetApproxDimension(),
                     splitStatsCount,
                     indexer.CalcSize(depth),
-                    splitStatsFromCache
+                    *splitStatsFromCache
                 ).swap(stats3d->Stats);
                 stats3d->BucketCount = bucketCount;
                 stats3d->MaxLeafCount = 1U << depth;
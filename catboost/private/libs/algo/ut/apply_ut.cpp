@@ -4,6 +4,8 @@
 #include <catboost/libs/data/data_provider_builders.h>
 #include <catboost/libs/model/ut/lib/model_test_helpers.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/generic/vector.h>
 #include <util/generic/xrange.h>
 #include <util/system/types.h>
@@ -145,4 +147,38 @@ Y_UNIT_TEST_SUITE(TLeafIndexCalcerOnPool) {
         };
         CheckLeafIndexCalcer(model, DEFAULT_FEATURES, expectedLeafIndexes);
     }
+
+    Y_UNIT_TEST(TestStagedApproxMatchesTruncatedModels) {
+        const auto model = SimpleFloatModel(3);
+        TObjectsDataProviderPtr objectsData = CreateObjectsDataProviderWithFeatures(DEFAULT_FEATURES);
+
+        NPar::TLocalExecutor executor;
+        executor.RunAdditionalThreads(1);
+        TModelCalcerOnPool modelCalcer(model, objectsData, &executor);
+
+        TVector<int> stageEnds;
+        TVector<TVector<double>> approx;
+        modelCalcer.ApplyModelStaged(
+            /*begin*/ 0,
+            /*end*/ 3,
+            /*evalPeriod*/ 2,
+            &approx,
+            [&] (int stageEnd, const TVector<TVector<double>>& stageApprox) {
+                stageEnds.push_back(stageEnd);
+                const auto expectedApprox = ApplyModelMulti(
+                    model,
+                    *objectsData,
+                    EPredictionType::RawFormulaVal,
+                    /*begin*/ 0,
+                    stageEnd);
+                UNIT_ASSERT_VALUES_EQUAL(stageApprox.size(), expectedApprox.size());
+                for (auto dim : xrange(expectedApprox.size())) {
+                    UNIT_ASSERT_VALUES_EQUAL(stageApprox[dim].size(), expectedApprox[dim].size());
+                    for (auto objectIdx : xrange(expectedApprox[dim].size())) {
+                        UNIT_ASSERT_DOUBLES_EQUAL(stageApprox[dim][objectIdx], expectedApprox[dim][objectIdx], 1e-9);
+                    }
+                }
+            });
+        UNIT_ASSERT_VALUES_EQUAL(stageEnds, (TVector<int>{2, 3}));
+    }
 }
@@ -0,0 +1,96 @@
+#include <library/unittest/registar.h>
+#include <catboost/private/libs/algo/calc_score_cache.h>
+#include <catboost/private/libs/algo/fold.h>
+#include <catboost/private/libs/algo/split.h>
+
+#include <library/binsaver/util_stream_io.h>
+
+#include <util/generic/buffer.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/buffer.h>
+
+static TSplitEnsemble MakeFloatSplitEnsemble(int featureIdx) {
+    TSplitCandidate splitCandidate;
+    splitCandidate.FeatureIdx = featureIdx;
+    splitCandidate.Type = ESplitType::FloatFeature;
+    return TSplitEnsemble(std::move(splitCandidate));
+}
+
+Y_UNIT_TEST_SUITE(BucketStatsCache) {
+    Y_UNIT_TEST(TestMemoryLimitAndEviction) {
+        const int bucketCount = 4;
+        const int depth = 2;
+        const int splitStatsCount = bucketCount * (1 << depth);
+
+        TVector<TFold> folds(1);
+        TFold::TBodyTail bt;
+        bt.Approx.resize(1);
+        folds[0].BodyTailArr.emplace_back(std::move(bt));
+
+        TBucketStatsCache cache;
+        cache.Create(folds, bucketCount, depth, 2 * splitStatsCount * sizeof(TBucketStats));
+
+        bool areStatsDirty = false;
+        cache.StartTreeLevel();
+        auto* firstStats = cache.GetStats(MakeFloatSplitEnsemble(0), splitStatsCount, &areStatsDirty);
+        UNIT_ASSERT(firstStats != nullptr);
+        UNIT_ASSERT(areStatsDirty);
+        UNIT_ASSERT_VALUES_EQUAL(firstStats->ysize(), splitStatsCount);
+        UNIT_ASSERT(cache.GetStats(MakeFloatSplitEnsemble(1), splitStatsCount, &areStatsDirty) != nullptr);
+        // stats of the current level can't be evicted
+        UNIT_ASSERT(cache.GetStats(MakeFloatSplitEnsemble(2), splitStatsCount, &areStatsDirty) == nullptr);
+
+        cache.StartTreeLevel();
+        UNIT_ASSERT_EQUAL(cache.GetStats(MakeFloatSplitEnsemble(0), splitStatsCount, &areStatsDirty), firstStats);
+        UNIT_ASSERT(!areStatsDirty);
+        auto* thirdStats = cache.GetStats(MakeFloatSplitEnsemble(2), splitStatsCount, &areStatsDirty);
+        UNIT_ASSERT(thirdStats != nullptr);
+        UNIT_ASSERT(areStatsDirty);
+        UNIT_ASSERT(!cache.Stats.contains(MakeFloatSplitEnsemble(1)));
+        UNIT_ASSERT(cache.GetStats(MakeFloatSplitEnsemble(1), splitStatsCount, &areStatsDirty) == nullptr);
+
+        const auto& counters = cache.GetCounters();
+        UNIT_ASSERT_VALUES_EQUAL(counters.Hits, 1u);
+        UNIT_ASSERT_VALUES_EQUAL(counters.Misses, 5u);
+        UNIT_ASSERT_VALUES_EQUAL(counters.Evictions, 1u);
+    }
+}
+
+Y_UNIT_TEST_SUITE(Stats3DSerialization) {
+    Y_UNIT_TEST(TestSaveAndLoadAreLossless) {
+        TStats3D stats;
+        stats.BucketCount = 16;
+        stats.MaxLeafCount = 8;
+        stats.Stats.resize(stats.BucketCount * stats.MaxLeafCount, TBucketStats{0, 0, 0, 0});
+        TFastRng64 rng(0);
+        for (int statIdx : xrange(stats.Stats.ysize() / 2)) {
+            auto& bucketStats = stats.Stats[statIdx];
+            bucketStats.SumWeightedDelta = rng.GenRandReal1() - 0.5;
+            bucketStats.SumWeight = rng.GenRandReal1();
+            bucketStats.SumDelta = -1e-300 * rng.GenRandReal1();
+            bucketStats.Count = rng.Uniform(100);
+        }
+
+        TBuffer buffer;
+        {
+            TBufferOutput out(buffer);
+            SerializeToStream(out, stats);
+        }
+        TStats3D loadedStats;
+        {
+            TBufferInput in(buffer);
+            SerializeFromStream(in, loadedStats);
+        }
+
+        UNIT_ASSERT_VALUES_EQUAL(loadedStats.BucketCount, stats.BucketCount);
+        UNIT_ASSERT_VALUES_EQUAL(loadedStats.MaxLeafCount, stats.MaxLeafCount);
+        UNIT_ASSERT_VALUES_EQUAL(loadedStats.Stats.size(), stats.Stats.size());
+        UNIT_ASSERT_EQUAL(
+            memcmp(loadedStats.Stats.data(), stats.Stats.data(), stats.Stats.size() * sizeof(TBucketStats)),
+            0
+        );
+        UNIT_ASSERT(buffer.Size() < stats.Stats.size() * sizeof(TBucketStats));
+    }
+}
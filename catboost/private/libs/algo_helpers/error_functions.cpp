@@ -2,9 +2,12 @@
 
 #include <util/generic/xrange.h>
 
+#include <type_traits>
 
-template <int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta>
+
+template <class TCalcer, int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta>
 void IDerCalcer::CalcDersRangeImpl(
+    const TCalcer& calcer,
     int start,
     int count,
     const double* approxes,
@@ -13,42 +16,29 @@ void IDerCalcer::CalcDersRangeImpl(
     const float* weights,
     TDers* ders,
     double* firstDers
-) const {
-    Y_ASSERT(UseExpApprox == IsExpApprox);
+) {
+    Y_ASSERT(UseExpApprox == calcer.GetIsExpApprox());
     Y_ASSERT(HasDelta == (approxDeltas != nullptr));
     Y_ASSERT(UseTDers == (ders != nullptr) && (ders != nullptr) == (firstDers == nullptr));
-    Y_ASSERT(MaxDerivativeOrder <= MaxSupportedDerivativeOrder);
+    Y_ASSERT(MaxDerivativeOrder <= (int)calcer.GetMaxSupportedDerivativeOrder());
     Y_ASSERT((MaxDerivativeOrder > 1) <= (ders != nullptr));
+    // weights are applied in the same pass, so derivatives are not loaded from memory again
     for (int i = start; i < start + count; ++i) {
         double updatedApprox = approxes[i];
         if (HasDelta) {
             updatedApprox = UpdateApprox<UseExpApprox>(updatedApprox, approxDeltas[i]);
         }
+        const double weight = weights ? weights[i] : 1.0;
         if (UseTDers) {
-            ders[i].Der1 = CalcDer(updatedApprox, targets[i]);
+            ders[i].Der1 = calcer.CalcDer(updatedApprox, targets[i]) * weight;
         } else {
-            firstDers[i] = CalcDer(updatedApprox, targets[i]);
+            firstDers[i] = calcer.CalcDer(updatedApprox, targets[i]) * weight;
         }
         if (MaxDerivativeOrder >= 2) {
-            ders[i].Der2 = CalcDer2(updatedApprox, targets[i]);
+            ders[i].Der2 = calcer.CalcDer2(updatedApprox, targets[i]) * weight;
         }
         if (MaxDerivativeOrder >= 3) {
-            ders[i].Der3 = CalcDer3(updatedApprox, targets[i]);
-        }
-    }
-    if (weights != nullptr) {
-        for (int i = start; i < start + count; ++i) {
-            if (UseTDers) {
-                ders[i].Der1 *= weights[i];
-            } else {
-                firstDers[i] *= weights[i];
-            }
-            if (MaxDerivativeOrder >= 2) {
-                ders[i].Der2 *= weights[i];
-            }
-            if (MaxDerivativeOrder >= 3) {
-                ders[i].Der3 *= weights[i];
-            }
+            ders[i].Der3 = calcer.CalcDer3(updatedApprox, targets[i]) * weight;
         }
     }
 }
@@ -62,7 +52,9 @@ static constexpr int EncodeImplParameters(
     return maxDerivativeOrder * 8 + useTDers * 4 + isExpApprox * 2 + hasDelta;
 }
 
-void IDerCalcer::CalcDersRange(
+template <class TCalcer>
+void IDerCalcer::DispatchCalcDersRange(
+    const TCalcer& calcer,
     int start,
     int count,
     int maxDerivativeOrder,
@@ -72,12 +64,13 @@ void IDerCalcer::CalcDersRange(
     const float* weights,
     TDers* ders,
     double* firstDers
-) const {
+) {
     const bool hasDelta = approxDeltas != nullptr;
     const bool useTDers = ders != nullptr;
-    switch (EncodeImplParameters(maxDerivativeOrder, useTDers, IsExpApprox, hasDelta)) {
+    switch (EncodeImplParameters(maxDerivativeOrder, useTDers, calcer.GetIsExpApprox(), hasDelta)) {
         case EncodeImplParameters(1, false, false, false):
-            return CalcDersRangeImpl<1, false, false, false>(
+            return CalcDersRangeImpl<TCalcer, 1, false, false, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -87,7 +80,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, false, false, true):
-            return CalcDersRangeImpl<1, false, false, true>(
+            return CalcDersRangeImpl<TCalcer, 1, false, false, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -97,7 +91,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, false, true, false):
-            return CalcDersRangeImpl<1, false, true, false>(
+            return CalcDersRangeImpl<TCalcer, 1, false, true, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -107,7 +102,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, false, true, true):
-            return CalcDersRangeImpl<1, false, true, true>(
+            return CalcDersRangeImpl<TCalcer, 1, false, true, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -117,7 +113,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, true, false, false):
-            return CalcDersRangeImpl<1, true, false, false>(
+            return CalcDersRangeImpl<TCalcer, 1, true, false, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -127,7 +124,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, true, false, true):
-            return CalcDersRangeImpl<1, true, false, true>(
+            return CalcDersRangeImpl<TCalcer, 1, true, false, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -137,7 +135,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, true, true, false):
-            return CalcDersRangeImpl<1, true, true, false>(
+            return CalcDersRangeImpl<TCalcer, 1, true, true, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -147,7 +146,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(1, true, true, true):
-            return CalcDersRangeImpl<1, true, true, true>(
+            return CalcDersRangeImpl<TCalcer, 1, true, true, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -157,7 +157,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(2, true, false, false):
-            return CalcDersRangeImpl<2, true, false, false>(
+            return CalcDersRangeImpl<TCalcer, 2, true, false, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -167,7 +168,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(2, true, false, true):
-            return CalcDersRangeImpl<2, true, false, true>(
+            return CalcDersRangeImpl<TCalcer, 2, true, false, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -177,7 +179,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(2, true, true, false):
-            return CalcDersRangeImpl<2, true, true, false>(
+            return CalcDersRangeImpl<TCalcer, 2, true, true, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -187,7 +190,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(2, true, true, true):
-            return CalcDersRangeImpl<2, true, true, true>(
+            return CalcDersRangeImpl<TCalcer, 2, true, true, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -197,7 +201,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(3, true, false, false):
-            return CalcDersRangeImpl<3, true, false, false>(
+            return CalcDersRangeImpl<TCalcer, 3, true, false, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -207,7 +212,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(3, true, false, true):
-            return CalcDersRangeImpl<3, true, false, true>(
+            return CalcDersRangeImpl<TCalcer, 3, true, false, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -217,7 +223,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(3, true, true, false):
-            return CalcDersRangeImpl<3, true, true, false>(
+            return CalcDersRangeImpl<TCalcer, 3, true, true, false>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -227,7 +234,8 @@ void IDerCalcer::CalcDersRange(
                 ders,
                 firstDers);
         case EncodeImplParameters(3, true, true, true):
-            return CalcDersRangeImpl<3, true, true, true>(
+            return CalcDersRangeImpl<TCalcer, 3, true, true, true>(
+                calcer,
                 start,
                 count,
                 approxes,
@@ -241,6 +249,89 @@ void IDerCalcer::CalcDersRange(
     }
 }
 
+void IDerCalcer::CalcDersRange(
+    int start,
+    int count,
+    int maxDerivativeOrder,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders,
+    double* firstDers
+) const {
+    DispatchCalcDersRange(
+        *this,
+        start,
+        count,
+        maxDerivativeOrder,
+        approxes,
+        approxDeltas,
+        targets,
+        weights,
+        ders,
+        firstDers);
+}
+
+template <class TChild>
+void TPerObjectDerCalcer<TChild>::CalcFirstDerRange(
+    int start,
+    int count,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    double* firstDers
+) const {
+    static_assert(std::is_final<TChild>::value, "calls of TChild derivatives must be devirtualized");
+    DispatchCalcDersRange(
+        static_cast<const TChild&>(*this),
+        start,
+        count,
+        /*maxDerivativeOrder*/ 1,
+        approxes,
+        approxDeltas,
+        targets,
+        weights,
+        /*ders*/ nullptr,
+        firstDers);
+}
+
+template <class TChild>
+void TPerObjectDerCalcer<TChild>::CalcDersRange(
+    int start,
+    int count,
+    bool calcThirdDer,
+    const double* approxes,
+    const double* approxDeltas,
+    const float* targets,
+    const float* weights,
+    TDers* ders
+) const {
+    static_assert(std::is_final<TChild>::value, "calls of TChild derivatives must be devirtualized");
+    const int maxDerivativeOrder = calcThirdDer ? 3 : Min(GetMaxSupportedDerivativeOrder(), 2u);
+    DispatchCalcDersRange(
+        static_cast<const TChild&>(*this),
+        start,
+        count,
+        maxDerivativeOrder,
+        approxes,
+        approxDeltas,
+        targets,
+        weights,
+        ders,
+        /*firstDers*/ nullptr);
+}
+
+template class TPerObjectDerCalcer<TRMSEError>;
+template class TPerObjectDerCalcer<TQuantileError>;
+template class TPerObjectDerCalcer<TExpectileError>;
+template class TPerObjectDerCalcer<TLqError>;
+template class TPerObjectDerCalcer<TLogLinQuantileError>;
+template class TPerObjectDerCalcer<TMAPError>;
+template class TPerObjectDerCalcer<TPoissonError>;
+template class TPerObjectDerCalcer<THuberError>;
+
 namespace {
     template <int Capacity>
     class TExpForwardView {
@@ -125,6 +125,24 @@ public:
         CB_ENSURE(false, "Not implemented");
     }
 
+protected:
+    /* Calculates derivatives by calcer.CalcDer, calcer.CalcDer2 and calcer.CalcDer3
+     *  that are inlined into the loop over objects if TCalcer is a final class.
+     */
+    template <class TCalcer>
+    static void DispatchCalcDersRange(
+        const TCalcer& calcer,
+        int start,
+        int count,
+        int maxDerivativeOrder,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders,
+        double* firstDers
+    );
+
 private:
     virtual double CalcDer(double /*approx*/, float /*target*/) const {
         CB_ENSURE(false, "Not implemented");
@@ -138,8 +156,9 @@ private:
         CB_ENSURE(false, "Not implemented");
     }
 
-    template <int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta>
-    void CalcDersRangeImpl(
+    template <class TCalcer, int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta>
+    static void CalcDersRangeImpl(
+        const TCalcer& calcer,
         int start,
         int count,
         const double* approxes,
@@ -148,7 +167,7 @@ private:
         const float* weights,
         TDers* ders,
         double* firstDers
-    ) const;
+    );
 
     void CalcDersRange(
         int start,
@@ -169,6 +188,37 @@ private:
     const EHessianType HessianType;
 };
 
+/* Base for losses with per-object derivatives: TChild is a final class overriding CalcDer, CalcDer2 and CalcDer3,
+ *  range methods call them through TChild, so the calls are devirtualized and inlined into the loop over objects.
+ * Instantiated in error_functions.cpp.
+ */
+template <class TChild>
+class TPerObjectDerCalcer : public IDerCalcer {
+public:
+    using IDerCalcer::IDerCalcer;
+
+    void CalcFirstDerRange(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        double* firstDers
+    ) const override;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        bool calcThirdDer,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders
+    ) const override;
+};
+
 class TMultiDerCalcer : public IDerCalcer {
 public:
     static constexpr int MaxDerivativeOrder = 2;
@@ -245,19 +295,18 @@ public:
     ) const override;
 };
 
-class TRMSEError final : public IDerCalcer {
+class TRMSEError final : public TPerObjectDerCalcer<TRMSEError> {
 public:
     static constexpr double RMSE_DER2 = -1.0;
     static constexpr double RMSE_DER3 = 0.0;
 
 public:
     explicit TRMSEError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         return target - approx;
     }
@@ -271,7 +320,7 @@ private:
     }
 };
 
-class TQuantileError final : public IDerCalcer {
+class TQuantileError final : public TPerObjectDerCalcer<TQuantileError> {
 public:
     static constexpr double QUANTILE_DER2_AND_DER3 = 0.0;
 
@@ -281,7 +330,7 @@ public:
 
 public:
     explicit TQuantileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(0.5)
         , Delta(1e-6)
     {
@@ -289,7 +338,7 @@ public:
     }
 
     TQuantileError(double alpha, double delta, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(alpha)
         , Delta(delta)
     {
@@ -298,7 +347,6 @@ public:
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         const double val = target - approx;
         if (abs(val) < Delta) return 0;
@@ -314,7 +362,7 @@ private:
     }
 };
 
-class TExpectileError final : public IDerCalcer {
+class TExpectileError final : public TPerObjectDerCalcer<TExpectileError> {
 public:
     static constexpr double EXPECTILE_DER3 = 0.0;
 
@@ -323,21 +371,20 @@ public:
 
 public:
     explicit TExpectileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(0.5)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
     TExpectileError(double alpha, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(alpha)
     {
         Y_ASSERT(Alpha > -1e-6 && Alpha < 1.0 + 1e-6);
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         double e = target - approx;
         return (e > 0) ? 2.0 * Alpha * e : 2.0 * (1 - Alpha) * e;
@@ -353,20 +400,19 @@ private:
     }
 };
 
-class TLqError final : public IDerCalcer {
+class TLqError final : public TPerObjectDerCalcer<TLqError> {
 public:
     const double Q;
 
 public:
     TLqError(double q, bool isExpApprox)
-        : IDerCalcer(isExpApprox, /*maxDerivativeOrder*/ q >= 2 ?  3 : 1)
+        : TPerObjectDerCalcer(isExpApprox, /*maxDerivativeOrder*/ q >= 2 ?  3 : 1)
         , Q(q)
     {
         Y_ASSERT(Q >= 1);
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         const double absLoss = abs(approx - target);
         const double absLossQ = std::pow(absLoss, Q - 1);
@@ -384,7 +430,7 @@ private:
     }
 };
 
-class TLogLinQuantileError final : public IDerCalcer {
+class TLogLinQuantileError final : public TPerObjectDerCalcer<TLogLinQuantileError> {
 public:
     static constexpr double QUANTILE_DER2_AND_DER3 = 0.0;
 
@@ -393,21 +439,20 @@ public:
 
 public:
     explicit TLogLinQuantileError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(0.5)
     {
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
     TLogLinQuantileError(double alpha, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Alpha(alpha)
     {
         Y_ASSERT(Alpha > -1e-6 && Alpha < 1.0 + 1e-6);
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approxExp, float target) const override {
         return (target - approxExp > 0) ? Alpha * approxExp : -(1 - Alpha) * approxExp;
     }
@@ -421,18 +466,17 @@ private:
     }
 };
 
-class TMAPError final : public IDerCalcer {
+class TMAPError final : public TPerObjectDerCalcer<TMAPError> {
 public:
     static constexpr double MAPE_DER2_AND_DER3 = 0.0;
 
 public:
     explicit TMAPError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         return (target - approx > 0) ? 1 / Max(1.f, Abs(target)) : -1 / Max(1.f, Abs(target));
     }
@@ -446,15 +490,14 @@ private:
     }
 };
 
-class TPoissonError final : public IDerCalcer {
+class TPoissonError final : public TPerObjectDerCalcer<TPoissonError> {
 public:
     explicit TPoissonError(bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
     {
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approxExp, float target) const override {
         return target - approxExp;
     }
@@ -945,7 +988,7 @@ private:
     }
 };
 
-class THuberError final : public IDerCalcer {
+class THuberError final : public TPerObjectDerCalcer<THuberError> {
     static constexpr double HUBER_DER2 = -1.0;
     static constexpr double HUBER_DER3 = 0.0;
 
@@ -953,13 +996,12 @@ class THuberError final : public IDerCalcer {
 public:
 
     explicit THuberError(double delta, bool isExpApprox)
-        : IDerCalcer(isExpApprox)
+        : TPerObjectDerCalcer(isExpApprox)
         , Delta(delta)
     {
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-private:
     double CalcDer(double approx, float target) const override {
         double diff = target - approx;
         if (fabs(diff) < Delta) {
@@ -0,0 +1,69 @@
+#include <library/unittest/registar.h>
+#include <catboost/private/libs/algo_helpers/error_functions.h>
+
+#include <util/generic/xrange.h>
+
+Y_UNIT_TEST_SUITE(ErrorFunctionsTest) {
+    Y_UNIT_TEST(QuantileDersRangeWithDeltasAndWeights) {
+        const TVector<double> approxes = {0.5, -1.0, 2.0, 0.25, 3.0};
+        const TVector<double> approxDeltas = {0.5, 0.5, -1.0, 0.0, 1.0};
+        const TVector<float> targets = {1.0f, -2.0f, 0.5f, 1.0f, 4.0f};
+        const TVector<float> weights = {1.0f, 2.0f, 0.5f, 3.0f, 0.0f};
+        const TQuantileError error(/*alpha*/ 0.3, /*delta*/ 1e-6, /*isExpApprox*/ false);
+
+        TVector<TDers> ders(approxes.size());
+        error.CalcDersRange(
+            /*start*/ 1,
+            /*count*/ 3,
+            /*calcThirdDer*/ true,
+            approxes.data(),
+            approxDeltas.data(),
+            targets.data(),
+            weights.data(),
+            ders.data());
+        TVector<double> firstDers(approxes.size());
+        error.CalcFirstDerRange(
+            /*start*/ 1,
+            /*count*/ 3,
+            approxes.data(),
+            approxDeltas.data(),
+            targets.data(),
+            weights.data(),
+            firstDers.data());
+
+        // updated approxes are -0.5, 1.0, 0.25
+        const TVector<double> expectedDer1 = {-0.7 * 2.0, -0.7 * 0.5, 0.3 * 3.0};
+        for (auto i : xrange(3)) {
+            UNIT_ASSERT_DOUBLES_EQUAL(ders[i + 1].Der1, expectedDer1[i], 1e-12);
+            UNIT_ASSERT_DOUBLES_EQUAL(ders[i + 1].Der2, 0.0, 1e-12);
+            UNIT_ASSERT_DOUBLES_EQUAL(ders[i + 1].Der3, 0.0, 1e-12);
+            UNIT_ASSERT_DOUBLES_EQUAL(firstDers[i + 1], expectedDer1[i], 1e-12);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(firstDers[0], 0.0);
+        UNIT_ASSERT_VALUES_EQUAL(firstDers[4], 0.0);
+    }
+
+    Y_UNIT_TEST(PoissonDersRangeWithExpApprox) {
+        const TVector<double> approxExps = {1.0, 2.0, 0.5};
+        const TVector<double> approxDeltaExps = {2.0, 0.5, 4.0};
+        const TVector<float> targets = {3.0f, 0.0f, 1.0f};
+        const TPoissonError error(/*isExpApprox*/ true);
+
+        TVector<TDers> ders(approxExps.size());
+        error.CalcDersRange(
+            /*start*/ 0,
+            /*count*/ 3,
+            /*calcThirdDer*/ false,
+            approxExps.data(),
+            approxDeltaExps.data(),
+            targets.data(),
+            /*weights*/ nullptr,
+            ders.data());
+
+        for (auto i : xrange(3)) {
+            const double updatedApproxExp = approxExps[i] * approxDeltaExps[i];
+            UNIT_ASSERT_DOUBLES_EQUAL(ders[i].Der1, targets[i] - updatedApproxExp, 1e-12);
+            UNIT_ASSERT_DOUBLES_EQUAL(ders[i].Der2, -updatedApproxExp, 1e-12);
+        }
+    }
+}
@@ -9,11 +9,16 @@
 #include <catboost/private/libs/labels/external_label_helper.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/threading/future/async.h>
+
 #include <util/string/cast.h>
 #include <util/string/split.h>
 
+#include <util/generic/cast.h>
 #include <util/generic/utility.h>
 #include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/thread/pool.h>
 
 
 void NCB::PrepareCalcModeParamsParser(
@@ -95,50 +100,192 @@ void NCB::ReadModelAndUpdateParams(
     }
 }
 
-static NCB::TEvalResult Apply(
+// Raw features of a block and its predictions for all eval periods should take about this size
+static constexpr size_t CalcBlockSizeInBytes = 16 << 20;
+
+static ui32 GetCalcBlockSize(const TFullModel& model, size_t iterationsLimit, size_t evalPeriod) {
+    const size_t evalCount = Max<size_t>(1, CeilDiv(iterationsLimit, evalPeriod));
+    const size_t featureCount = model.GetNumFloatFeatures() + model.GetNumCatFeatures()
+        + model.ModelTrees->GetTextFeatures().size();
+    const size_t bytesPerObject = sizeof(double) * model.GetDimensionsCount() * evalCount
+        + sizeof(float) * Max<size_t>(1, featureCount);
+    return SafeIntegerCast<ui32>(Min<size_t>(Max<size_t>(32, CalcBlockSizeInBytes / bytesPerObject), Max<ui32>()));
+}
+
+// evalResult is reused between blocks to avoid reallocation of approx vectors
+static void Apply(
     const TFullModel& model,
     const NCB::TDataProvider& dataset,
     size_t begin, size_t end,
     size_t evalPeriod,
-    NPar::TLocalExecutor* executor) {
+    NPar::TLocalExecutor* executor,
+    NCB::TEvalResult* evalResult) {
 
-    NCB::TEvalResult resultApprox;
-    TVector<TVector<TVector<double>>>& rawValues = resultApprox.GetRawValuesRef();
-    rawValues.resize(1);
+    TVector<TVector<TVector<double>>>& rawValues = evalResult->GetRawValuesRef();
+    rawValues.resize(Max<size_t>(1, CeilDiv(end - begin, evalPeriod)));
 
+    TVector<TVector<double>> approx;
     auto maybeBaseline = dataset.RawTargetData.GetBaseline();
     if (maybeBaseline) {
-        AssignRank2(*maybeBaseline, &rawValues[0]);
+        AssignRank2(*maybeBaseline, &approx);
     } else {
-        rawValues[0].resize(model.GetDimensionsCount(),
-                            TVector<double>(dataset.ObjectsGrouping->GetObjectCount(), 0.0));
+        ResizeRank2(model.GetDimensionsCount(), dataset.ObjectsGrouping->GetObjectCount(), approx);
     }
+    if (begin == end) {
+        rawValues[0] = std::move(approx);
+        return;
+    }
+
     TModelCalcerOnPool modelCalcerOnPool(model, dataset.ObjectsData, executor);
-    TVector<double> flatApprox;
-    TVector<TVector<double>> approx;
-    for (; begin < end; begin += evalPeriod) {
-        modelCalcerOnPool.ApplyModelMulti(EPredictionType::InternalRawFormulaVal,
-                                          begin,
-                                          Min(begin + evalPeriod, end),
-                                          &flatApprox,
-                                          &approx);
-
-        for (size_t i = 0; i < approx.size(); ++i) {
-            for (size_t j = 0; j < approx[0].size(); ++j) {
-                rawValues.back()[i][j] += approx[i][j];
+    size_t stageIdx = 0;
+    modelCalcerOnPool.ApplyModelStaged(
+        SafeIntegerCast<int>(begin),
+        SafeIntegerCast<int>(end),
+        SafeIntegerCast<int>(evalPeriod),
+        &approx,
+        [&] (int /*stageEnd*/, const TVector<TVector<double>>& stageApprox) {
+            rawValues[stageIdx++] = stageApprox;
+        });
+}
+
+namespace {
+    /* Applies model to blocks of dataset and outputs results on separate threads, so reading of the next
+     *  block, model application and output of the previous block run concurrently.
+     * At most one block is applied and one block is output at a time, so there are two results buffers.
+     * Model application shares local executor with reading, logging level has to be set by the caller
+     *  because it is global and output runs on another thread.
+     */
+    class TPipelinedModelCalcer {
+    public:
+        TPipelinedModelCalcer(
+            const NCB::TAnalyticalModeCommonParams& params,
+            size_t iterationsLimit,
+            size_t evalPeriod,
+            const TFullModel& model,
+            IOutputStream* outputStream,
+            TIntrusivePtr<NCB::IPoolColumnsPrinter> poolColumnsPrinter,
+            NPar::TLocalExecutor* applyExecutor)
+            : Params(params)
+            , IterationsLimit(iterationsLimit)
+            , EvalPeriod(evalPeriod)
+            , Model(model)
+            , VisibleLabelsHelper(model)
+            , OutputStream(outputStream)
+            , PoolColumnsPrinter(std::move(poolColumnsPrinter))
+            , ApplyExecutor(applyExecutor)
+            , ApplyQueue(CreateThreadPool(1))
+            , OutputQueue(CreateThreadPool(1))
+        {}
+
+        ~TPipelinedModelCalcer() {
+            // don't rethrow here, exception of reading is already being propagated
+            if (Applied.Initialized()) {
+                Applied.Wait();
+            }
+            if (Output.Initialized()) {
+                Output.Wait();
             }
         }
-        if (begin + evalPeriod < end) {
-            rawValues.push_back(rawValues.back());
+
+        void Push(NCB::TDataProviderPtr datasetPart) {
+            if (Applied.Initialized()) {
+                Applied.GetValueSync();
+                StartOutput();
+            }
+            CurrentBlock = std::move(datasetPart);
+            NCB::TEvalResult* evalResult = &EvalResults[BlockIdx % 2];
+            Applied = NThreading::Async(
+                [this, datasetPart = CurrentBlock, evalResult] () {
+                    Apply(Model, *datasetPart, 0, IterationsLimit, EvalPeriod, ApplyExecutor, evalResult);
+                },
+                *ApplyQueue);
         }
-    }
-    return resultApprox;
+
+        void Finish() {
+            if (Applied.Initialized()) {
+                Applied.GetValueSync();
+                StartOutput();
+                Applied = NThreading::TFuture<void>();
+            }
+            if (Output.Initialized()) {
+                Output.GetValueSync();
+                Output = NThreading::TFuture<void>();
+            }
+        }
+
+    private:
+        // output of the last applied block, previous output has to be finished to reuse its results buffer
+        void StartOutput() {
+            if (Output.Initialized()) {
+                Output.GetValueSync();
+            }
+            const NCB::TEvalResult* evalResult = &EvalResults[BlockIdx % 2];
+            const bool isFirstBlock = (BlockIdx == 0);
+            const ui64 docIdOffset = DocIdOffset;
+            Output = NThreading::Async(
+                [this, datasetPart = CurrentBlock, evalResult, isFirstBlock, docIdOffset] () {
+                    PoolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
+                    NCB::OutputEvalResultToFile(
+                        *evalResult,
+                        &OutputExecutor,
+                        Params.OutputColumnsIds,
+                        Model.GetLossFunctionName(),
+                        VisibleLabelsHelper,
+                        *datasetPart,
+                        OutputStream,
+                        // TODO: src file columns output is incompatible with block processing
+                        PoolColumnsPrinter,
+                        /*testFileWhichOf*/ {0, 0},
+                        isFirstBlock,
+                        docIdOffset,
+                        std::make_pair(EvalPeriod, IterationsLimit)
+                    );
+                },
+                *OutputQueue);
+            DocIdOffset += CurrentBlock->ObjectsGrouping->GetObjectCount();
+            ++BlockIdx;
+            CurrentBlock.Reset();
+        }
+
+    private:
+        const NCB::TAnalyticalModeCommonParams& Params;
+        const size_t IterationsLimit;
+        const size_t EvalPeriod;
+        const TFullModel& Model;
+        const TExternalLabelsHelper VisibleLabelsHelper;
+        IOutputStream* const OutputStream;
+        const TIntrusivePtr<NCB::IPoolColumnsPrinter> PoolColumnsPrinter;
+
+        NPar::TLocalExecutor* const ApplyExecutor;
+        NPar::TLocalExecutor OutputExecutor; // without additional threads, output is mostly sequential
+        NCB::TEvalResult EvalResults[2]; // [BlockIdx % 2]
+
+        NCB::TDataProviderPtr CurrentBlock; // applied or being applied
+        size_t BlockIdx = 0;
+        ui64 DocIdOffset = 0;
+
+        THolder<IThreadPool> ApplyQueue;
+        THolder<IThreadPool> OutputQueue;
+        NThreading::TFuture<void> Applied;
+        NThreading::TFuture<void> Output;
+    };
+}
+
+void NCB::CalcModelSingleHost(
+    const NCB::TAnalyticalModeCommonParams& params,
+    size_t iterationsLimit,
+    size_t evalPeriod,
+    TFullModel&& model) {
+
+    const ui32 blockSize = GetCalcBlockSize(model, iterationsLimit, evalPeriod);
+    CalcModelSingleHost(params, iterationsLimit, evalPeriod, blockSize, std::move(model));
 }
 
 void NCB::CalcModelSingleHost(
     const NCB::TAnalyticalModeCommonParams& params,
     size_t iterationsLimit,
     size_t evalPeriod,
+    ui32 blockSize,
     TFullModel&& model) {
 
     CB_ENSURE(params.OutputPath.Scheme == "dsv" || params.OutputPath.Scheme == "stream", "Local model evaluation supports only \"dsv\"  and \"stream\" output file schemas.");
@@ -162,39 +309,25 @@ void NCB::CalcModelSingleHost(
     executor.RunAdditionalThreads(params.ThreadCount - 1);
 
     bool IsFirstBlock = true;
-    ui64 docIdOffset = 0;
     auto poolColumnsPrinter = CreatePoolColumnPrinter(params.InputPath, params.ColumnarPoolFormatParams.DsvFormat);
-    const int blockSize = Max<int>(
-        32,
-        static_cast<int>(10000. / (static_cast<double>(iterationsLimit) / evalPeriod) / model.GetDimensionsCount())
-    );
+    CATBOOST_DEBUG_LOG << "Block size for model evaluation: " << blockSize << Endl;
+
+    // output of blocks overlaps with reading, so it can't be silenced only for the time of output
+    TSetLoggingSilent silentPipeline;
+    TPipelinedModelCalcer modelCalcer(
+        params,
+        iterationsLimit,
+        evalPeriod,
+        model,
+        outputStream.Get(),
+        poolColumnsPrinter,
+        &executor);
     ReadAndProceedPoolInBlocks(params, blockSize, [&](const NCB::TDataProviderPtr datasetPart) {
         if (IsFirstBlock) {
             ValidateColumnOutput(params.OutputColumnsIds, *datasetPart);
         }
-        auto approx = Apply(model, *datasetPart, 0, iterationsLimit, evalPeriod, &executor);
-        const TExternalLabelsHelper visibleLabelsHelper(model);
-
-        poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
-
-        TSetLoggingSilent inThisScope;
-        OutputEvalResultToFile(
-            approx,
-            &executor,
-            params.OutputColumnsIds,
-            model.GetLossFunctionName(),
-            visibleLabelsHelper,
-            *datasetPart,
-            outputStream.Get(),
-            // TODO: src file columns output is incompatible with block processing
-            poolColumnsPrinter,
-            /*testFileWhichOf*/ {0, 0},
-            IsFirstBlock,
-            docIdOffset,
-            std::make_pair(evalPeriod, iterationsLimit)
-        );
-        docIdOffset += datasetPart->ObjectsGrouping->GetObjectCount();
+        modelCalcer.Push(datasetPart);
         IsFirstBlock = false;
     }, &executor);
+    modelCalcer.Finish();
 }
-
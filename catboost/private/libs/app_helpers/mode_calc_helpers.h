@@ -35,4 +35,12 @@ namespace NCB {
         size_t iterationsLimit,
         size_t evalPeriod,
         TFullModel&& model);
+
+    // same as above with explicit size of blocks the pool is read and processed in
+    void CalcModelSingleHost(
+        const NCB::TAnalyticalModeCommonParams& params,
+        size_t iterationsLimit,
+        size_t evalPeriod,
+        ui32 blockSize,
+        TFullModel&& model);
 }
@@ -0,0 +1,83 @@
+#include <catboost/private/libs/app_helpers/mode_calc_helpers.h>
+
+#include <catboost/libs/data/ut/lib/for_loader.h>
+#include <catboost/libs/model/ut/lib/model_test_helpers.h>
+
+#include <util/folder/tempdir.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/string/split.h>
+#include <util/system/tempfile.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+Y_UNIT_TEST_SUITE(CalcModelSingleHost) {
+    static TString CalcToFile(
+        TAnalyticalModeCommonParams params,
+        size_t iterationsLimit,
+        size_t evalPeriod,
+        ui32 blockSize,
+        const TString& outputFileName) {
+
+        params.OutputPath = TPathWithScheme(outputFileName, "dsv");
+        CalcModelSingleHost(params, iterationsLimit, evalPeriod, blockSize, SimpleFloatModel(7));
+        return TIFStream(outputFileName).ReadAll();
+    }
+
+    Y_UNIT_TEST(PipelinedBlocksSameAsSingleBlock) {
+        TFastRng64 rng(0);
+        TStringBuilder dataset;
+        const ui32 objectCount = 1000;
+        for (auto i : xrange(objectCount)) {
+            Y_UNUSED(i);
+            dataset << rng.GenRandReal1() << '\t'
+                << (-300.0 + 305.0 * rng.GenRandReal1()) << '\t'
+                << rng.GenRandReal1() << '\t'
+                << rng.GenRandReal1() << '\n';
+        }
+
+        TVector<THolder<TTempFile>> srcDataFiles;
+        TAnalyticalModeCommonParams params;
+        SaveDataToTempFile(dataset, &params.InputPath, &srcDataFiles);
+        params.InputPath.Scheme = "dsv";
+        SaveDataToTempFile(
+            "0\tLabel\n1\tNum\n2\tNum\n3\tNum\n",
+            &params.ColumnarPoolFormatParams.CdFilePath,
+            &srcDataFiles);
+        params.ThreadCount = 4;
+
+        TTempDir tmpDir;
+        for (size_t evalPeriod : {2, 7}) {
+            // a single block is applied and output with no overlap, as it was done before pipelining
+            const TString expected = CalcToFile(
+                params,
+                /*iterationsLimit*/ 7,
+                evalPeriod,
+                /*blockSize*/ objectCount,
+                tmpDir.Name() + "/single_block.tsv");
+
+            TVector<TString> expectedLines = StringSplitter(expected).Split('\n').SkipEmpty();
+            UNIT_ASSERT_VALUES_EQUAL(expectedLines.size(), objectCount + 1);
+            const size_t columnCount = StringSplitter(expectedLines[0]).Split('\t').Count();
+            UNIT_ASSERT_VALUES_EQUAL(columnCount, 1 + CeilDiv<size_t>(7, evalPeriod));
+
+            for (ui32 blockSize : {32, 100, 999}) {
+                const TString pipelined = CalcToFile(
+                    params,
+                    /*iterationsLimit*/ 7,
+                    evalPeriod,
+                    blockSize,
+                    tmpDir.Name() + "/blocks.tsv");
+                UNIT_ASSERT_VALUES_EQUAL(pipelined, expected);
+            }
+        }
+    }
+}
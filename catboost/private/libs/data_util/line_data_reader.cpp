@@ -1,7 +1,10 @@
 #include "line_data_reader.h"
 
+#include <util/generic/vector.h>
 #include <util/system/fs.h>
 
+#include <algorithm>
+
 
 namespace NCB {
 
@@ -13,12 +16,19 @@ namespace NCB {
         );
     }
 
-    int CountLines(const TString& poolFile) {
+    ui64 CountLines(const TString& poolFile) {
         CB_ENSURE(NFs::Exists(TString(poolFile)), "pool file '" << TString(poolFile) << "' is not found");
-        TIFStream reader(poolFile.c_str());
-        size_t count = 0;
-        TString buffer;
-        while (reader.ReadLine(buffer)) {
+        TUnbufferedFileInput reader(poolFile);
+        TVector<char> buffer;
+        buffer.yresize(COUNT_LINES_BUFFER_SIZE);
+        ui64 count = 0;
+        char lastChar = '\n';
+        while (size_t readSize = reader.Read(buffer.data(), buffer.size())) {
+            count += std::count(buffer.data(), buffer.data() + readSize, '\n');
+            lastChar = buffer[readSize - 1];
+        }
+        // last line without trailing newline
+        if (lastChar != '\n') {
             ++count;
         }
         return count;
@@ -53,18 +53,22 @@ namespace NCB {
                                                const TDsvFormatOptions& format = {});
 
 
-    int CountLines(const TString& poolFile);
+    // files are read in big chunks to avoid syscall overhead on multi-gigabyte pools
+    constexpr size_t COUNT_LINES_BUFFER_SIZE = 1 << 20;
+    constexpr size_t FILE_LINE_DATA_READER_BUFFER_SIZE = 1 << 20;
+
+    ui64 CountLines(const TString& poolFile);
 
     class TFileLineDataReader : public ILineDataReader {
     public:
         TFileLineDataReader(const TLineDataReaderArgs& args)
             : Args(args)
-            , IFStream(args.PathWithScheme.Path)
+            , IFStream(args.PathWithScheme.Path, FILE_LINE_DATA_READER_BUFFER_SIZE)
             , HeaderProcessed(!Args.Format.HasHeader)
         {}
 
         ui64 GetDataLineCount() override {
-            ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
+            ui64 nLines = CountLines(Args.PathWithScheme.Path);
             if (Args.Format.HasHeader) {
                 --nLines;
             }
@@ -219,7 +219,9 @@ namespace NCatboostDistributed {
                     *(GetTrainData(trainData)->ObjectsData->GetFeaturesLayout()),
                     *(GetTrainData(trainData)->ObjectsData->GetQuantizedFeaturesInfo()),
                     trainParams.CatFeatureParams->OneHotMaxSize.Get()),
-                trainParams.ObliviousTreeOptions->MaxDepth);
+                trainParams.ObliviousTreeOptions->MaxDepth,
+                GetBucketStatsCacheMemoryLimit(
+                    ParseMemorySizeDescription(trainParams.SystemOptions->CpuUsedRamLimit.Get())));
         }
         localData.Indices.yresize(plainFold.GetLearnSampleCount());
         localData.AllDocCount = params->AllDocCount;
@@ -280,6 +282,7 @@ namespace NCatboostDistributed {
         Fill(localData.Indices.begin(), localData.Indices.end(), 0);
         if (localData.UseTreeLevelCaching) {
             localData.PrevTreeLevelStats.GarbageCollect();
+            localData.PrevTreeLevelStats.StartTreeLevel();
         }
     }
 
@@ -572,6 +575,9 @@ namespace NCatboostDistributed {
         auto& localData = TLocalTensorSearchData::GetRef();
         *isLeafEmpty = GetIsLeafEmpty(localData.Depth + 1, localData.Indices);
         ++localData.Depth; // tree level completed
+        if (localData.UseTreeLevelCaching) {
+            localData.PrevTreeLevelStats.StartTreeLevel();
+        }
     }
 
     void TBucketSimpleUpdater::DoMap(
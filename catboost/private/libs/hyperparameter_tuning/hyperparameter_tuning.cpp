@@ -1,4 +1,5 @@
 #include "hyperparameter_tuning.h"
+#include "successive_halving.h"
 
 #include <catboost/private/libs/algo/data.h>
 #include <catboost/private/libs/algo/approx_dimension.h>
@@ -13,8 +14,12 @@
 #include <catboost/libs/train_lib/dir_helper.h>
 #include <catboost/private/libs/options/plain_options_helper.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/generic/algorithm.h>
+#include <util/generic/cast.h>
 #include <util/generic/deque.h>
+#include <util/generic/ptr.h>
 #include <util/generic/set.h>
 #include <util/generic/xrange.h>
 #include <util/random/shuffle.h>
@@ -27,6 +32,9 @@ namespace {
     const TVector<TString> BorderCountParamAliaces {"border_count", "max_bin"};
     const TVector<TString> BorderTypeParamAliaces {"feature_border_type"};
     constexpr ui32 IndexOfFirstTrainingParameter = 3;
+    // training of a single model doesn't load all threads on smaller datasets, so several trials are trained at once
+    constexpr ui32 MaxObjectCountForParallelTrials = 1000000;
+    constexpr ui32 MinThreadCountPerTrial = 4;
 
     // TEnumeratedSet - type of sets, TValue - type of values in sets
     // Set should have access to elements by index and size() method
@@ -877,12 +885,140 @@ namespace {
         return bestParamsSetMetricValue;
     }
 
+    ui32 GetParallelTrialCount(
+        const NCB::TTrialsScheduleParams& scheduleParams,
+        const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+        ui32 objectCount) {
+
+        if (catBoostOptions.GetTaskType() != ETaskType::CPU) {
+            return 1;
+        }
+        const ui32 threadCount = Max<ui32>(1, catBoostOptions.SystemOptions->NumThreads.Get());
+        if (scheduleParams.ParallelTrialCount) {
+            return Min(scheduleParams.ParallelTrialCount, threadCount);
+        }
+        if (objectCount >= MaxObjectCountForParallelTrials) {
+            return 1;
+        }
+        return Max<ui32>(1, threadCount / MinThreadCountPerTrial);
+    }
+
+    class TSuccessiveHalvingCallbacks : public ITrainingCallbacks {
+    public:
+        TSuccessiveHalvingCallbacks(
+            const TString& metricDescription,
+            int metricSign,
+            NCB::TSuccessiveHalvingPruner* pruner)
+            : MetricDescription(metricDescription)
+            , MetricSign(metricSign)
+            , Pruner(pruner)
+        {
+        }
+
+        bool IsContinueTraining(const TMetricsAndTimeLeftHistory& history) override {
+            if (history.TestBestError.empty()) {
+                return true;
+            }
+            const auto& testBestError = history.TestBestError.back();
+            const auto bestErrorIt = testBestError.find(MetricDescription);
+            if (bestErrorIt == testBestError.end()) {
+                return true;
+            }
+            return Pruner->IsPromoted(history.TimeHistory.size(), MetricSign * bestErrorIt->second);
+        }
+
+    private:
+        const TString MetricDescription;
+        const int MetricSign;
+        NCB::TSuccessiveHalvingPruner* const Pruner;
+    };
+
+    struct TTrainTestTrial {
+    public:
+        TVector<NJson::TJsonValue> ParamsSet; // {border_count, feature_border_type, nan_mode, [others]}
+        TQuantizationParamsInfo QuantizationParamsSet;
+        NJson::TJsonValue ModelParams;
+        NCatboostOptions::TCatBoostOptions CatBoostOptions;
+        NCatboostOptions::TOutputFilesOptions OutputFileOptions;
+        ui64 RandSeed = 0;
+        TMetricsAndTimeLeftHistory MetricsAndTimeHistory;
+
+    public:
+        TTrainTestTrial(
+            TVector<NJson::TJsonValue>&& paramsSet,
+            const TQuantizationParamsInfo& quantizationParamsSet,
+            const NJson::TJsonValue& modelParams,
+            const NCatboostOptions::TCatBoostOptions& catBoostOptions,
+            const NCatboostOptions::TOutputFilesOptions& outputFileOptions)
+            : ParamsSet(std::move(paramsSet))
+            , QuantizationParamsSet(quantizationParamsSet)
+            , ModelParams(modelParams)
+            , CatBoostOptions(catBoostOptions)
+            , OutputFileOptions(outputFileOptions)
+        {
+        }
+
+        // trials can share quantized data and are trained together only if this is true
+        bool CanBeTrainedWith(const TTrainTestTrial& rhs) const {
+            return QuantizationParamsSet.BinsCount == rhs.QuantizationParamsSet.BinsCount &&
+                QuantizationParamsSet.BorderType == rhs.QuantizationParamsSet.BorderType &&
+                QuantizationParamsSet.NanMode == rhs.QuantizationParamsSet.NanMode &&
+                // logging level is global
+                CatBoostOptions.LoggingLevel.Get() == rhs.CatBoostOptions.LoggingLevel.Get();
+        }
+    };
+
+    THolder<TTrainTestTrial> CreateTrainTestTrial(
+        TConstArrayRef<NJson::TJsonValue> paramsSet,
+        const TVector<TString>& paramNames,
+        const THashMap<TString, NCB::TCustomRandomDistributionGenerator>& randDistGenerators,
+        NJson::TJsonValue* modelParamsToBeTried) {
+
+        // paramsSet: {border_count, feature_border_type, nan_mode, [others]}
+        TQuantizationParamsInfo quantizationParamsSet;
+        quantizationParamsSet.BinsCount = GetRandomValueIfNeeded(paramsSet[0], randDistGenerators).GetInteger();
+        quantizationParamsSet.BorderType = FromString<EBorderSelectionType>(paramsSet[1].GetString());
+        quantizationParamsSet.NanMode = FromString<ENanMode>(paramsSet[2].GetString());
+
+        AssignOptionsToJson(
+            TConstArrayRef<TString>(paramNames),
+            TConstArrayRef<NJson::TJsonValue>(
+                paramsSet.begin() + IndexOfFirstTrainingParameter,
+                paramsSet.end()
+            ), // Ignoring quantization params
+            randDistGenerators,
+            modelParamsToBeTried
+        );
+
+        NJson::TJsonValue jsonParams;
+        NJson::TJsonValue outputJsonParams;
+        NCatboostOptions::PlainJsonToOptions(*modelParamsToBeTried, &jsonParams, &outputJsonParams);
+        NCatboostOptions::TCatBoostOptions catBoostOptions(NCatboostOptions::LoadOptions(jsonParams));
+        NCatboostOptions::TOutputFilesOptions outputFileOptions;
+        outputFileOptions.Load(outputJsonParams);
+        InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
+
+        return MakeHolder<TTrainTestTrial>(
+            TVector<NJson::TJsonValue>(paramsSet.begin(), paramsSet.end()),
+            quantizationParamsSet,
+            *modelParamsToBeTried,
+            catBoostOptions,
+            outputFileOptions);
+    }
+
+    /* Trials with the same quantization params are trained in batches of up to parallelTrialCount trials,
+     * each trial on its own executor with an equal share of threads. Trials use their own random generators
+     * seeded in the order of trials, so results don't depend on parallelTrialCount
+     * (unless successive halving is enabled: then trials are compared in the order they reach the rungs).
+     */
     double TuneHyperparamsTrainTest(
         const TVector<TString>& paramNames,
         const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
         const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
         const TTrainTestSplitParams& trainTestSplitParams,
         const TGeneralQuatizationParamsInfo& generalQuantizeParamsInfo,
+        const NCB::TTrialsScheduleParams& scheduleParams,
+        ui32 parallelTrialCount,
         ui64 cpuUsedRamLimit,
         NCB::TDataProviderPtr data,
         TProductIteratorBase<TDeque<NJson::TJsonValue>, NJson::TJsonValue>* gridIterator,
@@ -910,6 +1046,26 @@ namespace {
             gridIterator->GetTotalElementsCount(),
             &logger
         );
+
+        THolder<NCB::TSuccessiveHalvingPruner> pruner;
+        if (scheduleParams.HalvingMinIterations) {
+            pruner = MakeHolder<NCB::TSuccessiveHalvingPruner>(
+                scheduleParams.HalvingMinIterations,
+                scheduleParams.HalvingReductionFactor);
+        }
+
+        TVector<THolder<NPar::TLocalExecutor>> trialExecutors;
+        if (parallelTrialCount > 1) {
+            const ui32 threadCount = SafeIntegerCast<ui32>(localExecutor->GetThreadCount() + 1);
+            CB_ENSURE_INTERNAL(parallelTrialCount <= threadCount, "More parallel trials than threads");
+            for (auto trialIdx : xrange(parallelTrialCount)) {
+                const ui32 trialThreadCount
+                    = threadCount / parallelTrialCount + (trialIdx < threadCount % parallelTrialCount ? 1 : 0);
+                trialExecutors.push_back(MakeHolder<NPar::TLocalExecutor>());
+                trialExecutors.back()->RunAdditionalThreads(trialThreadCount - 1);
+            }
+        }
+
         double bestParamsSetMetricValue;
         // Other parameters
         NCB::TTrainingDataProviders trainTestData;
@@ -918,44 +1074,41 @@ namespace {
         int iterationIdx = 0;
         int bestIterationIdx = 0;
         TProfileInfo profile(gridIterator->GetTotalElementsCount());
-        while (auto paramsSet = gridIterator->Next()) {
+
+        const auto getNextTrial = [&] () -> THolder<TTrainTestTrial> {
+            auto paramsSet = gridIterator->Next();
+            if (!paramsSet) {
+                return nullptr;
+            }
+            return CreateTrainTestTrial(*paramsSet, paramNames, randDistGenerators, modelParamsToBeTried);
+        };
+
+        THolder<TTrainTestTrial> nextTrial = getNextTrial();
+        while (nextTrial) {
             profile.StartIterationBlock();
-            // paramsSet: {border_count, feature_border_type, nan_mode, [others]}
-            TQuantizationParamsInfo quantizationParamsSet;
-            quantizationParamsSet.BinsCount = GetRandomValueIfNeeded((*paramsSet)[0], randDistGenerators).GetInteger();
-            quantizationParamsSet.BorderType = FromString<EBorderSelectionType>((*paramsSet)[1].GetString());
-            quantizationParamsSet.NanMode = FromString<ENanMode>((*paramsSet)[2].GetString());
 
-            AssignOptionsToJson(
-                TConstArrayRef<TString>(paramNames),
-                TConstArrayRef<NJson::TJsonValue>(
-                    paramsSet->begin() + IndexOfFirstTrainingParameter,
-                    paramsSet->end()
-                ), // Ignoring quantization params
-                randDistGenerators,
-                modelParamsToBeTried
-            );
+            TVector<THolder<TTrainTestTrial>> trials;
+            trials.push_back(std::move(nextTrial));
+            nextTrial = getNextTrial();
+            while (nextTrial && trials.size() < parallelTrialCount && nextTrial->CanBeTrainedWith(*trials[0])) {
+                trials.push_back(std::move(nextTrial));
+                nextTrial = getNextTrial();
+            }
 
-            NJson::TJsonValue jsonParams;
-            NJson::TJsonValue outputJsonParams;
-            NCatboostOptions::PlainJsonToOptions(*modelParamsToBeTried, &jsonParams, &outputJsonParams);
-            NCatboostOptions::TCatBoostOptions catBoostOptions(NCatboostOptions::LoadOptions(jsonParams));
-            NCatboostOptions::TOutputFilesOptions outputFileOptions;
-            outputFileOptions.Load(outputJsonParams);
-            static const bool allowWriteFiles = outputFileOptions.AllowWriteFiles();
+            TTrainTestTrial& firstTrial = *trials[0];
+            static const bool allowWriteFiles = firstTrial.OutputFileOptions.AllowWriteFiles();
 
             TString tmpDir;
-            if (outputFileOptions.AllowWriteFiles()) {
-                NCB::NPrivate::CreateTrainDirWithTmpDirIfNotExist(outputFileOptions.GetTrainDir(), &tmpDir);
+            if (firstTrial.OutputFileOptions.AllowWriteFiles()) {
+                NCB::NPrivate::CreateTrainDirWithTmpDirIfNotExist(firstTrial.OutputFileOptions.GetTrainDir(), &tmpDir);
             }
 
-            InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
             NCB::TFeaturesLayoutPtr featuresLayout = data->MetaInfo.FeaturesLayout;
             NCB::TQuantizedFeaturesInfoPtr quantizedFeaturesInfo;
 
-            TMetricsAndTimeLeftHistory metricsAndTimeHistory;
+            TVector<TVector<THolder<IMetric>>> metrics; // [trialIdx][metricIdx]
             {
-                TSetLogging inThisScope(catBoostOptions.LoggingLevel);
+                TSetLogging inThisScope(firstTrial.CatBoostOptions.LoggingLevel);
                 QuantizeAndSplitDataIfNeeded(
                     allowWriteFiles,
                     tmpDir,
@@ -965,127 +1118,180 @@ namespace {
                     quantizedFeaturesInfo,
                     data,
                     lastQuantizationParamsSet,
-                    quantizationParamsSet,
+                    firstTrial.QuantizationParamsSet,
                     &labelConverter,
                     localExecutor,
                     &rand,
-                    &catBoostOptions,
+                    &firstTrial.CatBoostOptions,
                     &trainTestData
                 );
-                lastQuantizationParamsSet = quantizationParamsSet;
-                THolder<IModelTrainer> modelTrainerHolder = TTrainerFactory::Construct(catBoostOptions.GetTaskType());
-
-                TEvalResult evalRes;
-
-                TTrainModelInternalOptions internalOptions;
-                internalOptions.CalcMetricsOnly = true;
-                internalOptions.ForceCalcEvalMetricOnEveryIteration = false;
-                internalOptions.OffsetMetricPeriodByInitModelSize = true;
-                outputFileOptions.SetAllowWriteFiles(false);
-                const auto defaultTrainingCallbacks = MakeHolder<ITrainingCallbacks>();
-                // Training model
-                modelTrainerHolder->TrainModel(
-                    internalOptions,
-                    catBoostOptions,
-                    outputFileOptions,
-                    objectiveDescriptor,
-                    evalMetricDescriptor,
-                    trainTestData,
-                    labelConverter,
-                    defaultTrainingCallbacks.Get(), // TODO(ilikepugs): MLTOOLS-3540
-                    /*initModel*/ Nothing(),
-                    /*initLearnProgress*/ nullptr,
-                    /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
-                    localExecutor,
-                    &rand,
-                    /*dstModel*/ nullptr,
-                    /*evalResultPtrs*/ {&evalRes},
-                    &metricsAndTimeHistory,
-                    /*dstLearnProgress*/nullptr
-                );
-            }
-
-            ui32 approxDimension = NCB::GetApproxDimension(catBoostOptions, labelConverter, data->RawTargetData.GetTargetDimension());
-            const TVector<THolder<IMetric>> metrics = CreateMetrics(
-                catBoostOptions.MetricOptions,
-                evalMetricDescriptor,
-                approxDimension,
-                data->MetaInfo.HasWeights
-            );
+                lastQuantizationParamsSet = firstTrial.QuantizationParamsSet;
+
+                for (auto trialIdx : xrange(trials.size())) {
+                    auto& trial = trials[trialIdx];
+                    trial->RandSeed = rand.GenRand();
+                    if (trials.size() > 1) {
+                        trial->CatBoostOptions.SystemOptions->NumThreads.Set(
+                            SafeIntegerCast<ui32>(trialExecutors[trialIdx]->GetThreadCount() + 1));
+                        trial->CatBoostOptions.SystemOptions->CpuUsedRamLimit.Set(
+                            ToString(cpuUsedRamLimit / trials.size()));
+                    }
+                    const ui32 approxDimension = NCB::GetApproxDimension(
+                        trial->CatBoostOptions,
+                        labelConverter,
+                        data->RawTargetData.GetTargetDimension());
+                    metrics.push_back(
+                        CreateMetrics(
+                            trial->CatBoostOptions.MetricOptions,
+                            evalMetricDescriptor,
+                            approxDimension,
+                            data->MetaInfo.HasWeights
+                        )
+                    );
+                }
 
-            const TString& lossDescription = metrics[0]->GetDescription();
-            double bestMetricValue = metricsAndTimeHistory.TestBestError[0][lossDescription]; //[testId][lossDescription]
-            if (iterationIdx == 0) {
-                // We guarantee to update the parameters on the first iteration
-                bestParamsSetMetricValue = bestMetricValue + GetSignForMetricMinimization(metrics[0]);
-                outputFileOptions.SetAllowWriteFiles(allowWriteFiles);
-                if (allowWriteFiles) {
-                    // Initialize Files Loggers
-                    TOutputFiles outputFiles(outputFileOptions, "");
-                    InitializeFilesLoggers(
-                        metrics,
-                        outputFiles,
-                        gridIterator->GetTotalElementsCount(),
-                        ELaunchMode::Train,
-                        trainTestData.Test.ysize(),
-                        parametersToken,
-                        &logger
+                const auto trainTrial = [&] (int trialIdx, NPar::TLocalExecutor* trialExecutor) {
+                    TTrainTestTrial& trial = *trials[trialIdx];
+                    THolder<IModelTrainer> modelTrainerHolder = TTrainerFactory::Construct(trial.CatBoostOptions.GetTaskType());
+
+                    TEvalResult evalRes;
+
+                    TTrainModelInternalOptions internalOptions;
+                    internalOptions.CalcMetricsOnly = true;
+                    internalOptions.ForceCalcEvalMetricOnEveryIteration = pruner.Get() != nullptr;
+                    internalOptions.OffsetMetricPeriodByInitModelSize = true;
+                    NCatboostOptions::TOutputFilesOptions outputFileOptions = trial.OutputFileOptions;
+                    outputFileOptions.SetAllowWriteFiles(false);
+                    if (trials.size() > 1) {
+                        // trace output is global, concurrent trials must not install their own
+                        outputFileOptions.SetTraceFileName(TString());
+                    }
+                    THolder<ITrainingCallbacks> trainingCallbacks; // TODO(ilikepugs): MLTOOLS-3540
+                    if (pruner) {
+                        trainingCallbacks = MakeHolder<TSuccessiveHalvingCallbacks>(
+                            metrics[trialIdx][0]->GetDescription(),
+                            GetSignForMetricMinimization(metrics[trialIdx][0]),
+                            pruner.Get());
+                    } else {
+                        trainingCallbacks = MakeHolder<ITrainingCallbacks>();
+                    }
+                    TRestorableFastRng64 trialRand(trial.RandSeed);
+                    // Training model
+                    modelTrainerHolder->TrainModel(
+                        internalOptions,
+                        trial.CatBoostOptions,
+                        outputFileOptions,
+                        objectiveDescriptor,
+                        evalMetricDescriptor,
+                        trainTestData,
+                        labelConverter,
+                        trainingCallbacks.Get(),
+                        /*initModel*/ Nothing(),
+                        /*initLearnProgress*/ nullptr,
+                        /*initModelApplyCompatiblePools*/ NCB::TDataProviders(),
+                        trialExecutor,
+                        &trialRand,
+                        /*dstModel*/ nullptr,
+                        /*evalResultPtrs*/ {&evalRes},
+                        &trial.MetricsAndTimeHistory,
+                        /*dstLearnProgress*/nullptr
+                    );
+                };
+                if (trials.size() == 1) {
+                    trainTrial(0, localExecutor);
+                } else {
+                    // perfect hash is loaded from disk on first access without synchronization
+                    trainTestData.Learn->ObjectsData->GetQuantizedFeaturesInfo()->LoadCatFeaturePerfectHashToRam();
+                    localExecutor->ExecRangeWithThrow(
+                        [&] (int trialIdx) {
+                            trainTrial(trialIdx, trialExecutors[trialIdx].Get());
+                        },
+                        0,
+                        trials.ysize(),
+                        NPar::TLocalExecutor::WAIT_COMPLETE
                     );
                 }
             }
-            bool isUpdateBest = SetBestParamsAndUpdateMetricValueIfNeeded(
-                bestMetricValue,
-                metrics,
-                quantizationParamsSet,
-                *modelParamsToBeTried,
-                paramNames,
-                quantizedFeaturesInfo,
-                bestGridParams,
-                &bestParamsSetMetricValue);
-            if (isUpdateBest) {
-                bestIterationIdx = iterationIdx;
-            }
-            TOneInterationLogger oneIterLogger(logger);
-            oneIterLogger.OutputMetric(
-                searchToken,
-                TMetricEvalResult(
-                    lossDescription,
+            profile.FinishIterationBlock(trials.ysize());
+
+            for (auto trialIdx : xrange(trials.size())) {
+                TTrainTestTrial& trial = *trials[trialIdx];
+                const auto& trialMetrics = metrics[trialIdx];
+                auto& metricsAndTimeHistory = trial.MetricsAndTimeHistory;
+
+                const TString& lossDescription = trialMetrics[0]->GetDescription();
+                double bestMetricValue = metricsAndTimeHistory.TestBestError[0][lossDescription]; //[testId][lossDescription]
+                if (iterationIdx == 0) {
+                    // We guarantee to update the parameters on the first iteration
+                    bestParamsSetMetricValue = bestMetricValue + GetSignForMetricMinimization(trialMetrics[0]);
+                    trial.OutputFileOptions.SetAllowWriteFiles(allowWriteFiles);
+                    if (allowWriteFiles) {
+                        // Initialize Files Loggers
+                        TOutputFiles outputFiles(trial.OutputFileOptions, "");
+                        InitializeFilesLoggers(
+                            trialMetrics,
+                            outputFiles,
+                            gridIterator->GetTotalElementsCount(),
+                            ELaunchMode::Train,
+                            trainTestData.Test.ysize(),
+                            parametersToken,
+                            &logger
+                        );
+                    }
+                }
+                bool isUpdateBest = SetBestParamsAndUpdateMetricValueIfNeeded(
                     bestMetricValue,
-                    bestParamsSetMetricValue,
-                    bestIterationIdx,
-                    true
-                )
-            );
-            if (allowWriteFiles) {
-                //log metrics
-                const auto& skipMetricOnTrain = GetSkipMetricOnTrain(metrics);
-                auto& learnErrors = metricsAndTimeHistory.LearnBestError;
-                auto& testErrors = metricsAndTimeHistory.TestBestError[0];
-                for (auto metricIdx : xrange(metrics.size())) {
-                    const auto& lossDescription = metrics[metricIdx]->GetDescription();
-                    LogTrainTest(
+                    trialMetrics,
+                    trial.QuantizationParamsSet,
+                    trial.ModelParams,
+                    paramNames,
+                    quantizedFeaturesInfo,
+                    bestGridParams,
+                    &bestParamsSetMetricValue);
+                if (isUpdateBest) {
+                    bestIterationIdx = iterationIdx;
+                }
+                TOneInterationLogger oneIterLogger(logger);
+                oneIterLogger.OutputMetric(
+                    searchToken,
+                    TMetricEvalResult(
                         lossDescription,
-                        oneIterLogger,
-                        skipMetricOnTrain[metricIdx] ? Nothing() :
-                            MakeMaybe<double>(learnErrors.at(lossDescription)),
-                        testErrors.at(lossDescription),
-                        "learn",
-                        "test",
-                        metricIdx == 0
+                        bestMetricValue,
+                        bestParamsSetMetricValue,
+                        bestIterationIdx,
+                        true
+                    )
+                );
+                if (allowWriteFiles) {
+                    //log metrics
+                    const auto& skipMetricOnTrain = GetSkipMetricOnTrain(trialMetrics);
+                    auto& learnErrors = metricsAndTimeHistory.LearnBestError;
+                    auto& testErrors = metricsAndTimeHistory.TestBestError[0];
+                    for (auto metricIdx : xrange(trialMetrics.size())) {
+                        const auto& lossDescription = trialMetrics[metricIdx]->GetDescription();
+                        LogTrainTest(
+                            lossDescription,
+                            oneIterLogger,
+                            skipMetricOnTrain[metricIdx] ? Nothing() :
+                                MakeMaybe<double>(learnErrors.at(lossDescription)),
+                            testErrors.at(lossDescription),
+                            "learn",
+                            "test",
+                            metricIdx == 0
+                        );
+                    }
+                    //log parameters
+                    LogParameters(
+                        paramNames,
+                        trial.ParamsSet,
+                        parametersToken,
+                        generalQuantizeParamsInfo,
+                        oneIterLogger
                     );
                 }
-                //log parameters
-                LogParameters(
-                    paramNames,
-                    *paramsSet,
-                    parametersToken,
-                    generalQuantizeParamsInfo,
-                    oneIterLogger
-                );
+                oneIterLogger.OutputProfile(profile.GetProfileResults());
+                iterationIdx++;
             }
-            profile.FinishIterationBlock(1);
-            oneIterLogger.OutputProfile(profile.GetProfileResults());
-            iterationIdx++;
         }
         return bestParamsSetMetricValue;
     }
@@ -1142,7 +1348,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TTrialsScheduleParams& scheduleParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -1157,6 +1364,7 @@ namespace NCB {
 
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
+        const ui32 parallelTrialCount = GetParallelTrialCount(scheduleParams, catBoostOptions, data->GetObjectCount());
 
         TGridParamsInfo bestGridParams;
         TDeque<NJson::TJsonValue> paramGrids;
@@ -1204,6 +1412,8 @@ namespace NCB {
                     evalMetricDescriptor,
                     trainTestSplitParams,
                     generalQuantizeParamsInfo,
+                    scheduleParams,
+                    parallelTrialCount,
                     cpuUsedRamLimit,
                     data,
                     &gridIterator,
@@ -1270,7 +1480,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit,
         bool returnCvStat,
-        int verbose) {
+        int verbose,
+        const TTrialsScheduleParams& scheduleParams) {
 
         // CatBoost options
         NJson::TJsonValue jsonParams;
@@ -1284,6 +1495,7 @@ namespace NCB {
         InitializeEvalMetricIfNotSet(catBoostOptions.MetricOptions->ObjectiveMetric, &catBoostOptions.MetricOptions->EvalMetric);
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(catBoostOptions.SystemOptions->NumThreads.Get() - 1);
+        const ui32 parallelTrialCount = GetParallelTrialCount(scheduleParams, catBoostOptions, data->GetObjectCount());
 
         NJson::TJsonValue paramGrid;
         if (gridJsonValues.GetType() == NJson::EJsonValueType::JSON_MAP) {
@@ -1327,6 +1539,8 @@ namespace NCB {
                 evalMetricDescriptor,
                 trainTestSplitParams,
                 generalQuantizeParamsInfo,
+                scheduleParams,
+                parallelTrialCount,
                 cpuUsedRamLimit,
                 data,
                 &gridIterator,
@@ -29,6 +29,19 @@ namespace NCB {
         TEvalFuncPtr EvalFunc = nullptr;
     };
 
+    // Scheduling of parameter set trials in search using train-test split
+    struct TTrialsScheduleParams {
+        // Number of trials trained at the same time, threads are divided between them equally.
+        // 0 - choose automatically: several trials at once on CPU for datasets with less than 1M objects.
+        ui32 ParallelTrialCount = 1;
+
+        // If not 0, trials are stopped early by asynchronous successive halving: at iterations
+        // HalvingMinIterations * HalvingReductionFactor^k a trial continues only if its best test metric value
+        // is in the best 1/HalvingReductionFactor of the values of the trials that have reached this iteration.
+        ui32 HalvingMinIterations = 0;
+        ui32 HalvingReductionFactor = 3;
+    };
+
     struct TBestOptionValuesWithCvResult {
     public:
         TVector<TCVResult> CvResult;
@@ -54,7 +67,8 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = 1);
+        int verbose = 1,
+        const TTrialsScheduleParams& scheduleParams = TTrialsScheduleParams());
 
     void RandomizedSearch(
         ui32 numberOfTries,
@@ -69,5 +83,6 @@ namespace NCB {
         TBestOptionValuesWithCvResult* bestOptionValuesWithCvResult,
         bool isSearchUsingTrainTestSplit = true,
         bool returnCvStat = true,
-        int verbose = 1);
+        int verbose = 1,
+        const TTrialsScheduleParams& scheduleParams = TTrialsScheduleParams());
 }
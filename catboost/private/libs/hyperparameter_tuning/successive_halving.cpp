@@ -0,0 +1,46 @@
+#include "successive_halving.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/system/guard.h>
+
+
+namespace NCB {
+
+    TSuccessiveHalvingPruner::TSuccessiveHalvingPruner(ui32 minIterations, ui32 reductionFactor)
+        : MinIterations(minIterations)
+        , ReductionFactor(reductionFactor)
+    {
+        CB_ENSURE(minIterations > 0, "Successive halving min iterations should be positive");
+        CB_ENSURE(reductionFactor > 1, "Successive halving reduction factor should be greater than 1");
+    }
+
+    bool TSuccessiveHalvingPruner::IsPromoted(size_t iterationCount, double metricValue) {
+        const TMaybe<size_t> rungIdx = GetRungIdx(iterationCount);
+        if (!rungIdx) {
+            return true;
+        }
+        with_lock (Lock) {
+            if (RungValues.size() <= *rungIdx) {
+                RungValues.resize(*rungIdx + 1);
+            }
+            auto& rungValues = RungValues[*rungIdx];
+            rungValues.push_back(metricValue);
+            const size_t promotedCount = Max<size_t>(1, rungValues.size() / ReductionFactor);
+            const size_t betterCount = CountIf(rungValues, [=] (double value) { return value < metricValue; });
+            return betterCount < promotedCount;
+        }
+    }
+
+    TMaybe<size_t> TSuccessiveHalvingPruner::GetRungIdx(size_t iterationCount) const {
+        size_t rungIterationCount = MinIterations;
+        for (size_t rungIdx = 0; rungIterationCount <= iterationCount; ++rungIdx) {
+            if (rungIterationCount == iterationCount) {
+                return rungIdx;
+            }
+            rungIterationCount *= ReductionFactor;
+        }
+        return Nothing();
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <util/generic/maybe.h>
+#include <util/generic/vector.h>
+#include <util/system/spinlock.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Asynchronous successive halving: a trial is compared with other trials at rung iterations
+     * MinIterations * ReductionFactor^k as soon as it reaches them, so concurrent trials never wait for each other.
+     * Trial is stopped if its metric value is not in the best 1/ReductionFactor of the values
+     * of trials that have reached this rung before (the first trial on each rung always continues).
+     */
+    class TSuccessiveHalvingPruner {
+    public:
+        TSuccessiveHalvingPruner(ui32 minIterations, ui32 reductionFactor);
+
+        // metricValue is the value to be minimized, thread-safe
+        bool IsPromoted(size_t iterationCount, double metricValue);
+
+    private:
+        TMaybe<size_t> GetRungIdx(size_t iterationCount) const;
+
+    private:
+        const size_t MinIterations;
+        const size_t ReductionFactor;
+        TAdaptiveLock Lock;
+        TVector<TVector<double>> RungValues; // [rungIdx][trial]
+    };
+}
@@ -0,0 +1,104 @@
+#include <catboost/private/libs/hyperparameter_tuning/hyperparameter_tuning.h>
+
+#include <catboost/libs/data/data_provider_builders.h>
+
+#include <library/json/json_reader.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+
+
+Y_UNIT_TEST_SUITE(GridSearch) {
+    static TDataProviderPtr CreateRegressionData(ui32 objectCount, ui32 featureCount) {
+        TFastRng64 rng(0);
+        return CreateDataProvider(
+            [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                TDataMetaInfo metaInfo;
+                metaInfo.TargetType = ERawTargetType::Float;
+                metaInfo.TargetCount = 1;
+                metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                    featureCount,
+                    TVector<ui32>{},
+                    TVector<ui32>{},
+                    TVector<TString>{});
+
+                visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+                TVector<float> target(objectCount, 0.0f);
+                for (auto featureIdx : xrange(featureCount)) {
+                    TVector<float> values(objectCount);
+                    for (auto objectIdx : xrange(objectCount)) {
+                        values[objectIdx] = rng.GenRandReal1();
+                        target[objectIdx] += values[objectIdx] * (featureIdx + 1);
+                    }
+                    visitor->AddFloatFeature(
+                        featureIdx,
+                        MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(values))
+                    );
+                }
+                for (auto& value : target) {
+                    value += 0.1f * rng.GenRandReal1();
+                }
+                visitor->AddTarget(MakeIntrusive<TTypeCastArrayHolder<float, float>>(std::move(target)));
+
+                visitor->Finish();
+            }
+        );
+    }
+
+    Y_UNIT_TEST(ParallelTrialsSameAsSequential) {
+        const auto data = CreateRegressionData(/*objectCount*/ 2000, /*featureCount*/ 4);
+
+        const NJson::TJsonValue grid = NJson::ReadJsonFastTree(
+            "{\"depth\": [2, 4, 6], \"learning_rate\": [0.03, 0.3], \"l2_leaf_reg\": [1, 10]}");
+        const NJson::TJsonValue params = NJson::ReadJsonFastTree(
+            "{\"iterations\": 20, \"loss_function\": \"RMSE\", \"thread_count\": 4, \"allow_writing_files\": false}");
+
+        TTrainTestSplitParams trainTestSplitParams;
+        TCrossValidationParams cvParams;
+        cvParams.FoldCount = 3;
+        cvParams.IsCalledFromSearchHyperparameters = true;
+
+        TVector<TBestOptionValuesWithCvResult> results;
+        for (ui32 parallelTrialCount : {1, 2, 4}) {
+            TTrialsScheduleParams scheduleParams;
+            scheduleParams.ParallelTrialCount = parallelTrialCount;
+
+            results.emplace_back();
+            GridSearch(
+                grid,
+                params,
+                trainTestSplitParams,
+                cvParams,
+                /*objectiveDescriptor*/ Nothing(),
+                /*evalMetricDescriptor*/ Nothing(),
+                data,
+                &results.back(),
+                /*isSearchUsingTrainTestSplit*/ true,
+                /*returnCvStat*/ true,
+                /*verbose*/ 0,
+                scheduleParams);
+        }
+
+        const auto& expected = results[0];
+        UNIT_ASSERT(!expected.CvResult.empty());
+        for (const auto& result : results) {
+            UNIT_ASSERT(result.IntOptions == expected.IntOptions);
+            UNIT_ASSERT(result.UIntOptions == expected.UIntOptions);
+            UNIT_ASSERT(result.DoubleOptions == expected.DoubleOptions);
+            UNIT_ASSERT(result.StringOptions == expected.StringOptions);
+            UNIT_ASSERT_VALUES_EQUAL(result.CvResult.size(), expected.CvResult.size());
+            for (auto metricIdx : xrange(expected.CvResult.size())) {
+                UNIT_ASSERT_VALUES_EQUAL(result.CvResult[metricIdx].Metric, expected.CvResult[metricIdx].Metric);
+                UNIT_ASSERT_VALUES_EQUAL(
+                    result.CvResult[metricIdx].AverageTest,
+                    expected.CvResult[metricIdx].AverageTest);
+            }
+        }
+    }
+}
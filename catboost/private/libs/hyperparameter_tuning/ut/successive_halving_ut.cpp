@@ -0,0 +1,51 @@
+#include <catboost/private/libs/hyperparameter_tuning/successive_halving.h>
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+
+
+Y_UNIT_TEST_SUITE(TSuccessiveHalvingPruner) {
+    Y_UNIT_TEST(OnlyRungsArePruned) {
+        TSuccessiveHalvingPruner pruner(/*minIterations*/ 2, /*reductionFactor*/ 3);
+
+        // rungs are at 2, 6, 18, ... iterations
+        UNIT_ASSERT(pruner.IsPromoted(2, 1.0));
+        UNIT_ASSERT(!pruner.IsPromoted(2, 2.0));
+        for (size_t iterationCount : {1, 3, 4, 5, 7, 17, 19, 53}) {
+            UNIT_ASSERT(pruner.IsPromoted(iterationCount, 100.0));
+        }
+    }
+
+    Y_UNIT_TEST(BestFractionIsPromoted) {
+        TSuccessiveHalvingPruner pruner(/*minIterations*/ 2, /*reductionFactor*/ 3);
+
+        // first trial on a rung always continues, then the best 1/3 of the values seen so far
+        const std::pair<double, bool> valuesAndPromotion[] = {
+            {1.0, true},
+            {2.0, false},
+            {0.5, true},
+            {3.0, false},
+            {0.7, false},
+            {0.4, true}, // 6 values, 2 are promoted
+            {0.6, false},
+            {0.45, true},
+        };
+        for (const auto& [value, isPromoted] : valuesAndPromotion) {
+            UNIT_ASSERT_VALUES_EQUAL(pruner.IsPromoted(2, value), isPromoted);
+        }
+
+        // rungs are independent
+        UNIT_ASSERT(pruner.IsPromoted(6, 10.0));
+        UNIT_ASSERT(!pruner.IsPromoted(6, 11.0));
+        UNIT_ASSERT(pruner.IsPromoted(18, 11.0));
+    }
+
+    Y_UNIT_TEST(InvalidParams) {
+        UNIT_ASSERT_EXCEPTION(TSuccessiveHalvingPruner(0, 3), TCatBoostException);
+        UNIT_ASSERT_EXCEPTION(TSuccessiveHalvingPruner(1, 1), TCatBoostException);
+    }
+}
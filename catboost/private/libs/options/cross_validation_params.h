@@ -22,6 +22,8 @@ struct TCrossValidationParams : public TSplitParams {
     ui32 DevMaxIterationsBatchSize = 100000; // useful primarily for tests
     ECrossValidation Type = ECrossValidation::Classical;
     bool IsCalledFromSearchHyperparameters = false;
+    // folds trained at the same time on CPU, each on an equal share of threads, 0 means choose automatically
+    ui32 ParallelFoldCount = 1;
 
 public:
     bool Initialized() const {
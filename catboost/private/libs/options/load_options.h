@@ -53,6 +53,9 @@ namespace NCatboostOptions {
 
         NCB::TPathWithScheme FeatureNamesPath;
 
+        // quantize float features while reading datasets instead of storing raw values (see ReadAndQuantizeTrainDatasets)
+        bool QuantizeWhileLoading = false;
+
         TPoolLoadParams() = default;
 
         void Validate() const;
@@ -63,7 +66,7 @@ namespace NCatboostOptions {
             CvParams, ColumnarPoolFormatParams, LearnSetPath, TestSetPaths,
             PairsFilePath, TestPairsFilePath, GroupWeightsFilePath, TestGroupWeightsFilePath,
             TimestampsFilePath, TestTimestampsFilePath, BaselineFilePath, TestBaselineFilePath,
-            ClassLabels, IgnoredFeatures, BordersFile, FeatureNamesPath
+            ClassLabels, IgnoredFeatures, BordersFile, FeatureNamesPath, QuantizeWhileLoading
         );
     };
 
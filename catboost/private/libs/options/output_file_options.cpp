@@ -97,7 +97,8 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , MetricPeriod("metric_period", 1)
     , PredictionTypes("prediction_type", {EPredictionType::RawFormulaVal})
     , OutputColumns("output_columns", {"SampleId", "RawFormulaVal", "Label"})
-    , RocOutputPath("roc_file", "") {
+    , RocOutputPath("roc_file", "")
+    , TraceFileName("trace_file", "") {
 }
 
 const TString& NCatboostOptions::TOutputFilesOptions::GetTrainDir() const {
@@ -255,13 +256,17 @@ TString NCatboostOptions::TOutputFilesOptions::GetRocOutputPath() const {
     return GetFullPath(RocOutputPath.Get());
 }
 
+TString NCatboostOptions::TOutputFilesOptions::CreateTraceFullPath() const {
+    return GetFullPath(TraceFileName.Get());
+}
+
 bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions& rhs) const {
     return std::tie(
             TrainDir, Name, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
             TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, FstrRegularFileName, FstrInternalFileName, FstrType,
-            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath
+            TrainingOptionsFileName, OutputBordersFileName, RocOutputPath, TraceFileName
             ) == std::tie(
                 rhs.TrainDir, rhs.Name, rhs.JsonLogPath, rhs.ProfileLogPath,
                 rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
@@ -269,7 +274,7 @@ bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions
                 rhs.FinalCtrComputationMode, rhs.FinalFeatureCalcerComputationMode, rhs.UseBestModel, rhs.BestModelMinTrees,
                 rhs.SnapshotSaveIntervalSeconds, rhs.EvalFileName, rhs.FstrRegularFileName,
                 rhs.FstrInternalFileName, rhs.FstrType, rhs.TrainingOptionsFileName, rhs.OutputBordersFileName,
-                rhs.RocOutputPath
+                rhs.RocOutputPath, rhs.TraceFileName
                 );
 }
 
@@ -285,7 +290,7 @@ void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& option
             &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &FinalFeatureCalcerComputationMode,
             &UseBestModel, &BestModelMinTrees, &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns,
             &FstrRegularFileName, &FstrInternalFileName, &FstrType, &TrainingOptionsFileName, &MetricPeriod,
-            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath
+            &VerbosePeriod, &PredictionTypes, &OutputBordersFileName, &RocOutputPath, &TraceFileName
             );
     if (!VerbosePeriod.IsSet() || VerbosePeriod.Get() == 1) {
         VerbosePeriod.Set(MetricPeriod.Get());
@@ -301,7 +306,7 @@ void NCatboostOptions::TOutputFilesOptions::Save(NJson::TJsonValue* options) con
             AllowWriteFilesFlag, FinalCtrComputationMode, FinalFeatureCalcerComputationMode, UseBestModel,
             BestModelMinTrees, SnapshotSaveIntervalSeconds, EvalFileName, OutputColumns, FstrRegularFileName,
             FstrInternalFileName, FstrType, TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes,
-            OutputBordersFileName, RocOutputPath
+            OutputBordersFileName, RocOutputPath, TraceFileName
             );
 }
 
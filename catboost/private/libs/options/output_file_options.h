@@ -93,6 +93,9 @@ namespace NCatboostOptions {
 
         TString GetRocOutputPath() const;
 
+        // empty if training is not traced
+        TString CreateTraceFullPath() const;
+
         void SetAllowWriteFiles(bool flag) {
             AllowWriteFilesFlag.Set(flag);
         }
@@ -113,6 +116,10 @@ namespace NCatboostOptions {
             SnapshotPath.Set(filename);
         }
 
+        void SetTraceFileName(const TString& filename) {
+            TraceFileName.Set(filename);
+        }
+
 
         bool operator==(const TOutputFilesOptions& rhs) const;
         bool operator!=(const TOutputFilesOptions& rhs) const;
@@ -153,5 +160,6 @@ namespace NCatboostOptions {
         TOption<TVector<EPredictionType>> PredictionTypes;
         TOption<TVector<TString>> OutputColumns;
         TOption<TString> RocOutputPath;
+        TOption<TString> TraceFileName;
     };
 }
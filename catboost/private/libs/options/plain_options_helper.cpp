@@ -308,6 +308,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "model_format",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "output_borders",  &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "roc_file",  &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "trace_file", &outputFilesJson, &seenKeys);
 
 
     //boosting options
@@ -454,6 +455,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "node_type", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "node_port", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "file_with_hosts", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "async_metrics_calc", &systemOptions, &seenKeys);
 
 
     //rest
@@ -549,6 +551,7 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
     DeleteSeenOption(&outputoptionsCopy, "model_format");
     DeleteSeenOption(&outputoptionsCopy, "output_borders");
     DeleteSeenOption(&outputoptionsCopy, "roc_file");
+    DeleteSeenOption(&outputoptionsCopy, "trace_file");
     CB_ENSURE(outputoptionsCopy.GetMapSafe().empty(), "output_options: key " + outputoptionsCopy.GetMapSafe().begin()->first + " wasn't added to plain options.");
 
     // boosting options
@@ -886,6 +889,9 @@ void NCatboostOptions::ConvertOptionsToPlainJson(
         CopyOption(systemOptions, "file_with_hosts", &plainOptionsJson, &seenKeys);
         DeleteSeenOption(&optionsCopySystemOptions, "file_with_hosts");
 
+        CopyOption(systemOptions, "async_metrics_calc", &plainOptionsJson, &seenKeys);
+        DeleteSeenOption(&optionsCopySystemOptions, "async_metrics_calc");
+
         CB_ENSURE(optionsCopySystemOptions.GetMapSafe().empty(), "system_options: key " + optionsCopySystemOptions.GetMapSafe().begin()->first + " wasn't added to plain options.");
         DeleteSeenOption(&optionsCopy, "system_options");
     }
@@ -931,6 +937,7 @@ void NCatboostOptions::CleanPlainJson(
     // options with no influence on the final model
     DeleteSeenOption(plainOptionsJsonEfficient, "objective_metric");
     DeleteSeenOption(plainOptionsJsonEfficient, "thread_count");
+    DeleteSeenOption(plainOptionsJsonEfficient, "async_metrics_calc");
     DeleteSeenOption(plainOptionsJsonEfficient, "allow_const_label");
     DeleteSeenOption(plainOptionsJsonEfficient, "detailed_profile");
     DeleteSeenOption(plainOptionsJsonEfficient, "logging_level");
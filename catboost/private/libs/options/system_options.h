@@ -30,6 +30,9 @@ namespace NCatboostOptions {
         TCpuOnlyOption<TString> FileWithHosts;
         TCpuOnlyOption<ui32> NodePort;
 
+        // calculate metrics of iteration in background while next tree is being built
+        TCpuOnlyOption<bool> AsyncMetricsCalc;
+
         static ui32 GetUnusedNodePort() { return 0; }
         bool IsMaster() const;
         bool IsSingleHost() const;
@@ -20,6 +20,7 @@
 #include <util/generic/scope.h>
 #include <util/generic/vector.h>
 #include <util/generic/ylimits.h>
+#include <util/generic/ymath.h>
 #include <util/system/madvise.h>
 #include <util/system/types.h>
 #include <util/system/unaligned_mem.h>
@@ -27,6 +28,7 @@
 using NCB::EObjectsOrder;
 using NCB::IQuantizedFeaturesDataVisitor;
 using NCB::IQuantizedFeaturesDatasetLoader;
+using NCB::IResourceHolder;
 using NCB::QuantizationSchemaFromProto;
 using NCB::TDataMetaInfo;
 using NCB::TDatasetLoaderFactory;
@@ -39,9 +41,21 @@ using NCB::TPathWithScheme;
 using NCB::TQuantizedPool;
 using NCB::TUnalignedArrayBuf;
 
+namespace {
+    struct TBlobsHolder : public IResourceHolder {
+        TVector<TBlob> Blobs;
+
+    public:
+        explicit TBlobsHolder(const TVector<TBlob>& blobs)
+            : Blobs(blobs)
+        {}
+    };
+}
+
 NCB::TCBQuantizedDataLoader::TCBQuantizedDataLoader(TDatasetLoaderPullArgs&& args)
     : ObjectCount(0) // inited later
     , QuantizedPool(std::forward<TQuantizedPool>(LoadQuantizedPool(args.PoolPath, GetLoadParameters(args.CommonArgs.DatasetSubset))))
+    , BlobsHolder(MakeIntrusive<TBlobsHolder>(QuantizedPool.Blobs))
     , PairsPath(args.CommonArgs.PairsFilePath)
     , GroupWeightsPath(args.CommonArgs.GroupWeightsFilePath)
     , BaselinePath(args.CommonArgs.BaselineFilePath)
@@ -104,6 +118,9 @@ namespace {
         void Push(const TChunkRef& chunk);
         void MaybeEvict(bool force = false) noexcept;
 
+        // Don't evict the last pushed chunk, it is referenced by dataset. Data before it is evicted.
+        void Exclude(const TChunkRef& chunk) noexcept;
+
     private:
         size_t MinSizeInBytesToEvict_ = 0;
         bool Evicted_ = false;
@@ -157,6 +174,20 @@ void TSequentialChunkEvictor::MaybeEvict(const bool force) noexcept {
     Evicted_ = true;
 }
 
+void TSequentialChunkEvictor::Exclude(const TChunkRef& chunk) noexcept {
+    const auto* const data = reinterpret_cast<const ui8*>(chunk.Description->Chunk->Quants()->data());
+    const size_t size = chunk.Description->Chunk->Quants()->size();
+
+    if (!Evicted_ && (Data_ < data)) {
+        Size_ = data - Data_;
+        MaybeEvict(true);
+    }
+
+    Data_ = data + size;
+    Size_ = 0;
+    Evicted_ = true;
+}
+
 static TDeque<TChunkRef> GatherAndSortChunks(const TQuantizedPool& pool) {
     TDeque<TChunkRef> chunks;
     for (const auto [columnIdx, localIdx] : pool.ColumnIndexToLocalIndex) {
@@ -198,7 +229,7 @@ static void AssignUnaligned(const TConstArrayRef<ui8> unaligned, TVector<U>* dst
     }
 }
 
-void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
+bool NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
     const TQuantizedPool::TChunkDescription& chunk,
     const size_t flatFeatureIdx,
     IQuantizedFeaturesDataVisitor* const visitor) const
@@ -206,7 +237,13 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
     const auto quants = ClipByDatasetSubset(chunk);
 
     if (quants.empty()) {
-        return;
+        return false;
+    }
+
+    if (auto mappedData = GetMappedFeatureData(chunk)) {
+        if (visitor->AddFloatFeatureView(flatFeatureIdx, chunk.Chunk->BitsPerDocument(), std::move(*mappedData))) {
+            return true;
+        }
     }
 
     visitor->AddFloatFeaturePart(
@@ -214,9 +251,10 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
         GetDatasetOffset(chunk),
         chunk.Chunk->BitsPerDocument(),
         TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants));
+    return false;
 }
 
- void NCB::TCBQuantizedDataLoader::AddQuantizedCatFeatureChunk(
+bool NCB::TCBQuantizedDataLoader::AddQuantizedCatFeatureChunk(
     const TQuantizedPool::TChunkDescription& chunk,
     const size_t flatFeatureIdx,
     IQuantizedFeaturesDataVisitor* const visitor) const
@@ -224,7 +262,13 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
     const auto quants = ClipByDatasetSubset(chunk);
 
     if (quants.empty()) {
-        return;
+        return false;
+    }
+
+    if (auto mappedData = GetMappedFeatureData(chunk)) {
+        if (visitor->AddCatFeatureView(flatFeatureIdx, chunk.Chunk->BitsPerDocument(), std::move(*mappedData))) {
+            return true;
+        }
     }
 
     visitor->AddCatFeaturePart(
@@ -232,9 +276,10 @@ void NCB::TCBQuantizedDataLoader::AddQuantizedFeatureChunk(
         GetDatasetOffset(chunk),
         chunk.Chunk->BitsPerDocument(),
         TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(quants));
+    return false;
 }
 
-void NCB::TCBQuantizedDataLoader::AddChunk(
+bool NCB::TCBQuantizedDataLoader::AddChunk(
     const TQuantizedPool::TChunkDescription& chunk,
     const EColumn columnType,
     const size_t* const targetIdx,
@@ -245,14 +290,13 @@ void NCB::TCBQuantizedDataLoader::AddChunk(
     const auto quants = ClipByDatasetSubset(chunk);
 
     if (quants.empty()) {
-        return;
+        return false;
     }
 
     switch (columnType) {
         case EColumn::Num: {
             CB_ENSURE(flatFeatureIdx != nullptr, "Feature not found in index");
-            AddQuantizedFeatureChunk(chunk, *flatFeatureIdx, visitor);
-            break;
+            return AddQuantizedFeatureChunk(chunk, *flatFeatureIdx, visitor);
         } case EColumn::Label: {
             // TODO(akhropov): will be raw strings as was decided for new data formats for MLTOOLS-140.
             CB_ENSURE(targetIdx != nullptr, "Target not found in index");
@@ -279,8 +323,7 @@ void NCB::TCBQuantizedDataLoader::AddChunk(
             break;
         } case EColumn::Categ: {
             CB_ENSURE(flatFeatureIdx != nullptr, "Feature not found in index");
-            AddQuantizedCatFeatureChunk(chunk, *flatFeatureIdx, visitor);
-            break;
+            return AddQuantizedCatFeatureChunk(chunk, *flatFeatureIdx, visitor);
         }
         case EColumn::SampleId:
             // Are skipped in a caller
@@ -296,6 +339,32 @@ void NCB::TCBQuantizedDataLoader::AddChunk(
             ythrow TCatBoostException() << "Unexpected column type " << columnType;
         }
     }
+    return false;
+}
+
+TMaybe<TMaybeOwningConstArrayHolder<ui8>> NCB::TCBQuantizedDataLoader::GetMappedFeatureData(
+    const TQuantizedPool::TChunkDescription& chunk) const
+{
+    if (!QuantizedPool.ChunkStorage.empty() || (DatasetSubset.Range.Begin != 0) || (chunk.DocumentOffset != 0)) {
+        return Nothing();
+    }
+
+    const auto* const data = reinterpret_cast<const ui8*>(chunk.Chunk->Quants()->data());
+    const size_t size = chunk.Chunk->Quants()->size();
+    const auto valueBytes = static_cast<size_t>(chunk.Chunk->BitsPerDocument() / CHAR_BIT);
+    if ((size != (size_t)ObjectCount * valueBytes) || (reinterpret_cast<uintptr_t>(data) % alignof(ui64) != 0)) {
+        return Nothing();
+    }
+
+    // dataset reads values by ui64 words, so the last word has to be inside the mapping too
+    const size_t readableSize = CeilDiv(size, sizeof(ui64)) * sizeof(ui64);
+    for (const auto& blob : QuantizedPool.Blobs) {
+        const auto* const blobBegin = reinterpret_cast<const ui8*>(blob.Data());
+        if ((blobBegin <= data) && (data + readableSize <= blobBegin + blob.Size())) {
+            return TMaybeOwningConstArrayHolder<ui8>::CreateOwning(MakeArrayRef(data, size), BlobsHolder);
+        }
+    }
+    return Nothing();
 }
 
 TConstArrayRef<ui8> NCB::TCBQuantizedDataLoader::ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const {
@@ -393,12 +462,15 @@ void NCB::TCBQuantizedDataLoader::Do(IQuantizedFeaturesDataVisitor* visitor) {
 
         const auto* const baselineIdx = columnIdxToBaselineIdx.FindPtr(columnIdx);
         const auto* const targetIdx = columnIdxToTargetIdx.FindPtr(columnIdx);
-        AddChunk(*chunkRef.Description, columnType, targetIdx, flatFeatureIdx, baselineIdx, visitor);
+        if (AddChunk(*chunkRef.Description, columnType, targetIdx, flatFeatureIdx, baselineIdx, visitor)) {
+            evictor.Exclude(chunkRef);
+        }
     }
 
     evictor.MaybeEvict(true);
 
     QuantizedPool = TQuantizedPool(); // release memory
+    BlobsHolder.Reset(); // mapping stays alive only if it is referenced by dataset
     SetGroupWeights(GroupWeightsPath, ObjectCount, DatasetSubset, visitor);
     SetPairs(PairsPath, ObjectCount, DatasetSubset, visitor);
     SetBaseline(BaselinePath, ObjectCount, DatasetSubset, NCB::ClassLabelsToStrings(DataMetaInfo.ClassLabels), visitor);
@@ -4,10 +4,13 @@
 #include "serialization.h"
 
 #include <catboost/libs/data/loader.h>
+#include <catboost/libs/helpers/maybe_owning_array_holder.h>
+#include <catboost/libs/helpers/resource_holder.h>
 #include <catboost/private/libs/index_range/index_range.h>
 
 #include <library/object_factory/object_factory.h>
 
+#include <util/generic/maybe.h>
 #include <util/generic/ylimits.h>
 
 namespace NCB {
@@ -18,7 +21,8 @@ namespace NCB {
         void Do(IQuantizedFeaturesDataVisitor* visitor) override;
 
     private:
-        void AddChunk(
+        // AddChunk and Add*FeatureChunk return true if chunk data is referenced by visitor without copying
+        bool AddChunk(
             const TQuantizedPool::TChunkDescription& chunk,
             EColumn columnType,
             const size_t* const multiTargetIdx,
@@ -26,16 +30,20 @@ namespace NCB {
             const size_t* baselineIdx,
             IQuantizedFeaturesDataVisitor* visitor) const;
 
-        void AddQuantizedFeatureChunk(
+        bool AddQuantizedFeatureChunk(
             const TQuantizedPool::TChunkDescription& chunk,
             const size_t flatFeatureIdx,
             IQuantizedFeaturesDataVisitor* visitor) const;
 
-        void AddQuantizedCatFeatureChunk(
+        bool AddQuantizedCatFeatureChunk(
             const TQuantizedPool::TChunkDescription& chunk,
             const size_t flatFeatureIdx,
             IQuantizedFeaturesDataVisitor* visitor) const;
 
+        // returns data holder that can be used as a column of all objects or Nothing()
+        TMaybe<TMaybeOwningConstArrayHolder<ui8>> GetMappedFeatureData(
+            const TQuantizedPool::TChunkDescription& chunk) const;
+
         TConstArrayRef<ui8> ClipByDatasetSubset(const TQuantizedPool::TChunkDescription& chunk) const;
         ui32 GetDatasetOffset(const TQuantizedPool::TChunkDescription& chunk) const;
 
@@ -47,6 +55,7 @@ namespace NCB {
         ui32 ObjectCount;
         TVector<bool> IsFeatureIgnored;
         TQuantizedPool QuantizedPool;
+        TIntrusivePtr<IResourceHolder> BlobsHolder; // keeps QuantizedPool.Blobs alive for feature views
         TPathWithScheme PairsPath;
         TPathWithScheme GroupWeightsPath;
         TPathWithScheme BaselinePath;
@@ -126,6 +126,8 @@ static void WriteChunk(
 
     builder->Clear();
 
+    // align quants in file, so mapped chunks can be used as dataset columns without copying
+    builder->ForceVectorAlignment(chunk.Chunk->Quants()->size(), sizeof(ui8), 16);
     const auto quantsOffset = builder->CreateVector(
         chunk.Chunk->Quants()->data(),
         chunk.Chunk->Quants()->size());
@@ -793,6 +795,7 @@ namespace NCB {
         TVector<TQuantizedPool::TChunkDescription> chunks;
         for (const auto& dataPart : srcColumn.Data) {
             flatbuffers::FlatBufferBuilder builder;
+            builder.ForceVectorAlignment(sizeof(T)*dataPart.size(), sizeof(ui8), 16);
             builder.Finish(
                 NIdl::CreateTQuantizedFeatureChunk(
                     builder,
@@ -13,11 +13,15 @@
 
 #include <library/json/json_value.h>
 
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
 #include <util/generic/xrange.h>
 #include <util/memory/blob.h>
 #include <util/random/random.h>
 #include <util/stream/file.h>
+#include <util/string/cast.h>
 #include <util/string/printf.h>
+#include <util/string/split.h>
 #include <util/system/mktemp.h>
 
 #include <library/unittest/registar.h>
@@ -827,4 +831,147 @@ Y_UNIT_TEST_SUITE(LoadDataFromQuantized) {
 
         Test(testCase);
     }
+
+#if defined(_linux_)
+    // address ranges [begin, end) where fileName is mapped in this process
+    static TVector<std::pair<ui64, ui64>> GetFileMappings(const TString& fileName) {
+        const TString realPath = TFsPath(fileName).RealPath().GetPath();
+
+        TVector<std::pair<ui64, ui64>> mappings;
+        TFileInput maps("/proc/self/maps");
+        TString line;
+        while (maps.ReadLine(line)) {
+            // "begin-end perms offset dev inode path"
+            TVector<TString> fields = StringSplitter(line).Split(' ').SkipEmpty();
+            if ((fields.size() < 6) || (fields[5] != realPath)) {
+                continue;
+            }
+            TStringBuf begin;
+            TStringBuf end;
+            TStringBuf(fields[0]).Split('-', begin, end);
+            mappings.emplace_back(IntFromString<ui64, 16>(begin), IntFromString<ui64, 16>(end));
+        }
+        return mappings;
+    }
+#endif
+
+    Y_UNIT_TEST(ReadDatasetWithMappedColumns) {
+        NCB::TSrcData srcData;
+
+        srcData.DocumentCount = 5;
+        srcData.LocalIndexToColumnIndex = {0, 1, 2};
+        srcData.PoolQuantizationSchema.FeatureIndices = {0, 1};
+        srcData.PoolQuantizationSchema.Borders = {{0.1f, 0.2f, 0.3f}, {0.25f, 0.5f, 0.75f}};
+        srcData.PoolQuantizationSchema.NanModes = {ENanMode::Forbidden, ENanMode::Min};
+        srcData.FloatFeatures = {
+            // single chunk with all objects, used without copying
+            TSrcColumn<ui8>{EColumn::Num, {{1, 3, 0, 1, 2}}},
+
+            // several chunks, copied
+            TSrcColumn<ui8>{EColumn::Num, {{2, 3}, {0, 3, 1}}}
+        };
+        srcData.Target = TSrcColumn<float>{EColumn::Label, {{0.12f, 0.0f, 0.45f, 0.1f, 0.22f}}};
+
+        TReadDatasetMainParams readDatasetMainParams;
+
+        // TODO(akhropov): temporarily use THolder until TTempFile move semantic are fixed
+        TVector<THolder<TTempFile>> srcDataFiles;
+
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TDataProviderPtr dataProvider = ReadDataset(
+            readDatasetMainParams.PoolPath,
+            /*pairsFilePath*/TPathWithScheme(),
+            /*groupWeightsFilePath*/TPathWithScheme(),
+            /*timestampsFilePath*/TPathWithScheme(),
+            /*baselineFilePath*/TPathWithScheme(),
+            /*featureNamesPath*/TPathWithScheme(),
+            NCatboostOptions::TColumnarPoolFormatParams(),
+            srcData.IgnoredFeatures,
+            srcData.ObjectsOrder,
+            TDatasetSubset::MakeColumns(),
+            &readDatasetMainParams.ClassLabels,
+            &localExecutor
+        );
+
+        const auto* objectsData = dynamic_cast<const TQuantizedForCPUObjectsDataProvider*>(
+            dataProvider->ObjectsData.Get()
+        );
+        UNIT_ASSERT(objectsData);
+
+        TVector<const char*> featureDataPtrs;
+        for (auto floatFeatureIdx : xrange(2)) {
+            const auto* featureHolder = dynamic_cast<const TQuantizedFloatValuesHolder*>(
+                *objectsData->GetFloatFeature(floatFeatureIdx)
+            );
+            UNIT_ASSERT(featureHolder);
+            featureDataPtrs.push_back(featureHolder->GetCompressedData().GetSrc()->GetRawPtr());
+        }
+
+#if defined(_linux_)
+        const auto mappings = GetFileMappings(readDatasetMainParams.PoolPath.Path);
+        UNIT_ASSERT(!mappings.empty());
+        const auto isMapped = [&] (const char* ptr) {
+            return AnyOf(
+                mappings,
+                [ptr] (const auto& mapping) {
+                    return (mapping.first <= (ui64)ptr) && ((ui64)ptr < mapping.second);
+                }
+            );
+        };
+        UNIT_ASSERT(isMapped(featureDataPtrs[0]));
+        UNIT_ASSERT(!isMapped(featureDataPtrs[1]));
+#endif
+
+        // the same data as if all columns were copied
+        TExpectedQuantizedData expectedData;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Num, ""},
+            {EColumn::Num, ""},
+            {EColumn::Label, ""}
+        };
+
+        expectedData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), ERawTargetType::Float, false, false, false, /* additionalBaselineCount */ Nothing(), Nothing());
+        expectedData.Objects.FloatFeatures = {
+            TVector<ui8>{1, 3, 0, 1, 2},
+            TVector<ui8>{2, 3, 0, 3, 1}
+        };
+        expectedData.Objects.QuantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TConstArrayRef<ui32>(),
+            NCatboostOptions::TBinarizationOptions(EBorderSelectionType::GreedyLogSum, 3)
+        );
+        expectedData.Objects.QuantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(0), {0.1f, 0.2f, 0.3f});
+        expectedData.Objects.QuantizedFeaturesInfo->SetBorders(TFloatFeatureIdx(1), {0.25f, 0.5f, 0.75f});
+        expectedData.Objects.QuantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(0), ENanMode::Forbidden);
+        expectedData.Objects.QuantizedFeaturesInfo->SetNanMode(TFloatFeatureIdx(1), ENanMode::Min);
+        expectedData.Objects.ExclusiveFeatureBundlesData = TExclusiveFeatureBundlesData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TVector<TExclusiveFeaturesBundle>()
+        );
+        expectedData.Objects.PackedBinaryFeaturesData = TPackedBinaryFeaturesData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            *expectedData.Objects.QuantizedFeaturesInfo,
+            expectedData.Objects.ExclusiveFeatureBundlesData
+        );
+        expectedData.Objects.FeatureGroupsData = TFeatureGroupsData(
+            *expectedData.MetaInfo.FeaturesLayout,
+            TVector<TFeaturesGroup>()
+        );
+
+        expectedData.ObjectsGrouping = TObjectsGrouping(5);
+
+        expectedData.Target.TargetType = ERawTargetType::Float;
+
+        TVector<TVector<TString>> rawTarget{{"0.12", "0", "0.45", "0.1", "0.22"}};
+        expectedData.Target.Target.assign(rawTarget.begin(), rawTarget.end());
+        expectedData.Target.SetTrivialWeights(5);
+
+        Compare<TQuantizedForCPUObjectsDataProvider>(std::move(dataProvider), expectedData);
+    }
 }
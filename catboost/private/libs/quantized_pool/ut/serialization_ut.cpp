@@ -169,6 +169,27 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
         TString diff;
         UNIT_ASSERT_C(IsEqual(expectedQuantizationSchema, quantizationSchema, &diff), diff.data());
     }
+
+    Y_UNIT_TEST(TestQuantsAreAligned) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+
+        {
+            TFileOutput output(path.GetPath());
+            NCB::SaveQuantizedPool(pool, &output);
+        }
+
+        const auto loadedPool = NCB::LoadQuantizedPool(NCB::TPathWithScheme(path.GetPath(), "quantized"), {false, false, NCB::TDatasetSubset::MakeColumns()});
+        UNIT_ASSERT_VALUES_EQUAL(loadedPool.Blobs.size(), 1);
+
+        const auto* const fileBegin = loadedPool.Blobs[0].AsCharPtr();
+        for (const auto& chunks : loadedPool.Chunks) {
+            for (const auto& chunk : chunks) {
+                const auto* const quants = reinterpret_cast<const char*>(chunk.Chunk->Quants()->data());
+                UNIT_ASSERT_VALUES_EQUAL((quants - fileBegin) % 16, 0);
+            }
+        }
+    }
 }
 
 Y_UNIT_TEST_SUITE(DigestTests) {
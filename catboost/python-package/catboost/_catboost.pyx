@@ -1015,6 +1015,7 @@ cdef extern from "catboost/private/libs/options/cross_validation_params.h":
         double MaxTimeSpentOnFixedCostRatio
         ui32 DevMaxIterationsBatchSize
         bool_t IsCalledFromSearchHyperparameters
+        ui32 ParallelFoldCount
 
 cdef extern from "catboost/private/libs/options/split_params.h":
     cdef cppclass TTrainTestSplitParams:
@@ -1097,6 +1098,12 @@ cdef extern from "catboost/private/libs/algo/apply.h":
             TVector[double]* flatApprox,
             TVector[TVector[double]]* approx
         ) nogil except +ProcessException
+        void AddTreeRangeApprox(
+            int begin,
+            int end,
+            TVector[double]* flatApproxBuffer,
+            TVector[TVector[double]]* approx
+        ) nogil except +ProcessException
 
     cdef cppclass TLeafIndexCalcerOnPool:
         TLeafIndexCalcerOnPool(
@@ -1359,6 +1366,11 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         void* CustomData
         double (*EvalFunc)(void* customData) with gil
 
+    cdef cppclass TTrialsScheduleParams:
+        ui32 ParallelTrialCount
+        ui32 HalvingMinIterations
+        ui32 HalvingReductionFactor
+
     cdef cppclass TBestOptionValuesWithCvResult:
         TVector[TCVResult] CvResult
         THashMap[TString, bool_t] BoolOptions
@@ -1378,7 +1390,8 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TTrialsScheduleParams& scheduleParams) nogil except +ProcessException
 
     cdef void RandomizedSearch(
         ui32 numberOfTries,
@@ -1393,7 +1406,8 @@ cdef extern from "catboost/private/libs/hyperparameter_tuning/hyperparameter_tun
         TBestOptionValuesWithCvResult* results,
         bool_t isSearchUsingCV,
         bool_t isReturnCvResults,
-        int verbose) nogil except +ProcessException
+        int verbose,
+        const TTrialsScheduleParams& scheduleParams) nogil except +ProcessException
 
 cdef inline float _FloatOrNan(object obj) except *:
     try:
@@ -4362,7 +4376,7 @@ cdef class _CatBoost:
     cpdef _tune_hyperparams(self, list grids_list, _PoolBase train_pool, dict params, int n_iter,
                           int fold_count, int partition_random_seed, bool_t shuffle, bool_t stratified,
                           double train_size, bool_t choose_by_train_test_split, bool_t return_cv_results,
-                          custom_folds, int verbose):
+                          custom_folds, int verbose, int parallel_trial_count, int halving_min_iterations):
 
         prep_params = _PreprocessParams(params)
         prep_grids = _PreprocessGrids(grids_list)
@@ -4377,6 +4391,7 @@ cdef class _CatBoost:
         cvParams.Stratified = stratified
         cvParams.Type = ECrossValidation_Classical
         cvParams.IsCalledFromSearchHyperparameters = True;
+        cvParams.ParallelFoldCount = 1
 
         cdef TMaybe[TCustomTrainTestSubsets] custom_train_test_subset
         if custom_folds is not None:
@@ -4391,6 +4406,10 @@ cdef class _CatBoost:
         ttParams.Stratified = False
         ttParams.TrainPart = train_size
 
+        cdef TTrialsScheduleParams scheduleParams
+        scheduleParams.ParallelTrialCount = parallel_trial_count
+        scheduleParams.HalvingMinIterations = halving_min_iterations
+
         cdef TBestOptionValuesWithCvResult results
         with nogil:
             SetPythonInterruptHandler()
@@ -4407,7 +4426,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        scheduleParams
                     )
                 else:
                     RandomizedSearch(
@@ -4423,7 +4443,8 @@ cdef class _CatBoost:
                         &results,
                         choose_by_train_test_split,
                         return_cv_results,
-                        verbose
+                        verbose,
+                        scheduleParams
                     )
             finally:
                 ResetPythonInterruptHandler()
@@ -4686,7 +4707,7 @@ cdef TCustomTrainTestSubsets _make_train_test_subsets(_PoolBase pool, folds) exc
 
 
 cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int partition_random_seed,
-          bool_t shuffle, bool_t stratified, bool_t as_pandas, folds, type):
+          bool_t shuffle, bool_t stratified, bool_t as_pandas, folds, type, int parallel_fold_count):
     prep_params = _PreprocessParams(params)
     cdef TCrossValidationParams cvParams
     cdef TVector[TCVResult] results
@@ -4695,6 +4716,7 @@ cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int part
     cvParams.PartitionRandSeed = partition_random_seed
     cvParams.Shuffle = shuffle
     cvParams.Stratified = stratified
+    cvParams.ParallelFoldCount = parallel_fold_count
 
     if type == 'Classical':
         cvParams.Type = ECrossValidation_Classical
@@ -4804,21 +4826,13 @@ cdef class _StagedPredictIterator:
         if self.ntree_start >= self.ntree_end:
             raise StopIteration
 
-        dereference(self.__modelCalcerOnPool).ApplyModelMulti(
-            string_to_prediction_type('RawFormulaVal'),
+        dereference(self.__modelCalcerOnPool).AddTreeRangeApprox(
             self.ntree_start,
             min(self.ntree_start + self.eval_period, self.ntree_end),
             &self.__flatApprox,
-            &self.__pred
+            &self.__approx
         )
 
-        if self.__approx.empty():
-            self.__approx.swap(self.__pred)
-        else:
-            for i in range(self.__approx.size()):
-                for j in range(self.__approx[0].size()):
-                    self.__approx[i][j] += self.__pred[i][j]
-
         self.ntree_start += self.eval_period
         self.__pred = PrepareEvalForInternalApprox(self.predictionType, dereference(self.__model), self.__approx, self.thread_count)
 
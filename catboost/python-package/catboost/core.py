@@ -2513,6 +2513,13 @@ class CatBoost(_CatBoostBase):
                 * pmml_copyright : string
                 * pmml_description : string
                 * pmml_model_version : string
+            Parameters for C++ export:
+                * cpp_export_mode : string - either 'readable' (default) or 'optimized' for code specialized
+                  to the model, supported only for models without categorical features
+            Parameters for CatBoost binary (cbm) export:
+                * ctr_index_layout : string - layout of hash indexes of CTR tables, either 'Linear' (default)
+                  or 'CacheLineBuckets' that needs less memory reads per lookup but can't be loaded by
+                  older CatBoost versions
         pool : catboost.Pool or list or numpy.ndarray or pandas.DataFrame or pandas.Series or catboost.FeaturesData
             Training pool.
         """
@@ -2984,7 +2991,8 @@ class CatBoost(_CatBoostBase):
 
     def _tune_hyperparams(self, param_grid, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True,
-                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False):
+                          refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=1, plot=False,
+                          parallel_trial_count=1, halving_min_iterations=0):
 
         currently_not_supported_params = {
             'ignored_features',
@@ -3014,6 +3022,11 @@ class CatBoost(_CatBoostBase):
         if not isinstance(param_grid, (Mapping, Iterable)):
             raise TypeError('Parameter grid is not a dict or a list ({!r})'.format(param_grid))
 
+        if not isinstance(parallel_trial_count, INTEGER_TYPES) or parallel_trial_count < 0:
+            raise CatBoostError("parallel_trial_count should be a non-negative integer")
+        if not isinstance(halving_min_iterations, INTEGER_TYPES) or halving_min_iterations < 0:
+            raise CatBoostError("halving_min_iterations should be a non-negative integer")
+
         train_params = self._prepare_train_params(
             X, y, None, None, None, None, None, None, None, None, None, None, None, None,
             None, None, None, None, None, True, None, None, None, None, None
@@ -3046,7 +3059,8 @@ class CatBoost(_CatBoostBase):
             cv_result = self._object._tune_hyperparams(
                 param_grid, train_params["train_pool"], params, n_iter,
                 fold_count, partition_random_seed, shuffle, stratified, train_size,
-                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose
+                search_by_train_test_split, calc_cv_statistics, custom_folds, verbose,
+                parallel_trial_count, halving_min_iterations
             )
 
         self.set_params(**cv_result['params'])
@@ -3056,7 +3070,8 @@ class CatBoost(_CatBoostBase):
 
     def grid_search(self, param_grid, X, y=None, cv=3, partition_random_seed=0,
                     calc_cv_statistics=True, search_by_train_test_split=True,
-                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False):
+                    refit=True, shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False,
+                    parallel_trial_count=1, halving_min_iterations=0):
         """
         Exhaustive search over specified parameter values for a model.
         Aafter calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -3123,6 +3138,16 @@ class CatBoost(_CatBoostBase):
 
         plot : bool, optional (default=False)
             If True, draw train and eval error for every set of parameters in Jupyter notebook
+
+        parallel_trial_count : int, optional (default=1)
+            Number of parameter sets trained at the same time on CPU, threads are divided between them equally.
+            0 means choose automatically. Used only when search_by_train_test_split=True.
+
+        halving_min_iterations : int, optional (default=0)
+            If positive, training with a parameter set is stopped at iterations halving_min_iterations * 3^k
+            unless its best test metric value is in the best third of the values of parameter sets
+            that have reached this iteration. Used only when search_by_train_test_split=True.
+
         Returns
         -------
         dict with two fields:
@@ -3143,12 +3168,14 @@ class CatBoost(_CatBoostBase):
             param_grid=param_grid, X=X, y=y, cv=cv, n_iter=-1,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot
+            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot,
+            parallel_trial_count=parallel_trial_count, halving_min_iterations=halving_min_iterations
         )
 
     def randomized_search(self, param_distributions, X, y=None, cv=3, n_iter=10, partition_random_seed=0,
                           calc_cv_statistics=True, search_by_train_test_split=True, refit=True,
-                          shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False):
+                          shuffle=True, stratified=None, train_size=0.8, verbose=True, plot=False,
+                          parallel_trial_count=1, halving_min_iterations=0):
         """
         Randomized search on hyper parameters.
         After calling this method model is fitted and can be used, if not specified otherwise (refit=False).
@@ -3222,6 +3249,16 @@ class CatBoost(_CatBoostBase):
 
         plot : bool, optional (default=False)
             If True, draw train and eval error for every set of parameters in Jupyter notebook
+
+        parallel_trial_count : int, optional (default=1)
+            Number of parameter sets trained at the same time on CPU, threads are divided between them equally.
+            0 means choose automatically. Used only when search_by_train_test_split=True.
+
+        halving_min_iterations : int, optional (default=0)
+            If positive, training with a parameter set is stopped at iterations halving_min_iterations * 3^k
+            unless its best test metric value is in the best third of the values of parameter sets
+            that have reached this iteration. Used only when search_by_train_test_split=True.
+
         Returns
         -------
         dict with two fields:
@@ -3241,7 +3278,8 @@ class CatBoost(_CatBoostBase):
             param_grid=param_distributions, X=X, y=y, cv=cv, n_iter=n_iter,
             partition_random_seed=partition_random_seed, calc_cv_statistics=calc_cv_statistics,
             search_by_train_test_split=search_by_train_test_split, refit=refit, shuffle=shuffle,
-            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot
+            stratified=stratified, train_size=train_size, verbose=verbose, plot=plot,
+            parallel_trial_count=parallel_trial_count, halving_min_iterations=halving_min_iterations
         )
 
     def _convert_to_asymmetric_representation(self):
@@ -3464,6 +3502,10 @@ class CatBoostClassifier(CatBoost):
     used_ram_limit : string or number, [default=None]
         Set a limit on memory consumption (value like '1.2gb' or 1.2e9).
         WARNING: Currently this option affects CTR memory usage only.
+    async_metrics_calc : bool, [default=False]
+        Calculate metrics of an iteration in background while the next tree is being built.
+        Overfitting detector sees metric values one iteration late, the extra tree is removed from the model on stop.
+        CPU only.
     gpu_ram_part : float, [default=0.95]
         Fraction of the GPU RAM to use for training, a value from (0, 1].
     pinned_memory_size: int [default=None]
@@ -3686,6 +3728,7 @@ class CatBoostClassifier(CatBoost):
         snapshot_interval=None,
         fold_len_multiplier=None,
         used_ram_limit=None,
+        async_metrics_calc=None,
         gpu_ram_part=None,
         pinned_memory_size=None,
         allow_writing_files=None,
@@ -4232,6 +4275,7 @@ class CatBoostRegressor(CatBoost):
         snapshot_interval=None,
         fold_len_multiplier=None,
         used_ram_limit=None,
+        async_metrics_calc=None,
         gpu_ram_part=None,
         pinned_memory_size=None,
         allow_writing_files=None,
@@ -4625,7 +4669,8 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
        fold_count=None, nfold=None, inverted=False, partition_random_seed=0, seed=None,
        shuffle=True, logging_level=None, stratified=None, as_pandas=True, metric_period=None,
        verbose=None, verbose_eval=None, plot=False, early_stopping_rounds=None,
-       save_snapshot=None, snapshot_file=None, snapshot_interval=None, folds=None, type='Classical'):
+       save_snapshot=None, snapshot_file=None, snapshot_interval=None, folds=None, type='Classical',
+       parallel_fold_count=1):
     """
     Cross-validate the CatBoost model.
 
@@ -4727,6 +4772,10 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
         and have ``split`` method.
         if folds is not None, then all of fold_count, shuffle, partition_random_seed, inverted are None
 
+    parallel_fold_count : int, optional (default=1)
+        The number of folds trained at the same time on CPU, each fold uses an equal share of threads.
+        If 0, it is chosen automatically.
+
     Returns
     -------
     cv results : pandas.core.frame.DataFrame with cross-validation results
@@ -4749,6 +4798,9 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
         shuffle = False
         inverted = False
 
+    if not isinstance(parallel_fold_count, INTEGER_TYPES) or parallel_fold_count < 0:
+        raise CatBoostError("parallel_fold_count should be a non-negative integer")
+
     if verbose is not None:
         params.update({
             'verbose': verbose
@@ -4829,7 +4881,7 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
 
     with log_fixup(), plot_wrapper(plot, [_get_train_dir(params)]):
         return _cv(params, pool, fold_count, inverted, partition_random_seed, shuffle, stratified,
-                   as_pandas, folds, type)
+                   as_pandas, folds, type, parallel_fold_count)
 
 
 class BatchMetricCalcer(_MetricCalcerBase):
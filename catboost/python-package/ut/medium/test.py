@@ -2271,6 +2271,26 @@ def test_cv(task_type):
     return local_canonical_file(remove_time_from_json(JSON_LOG_PATH))
 
 
+def test_cv_parallel_folds():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    params = {
+        "iterations": 20,
+        "learning_rate": 0.03,
+        "loss_function": "Logloss",
+        "eval_metric": "AUC",
+        "thread_count": 4,
+    }
+    expected = cv(pool, params, fold_count=4, parallel_fold_count=1)
+    for parallel_fold_count in [0, 2, 4]:
+        results = cv(pool, params, fold_count=4, parallel_fold_count=parallel_fold_count)
+        assert list(results.columns) == list(expected.columns)
+        for column in expected.columns:
+            assert np.allclose(results[column], expected[column])
+
+    with pytest.raises(CatBoostError):
+        cv(pool, params, fold_count=4, parallel_fold_count=-1)
+
+
 def test_cv_query(task_type):
     pool = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)
     results = cv(
@@ -2795,6 +2815,49 @@ def test_grid_search_several_grids(task_type):
     assert results['params']['border_count'] in grids[grid_num]['border_count']
 
 
+def test_grid_search_parallel_trials():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    grid = {
+        'learning_rate': [0.03, 0.1],
+        'depth': [4, 6],
+        'l2_leaf_reg': [1, 3, 5]
+    }
+    results = []
+    for parallel_trial_count in [1, 2, 4]:
+        model = CatBoost({"iterations": 10, "loss_function": "Logloss", "thread_count": 4})
+        results.append(
+            model.grid_search(grid, pool, parallel_trial_count=parallel_trial_count, refit=False, verbose=False)
+        )
+    for result in results[1:]:
+        assert result['params'] == results[0]['params']
+        for key in results[0]['cv_results']:
+            assert np.allclose(result['cv_results'][key], results[0]['cv_results'][key])
+
+
+def test_randomized_search_halving():
+    pool = Pool(TRAIN_FILE, column_description=CD_FILE)
+    model = CatBoost({"loss_function": "Logloss", "eval_metric": "AUC", "thread_count": 4})
+    grid = {
+        'learning_rate': [0.001, 0.01, 0.03, 0.1],
+        'depth': [4, 6],
+        'iterations': [27]
+    }
+    results = model.randomized_search(
+        grid,
+        pool,
+        n_iter=8,
+        parallel_trial_count=2,
+        halving_min_iterations=3,
+        refit=False,
+        verbose=False
+    )
+    for key, value in results['params'].items():
+        assert value in grid[key]
+
+    with pytest.raises(CatBoostError):
+        model.randomized_search(grid, pool, n_iter=2, halving_min_iterations=-1)
+
+
 def test_feature_importance(task_type):
     pool = Pool(TRAIN_FILE, column_description=CD_FILE)
     pool_querywise = Pool(QUERYWISE_TRAIN_FILE, column_description=QUERYWISE_CD_FILE)